@@ -4,6 +4,7 @@
 #include <unordered_map>
 
 #include "Log.h"
+#include "MemoryTracker.h"
 #include "TextureImporter.h"
 #include "MeshImporter.h"
 #include "SceneImporter.h"
@@ -25,6 +26,7 @@ static std::unordered_map<AssetType, AssetImportFn> s_AssetImportFns = {
 
 AssetRef AssetImporter::ImportAsset(AssetHandle handle, const AssetMetadata &metadata)
 {
+    MEMORY_TAG(Assets);
     if (s_AssetImportFns.find(metadata.Type) == s_AssetImportFns.end())
     {
         //LOG_CORE_ERROR("No importer available for asset type: {}", (uint16_t)metadata.Type);
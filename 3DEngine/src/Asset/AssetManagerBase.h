@@ -2,7 +2,9 @@
 
 #include "Asset.h"
 
+#include <algorithm>
 #include <map>
+#include <vector>
 #include <filesystem>
 
 namespace Engine
@@ -3,6 +3,7 @@
 #include "AssetImporter.h"
 #include "Log.h"
 #include "Project.h"
+#include "VirtualFileSystem.h"
 
 #include <yaml-cpp/yaml.h>
 #include <fstream>
@@ -93,11 +94,14 @@ void EditorAssetManager::SerializeAssetRegistry()
 
 bool EditorAssetManager::DeserializeAssetRegistry()
 {
-    auto path = Project::GetAssetRegistryPath();
+    // a shipped project may only have it in the pak
+    auto path = Project::GetAssetPath(Project::GetActive()->GetConfig().AssetRegistryPath);
     YAML::Node data;
     try
     {
-        data = YAML::LoadFile(path.string());
+        FileMapping file = VirtualFileSystem::Open(path);
+        MemoryStream stream(file);
+        data = YAML::Load(stream);
     }
     catch (YAML::ParserException e)
     {
@@ -3,20 +3,28 @@
 #include <stb_image.h>
 
 #include "Log.h"
+#include "MemoryTracker.h"
 #include "Project.h"
+#include "VirtualFileSystem.h"
 
 namespace Engine
 {
 TextureHDRIRef HDRIImporter::ImportHDRI(AssetHandle handle, const AssetMetadata &metadata)
 {
-    return LoadHDRI(Project::GetAssetDirectory() / metadata.FilePath);
+    return LoadHDRI(Project::GetAssetPath(metadata.FilePath));
 }
 
 TextureHDRIRef HDRIImporter::LoadHDRI(const std::filesystem::path &path) 
 {
+	MEMORY_TAG(Assets);
 	stbi_set_flip_vertically_on_load(true);
 	int width, height, nrComponents;
-	float *data = stbi_loadf(path.string().c_str(), &width, &height, &nrComponents, 0);
+	FileMapping file = VirtualFileSystem::Open(path);
+	float *data = nullptr;
+	if (file)
+	{
+		data = stbi_loadf_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &nrComponents, 0);
+	}
 
 	if (data == nullptr)
 	{
@@ -17,7 +17,7 @@ class MaterialImporter
         MaterialRef material = std::make_shared<Material>();
 		material->Handle = handle;
         MaterialSerializer serializer(material);
-        serializer.Deserialize(Project::GetAssetDirectory() / metadata.FilePath);
+        serializer.Deserialize(Project::GetAssetPath(metadata.FilePath));
 
         return material;
     }
@@ -14,7 +14,7 @@ class MeshImporter
   public:
     static ModelRef ImportMesh(AssetHandle handle, const AssetMetadata &metadata)
     {
-        return LoadModel(Project::GetAssetDirectory() / metadata.FilePath);
+        return LoadModel(Project::GetAssetPath(metadata.FilePath));
     }
 
     // for loading models without any material information
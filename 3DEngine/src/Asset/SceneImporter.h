@@ -20,7 +20,7 @@ class SceneImporter
         SceneSerializer serializer(scene);
         scene->SetSceneName(metadata.FilePath.stem().string());
         scene->SetSceneFilePath((Project::GetAssetDirectory() / metadata.FilePath).string());
-        serializer.Deserialize((Project::GetAssetDirectory() / metadata.FilePath).string());
+        serializer.Deserialize(Project::GetAssetPath(metadata.FilePath).string());
 
         return scene;
     }
@@ -14,7 +14,7 @@ class SkyLightImporter
     static SkyLightRef ImportSkyLight(AssetHandle handle, const AssetMetadata &metadata)
 	{
 		SkyLightRef skyLight = std::make_shared<SkyLight>();
-		skyLight->Init(Project::GetAssetDirectory() / metadata.FilePath, 2048);
+		skyLight->Init(Project::GetAssetPath(metadata.FilePath), 2048);
 
 		return skyLight;
 	}
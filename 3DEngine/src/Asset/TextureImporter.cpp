@@ -3,34 +3,36 @@
 #include <stb_image.h>
 
 #include "Log.h"
+#include "MemoryTracker.h"
 #include "Project.h"
+#include "VirtualFileSystem.h"
 
 namespace Engine
 {
 Texture2DRef TextureImporter::ImportTexture2D(AssetHandle handle, const AssetMetadata &metadata)
 {
-    auto p = Project::GetAssetDirectory() / metadata.FilePath;
-    return LoadTexture2D(Project::GetAssetDirectory() / metadata.FilePath);
+    return LoadTexture2D(Project::GetAssetPath(metadata.FilePath));
 }
 
 Texture2DRef TextureImporter::LoadTexture2D(const std::filesystem::path &path)
 {
+    MEMORY_TAG(Assets);
     int width, height, channels;
     stbi_set_flip_vertically_on_load(1);
-    Buffer data;
-    {
-        std::string pathStr = path.string();
-        data.Data = stbi_load(pathStr.c_str(), &width, &height, &channels, 0);
-    }
 
-    if (data.Data == nullptr)
+    // decoded straight from the file's pages
+    FileMapping file = VirtualFileSystem::Open(path);
+    Buffer pixels;
+    if (file)
+        pixels.Data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 0);
+
+    if (pixels.Data == nullptr)
     {
         LOG_CORE_ERROR("TextureImporter::ImportTexture2D - Could not load texture from filepath: {}", path.string());
         return nullptr;
     }
-
-    // TODO: think about this
-    data.Size = width * height * channels;
+    pixels.Size = (uint64_t)width * height * channels;
+    ScopedBuffer data(pixels);
 
     TextureSpecification spec;
     spec.Width = width;
@@ -42,8 +44,6 @@ Texture2DRef TextureImporter::LoadTexture2D(const std::filesystem::path &path)
         case 4: spec.Format = ImageFormat::RGBA8; break;
     }
 
-    Texture2DRef texture = std::make_shared<Texture2D>(spec, data);
-    data.Release();
-    return texture;
+    return std::make_shared<Texture2D>(spec, data.Get());
 }
 } // namespace Engine
\ No newline at end of file
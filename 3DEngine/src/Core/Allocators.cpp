@@ -0,0 +1,174 @@
+#include "Allocators.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+
+namespace Engine
+{
+namespace Utils
+{
+struct ThreadFrameArenas
+{
+    LinearArena Arenas[FrameArena::MaxFrameCount];
+    uint32_t Current = 0;
+};
+
+static thread_local ThreadFrameArenas t_FrameArenas;
+static std::atomic<uint32_t> s_FrameCount = 2;
+
+static std::atomic<uint64_t> s_ArenaAllocations = 0, s_ArenaBytes = 0;
+static std::atomic<uint64_t> s_PoolAllocations = 0, s_PoolHeapAllocations = 0;
+
+static size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+} // namespace Utils
+
+LinearArena::~LinearArena()
+{
+    for (auto &block : m_Blocks)
+        ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+}
+
+void *LinearArena::Allocate(size_t size, size_t alignment)
+{
+    AllocatorStats::CountArena(size);
+    m_Used += size;
+
+    while (m_CurrentBlock < m_Blocks.size())
+    {
+        auto &block = m_Blocks[m_CurrentBlock];
+        const size_t offset = Utils::AlignUp(m_Offset, alignment);
+        if (offset + size <= block.Size)
+        {
+            m_Offset = offset + size;
+            return block.Data + offset;
+        }
+        m_CurrentBlock++;
+        m_Offset = 0;
+    }
+
+    const size_t blockSize = std::max(m_BlockSize, Utils::AlignUp(size, alignment));
+    auto *data = static_cast<std::byte *>(::operator new(blockSize, std::align_val_t(alignof(std::max_align_t))));
+    m_Blocks.push_back({data, blockSize});
+    m_CurrentBlock = m_Blocks.size() - 1;
+    m_Offset = Utils::AlignUp(0, alignment) + size;
+    return data;
+}
+
+void LinearArena::Reset()
+{
+    // next time it all fits into one block
+    if (m_Blocks.size() > 1)
+    {
+        const size_t capacity = GetCapacity();
+        for (auto &block : m_Blocks)
+            ::operator delete(block.Data, std::align_val_t(alignof(std::max_align_t)));
+        m_Blocks.clear();
+        m_Blocks.push_back({static_cast<std::byte *>(
+                                ::operator new(capacity, std::align_val_t(alignof(std::max_align_t)))),
+                            capacity});
+    }
+    m_CurrentBlock = 0;
+    m_Offset = 0;
+    m_Used = 0;
+}
+
+size_t LinearArena::GetCapacity() const
+{
+    size_t capacity = 0;
+    for (const auto &block : m_Blocks)
+        capacity += block.Size;
+    return capacity;
+}
+
+LinearArena &FrameArena::Get() { return Utils::t_FrameArenas.Arenas[Utils::t_FrameArenas.Current]; }
+
+void FrameArena::EndFrame()
+{
+    auto &arenas = Utils::t_FrameArenas;
+    arenas.Current = (arenas.Current + 1) % Utils::s_FrameCount;
+    arenas.Arenas[arenas.Current].Reset();
+}
+
+void FrameArena::SetFrameCount(uint32_t count) { Utils::s_FrameCount = std::clamp(count, 2u, MaxFrameCount); }
+
+uint32_t FrameArena::GetFrameCount() { return Utils::s_FrameCount; }
+
+SmallObjectPool::~SmallObjectPool()
+{
+    for (auto *chunk : m_Chunks)
+        ::operator delete(chunk, std::align_val_t(MinBlockSize));
+}
+
+size_t SmallObjectPool::GetClass(size_t size)
+{
+    size_t index = 0;
+    for (size_t blockSize = MinBlockSize; blockSize < size; blockSize *= 2)
+        index++;
+    return index;
+}
+
+void *SmallObjectPool::Allocate(size_t size)
+{
+    if (size > MaxBlockSize)
+    {
+        AllocatorStats::CountPool(true);
+        return ::operator new(size);
+    }
+    AllocatorStats::CountPool(false);
+
+    const size_t index = GetClass(size);
+    if (!m_FreeLists[index])
+    {
+        // carve a new chunk into blocks of this class
+        const size_t blockSize = MinBlockSize << index;
+        auto *chunk = static_cast<std::byte *>(::operator new(ChunkSize, std::align_val_t(MinBlockSize)));
+        m_Chunks.push_back(chunk);
+        for (size_t offset = 0; offset + blockSize <= ChunkSize; offset += blockSize)
+        {
+            auto *block = reinterpret_cast<FreeBlock *>(chunk + offset);
+            block->Next = m_FreeLists[index];
+            m_FreeLists[index] = block;
+        }
+    }
+
+    FreeBlock *block = m_FreeLists[index];
+    m_FreeLists[index] = block->Next;
+    return block;
+}
+
+void SmallObjectPool::Free(void *ptr, size_t size)
+{
+    if (!ptr) return;
+    if (size > MaxBlockSize)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    const size_t index = GetClass(size);
+    auto *block = static_cast<FreeBlock *>(ptr);
+    block->Next = m_FreeLists[index];
+    m_FreeLists[index] = block;
+}
+
+void AllocatorStats::CountArena(size_t bytes)
+{
+    Utils::s_ArenaAllocations.fetch_add(1, std::memory_order_relaxed);
+    Utils::s_ArenaBytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void AllocatorStats::CountPool(bool heap)
+{
+    (heap ? Utils::s_PoolHeapAllocations : Utils::s_PoolAllocations).fetch_add(1, std::memory_order_relaxed);
+}
+
+void AllocatorStats::ReportFrame()
+{
+    PROFILE_COUNTER("Frame Arena Allocations", Utils::s_ArenaAllocations.exchange(0, std::memory_order_relaxed));
+    PROFILE_COUNTER("Frame Arena KB", Utils::s_ArenaBytes.exchange(0, std::memory_order_relaxed) / 1024.0);
+    PROFILE_COUNTER("Pool Allocations", Utils::s_PoolAllocations.exchange(0, std::memory_order_relaxed));
+    PROFILE_COUNTER("Pool Heap Allocations", Utils::s_PoolHeapAllocations.exchange(0, std::memory_order_relaxed));
+}
+} // namespace Engine
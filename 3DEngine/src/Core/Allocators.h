@@ -0,0 +1,162 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+// Hands out memory by bumping an offset through large blocks; nothing is freed on its own, Reset() makes all of it
+// available again. A frame that needed more than one block leaves a single block big enough for all of it.
+// Not thread safe.
+class LinearArena
+{
+  public:
+    explicit LinearArena(size_t blockSize = 64 * 1024) : m_BlockSize(blockSize) {}
+    ~LinearArena();
+
+    LinearArena(const LinearArena &) = delete;
+    LinearArena &operator=(const LinearArena &) = delete;
+
+    void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // for types without a destructor that matters, the arena never runs it
+    template <typename T, typename... Args> T *New(Args &&...args)
+    {
+        return new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    void Reset();
+
+    size_t GetUsed() const { return m_Used; }
+    size_t GetCapacity() const;
+
+  private:
+    struct Block
+    {
+        std::byte *Data;
+        size_t Size;
+    };
+
+    std::vector<Block> m_Blocks;
+    size_t m_BlockSize;
+    size_t m_CurrentBlock = 0;
+    size_t m_Offset = 0;
+    size_t m_Used = 0;
+};
+
+// A ring of linear arenas per thread for data that only lives for a frame. A thread with a frame loop calls
+// EndFrame() once per frame, which resets the arena that was filled frameCount frames ago; memory stays valid until
+// then, so frame N's data may still be read while frame N + 1 is recorded. Data handed to the render thread needs
+// the frame latency plus one, see SetFrameCount.
+class FrameArena
+{
+  public:
+    static constexpr uint32_t MaxFrameCount = 3;
+
+    // the calling thread's arena of the current frame
+    static LinearArena &Get();
+    static void *Allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        return Get().Allocate(size, alignment);
+    }
+
+    static void EndFrame();
+
+    // 2 to MaxFrameCount, the same for all threads
+    static void SetFrameCount(uint32_t count);
+    static uint32_t GetFrameCount();
+};
+
+// Free lists of fixed-size blocks in size classes of 16 to 256 bytes, for small objects that come and go every frame
+// such as map nodes. Bigger requests go to the heap. Not thread safe.
+class SmallObjectPool
+{
+  public:
+    static constexpr size_t MinBlockSize = 16;
+    static constexpr size_t MaxBlockSize = 256;
+    static constexpr size_t ChunkSize = 16 * 1024;
+
+    SmallObjectPool() = default;
+    ~SmallObjectPool();
+
+    SmallObjectPool(const SmallObjectPool &) = delete;
+    SmallObjectPool &operator=(const SmallObjectPool &) = delete;
+
+    void *Allocate(size_t size);
+    // size as passed to Allocate
+    void Free(void *ptr, size_t size);
+
+  private:
+    static constexpr size_t ClassCount = 5;
+    static size_t GetClass(size_t size);
+
+    struct FreeBlock
+    {
+        FreeBlock *Next;
+    };
+
+    FreeBlock *m_FreeLists[ClassCount] = {};
+    std::vector<std::byte *> m_Chunks;
+};
+
+// Allocations of the engine's allocators, counted for the profiler. The main thread reports and restarts them at
+// the end of its frame.
+class AllocatorStats
+{
+  public:
+    static void CountArena(size_t bytes);
+    static void CountPool(bool heap);
+
+    static void ReportFrame();
+};
+
+// std allocator on a LinearArena; deallocation is a no-op, the memory comes back with the arena's reset. Default
+// constructed it uses the current frame's FrameArena of the constructing thread.
+template <typename T> class ArenaAllocator
+{
+  public:
+    using value_type = T;
+
+    ArenaAllocator() : m_Arena(&FrameArena::Get()) {}
+    explicit ArenaAllocator(LinearArena &arena) : m_Arena(&arena) {}
+    template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : m_Arena(other.m_Arena) {}
+
+    T *allocate(size_t count) { return static_cast<T *>(m_Arena->Allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T *, size_t) {}
+
+    template <typename U> bool operator==(const ArenaAllocator<U> &other) const { return m_Arena == other.m_Arena; }
+    template <typename U> bool operator!=(const ArenaAllocator<U> &other) const { return m_Arena != other.m_Arena; }
+
+  private:
+    template <typename U> friend class ArenaAllocator;
+    LinearArena *m_Arena;
+};
+
+// std allocator on a SmallObjectPool, for node based containers; arrays and big types fall through to the heap
+template <typename T> class PoolAllocator
+{
+    static_assert(alignof(T) <= SmallObjectPool::MinBlockSize, "pool blocks are only aligned to 16 bytes");
+
+  public:
+    using value_type = T;
+
+    explicit PoolAllocator(SmallObjectPool &pool) : m_Pool(&pool) {}
+    template <typename U> PoolAllocator(const PoolAllocator<U> &other) : m_Pool(other.m_Pool) {}
+
+    T *allocate(size_t count) { return static_cast<T *>(m_Pool->Allocate(count * sizeof(T))); }
+    void deallocate(T *ptr, size_t count) { m_Pool->Free(ptr, count * sizeof(T)); }
+
+    template <typename U> bool operator==(const PoolAllocator<U> &other) const { return m_Pool == other.m_Pool; }
+    template <typename U> bool operator!=(const PoolAllocator<U> &other) const { return m_Pool != other.m_Pool; }
+
+  private:
+    template <typename U> friend class PoolAllocator;
+    SmallObjectPool *m_Pool;
+};
+
+// valid until the constructing thread's FrameArena comes around again
+template <typename T> using FrameVector = std::vector<T, ArenaAllocator<T>>;
+} // namespace Engine
@@ -1,10 +1,19 @@
 #include "Application.h"
 
+#include "Allocators.h"
 #include "InputManager.h"
+#include "JobSystem.h"
 #include "Log.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include "RenderCommand.h"
+#include "RenderThread.h"
+#include "VirtualFileSystem.h"
 
 #include <GLFW/glfw3.h>
 
+#include <cmath>
+
 namespace Engine
 {
 float lastFrame = 0.0f;
@@ -12,13 +21,18 @@ float lastFrame = 0.0f;
 std::shared_ptr<Window> Application::m_Window = nullptr;
 bool Application::m_IsRunning = true;
 bool Application::m_Minimized = false;
-std::vector<std::function<void()>> Application::m_MainThreadQueue;
-std::mutex Application::m_MainThreadQueueMutex;
+MainThreadQueue Application::m_MainThreadQueue;
 
 Application::Application()
 {
     Log::Init();
+    Profiler::SetThreadName("Main");
+    JobSystem::Init();
+    VirtualFileSystem::Init();
     m_Window = std::make_shared<Window>(WindowProps());
+    FramePacer::GetSettings() = s_Settings.FramePacing;
+    m_Window->SetVSync(s_Settings.FramePacing.VSync);
+    RenderCommand::Init();
 
     SetupInputSystem();
 
@@ -28,44 +42,136 @@ Application::Application()
     LOG_CORE_TRACE("Engine Initialized");
 }
 
-void Application::SubmitToMainThread(const std::function<void()> &func) 
+void Application::SubmitToMainThread(Task task, TaskPriority priority)
 {
-	std::scoped_lock<std::mutex> lock(m_MainThreadQueueMutex);
-	m_MainThreadQueue.emplace_back(func);
+	m_MainThreadQueue.Submit(std::move(task), priority);
+	// wakes a loop that waits for something to draw, reloads show up on screen
+	FramePacer::RequestRedraw();
 }
 
 void Application::Run()
 {
+    // layers set up their GL resources while attaching, so the context only moves now
+    if (s_Settings.PipelinedRendering)
+    {
+        RenderThread::Start(m_Window->GetNativeWindow(), s_Settings.FrameLatency);
+        // frame data handed to the render thread is read up to the latency frames later
+        FrameArena::SetFrameCount(RenderThread::GetFrameLatency() + 1);
+    }
+    // the time spent loading isn't simulated
+    lastFrame = glfwGetTime();
+
     while (m_IsRunning && !glfwWindowShouldClose(m_Window->GetNativeWindow()))
     {
-		ExecuteMainThreadQueue();
-        if (!m_Minimized)
+        // waiting for the frame is idle time, it stays out of the profiled frame
+        m_Minimized = m_Window->IsMinimized();
+        if (!FramePacer::WaitForNextFrame(m_Window->IsFocused(), m_Minimized))
         {
-            // doMovement();
-            m_Window->OnUpdate();
-            InputManager::Instance().ProcessInput();
+            ExecuteMainThreadQueue();
+            // the time nothing is drawn isn't simulated either
+            lastFrame = glfwGetTime();
+            continue;
+        }
+        if (m_Window->IsVSync() != FramePacer::GetSettings().VSync)
+            m_Window->SetVSync(FramePacer::GetSettings().VSync);
 
-            // delta time
-            float currentFrame = glfwGetTime();
-            m_DeltaTime = currentFrame - lastFrame;
-            lastFrame = currentFrame;
+        Profiler::BeginFrame();
+        {
+            PROFILE_SCOPE("Application::Run");
 
-            for (Layer *layer : m_LayerStack)
             {
-                layer->OnUpdate(m_DeltaTime);
-
-                float fixedTime = 1 / 90.0f; // TODO: make this configurable
-                layer->OnFixedUpdate(fixedTime);
+                PROFILE_SCOPE("MainThreadQueue");
+                ExecuteMainThreadQueue();
             }
+            RunFrame();
 
-            m_ImGuiLayer->Begin();
-            for (Layer *layer : m_LayerStack) layer->OnImGuiRender();
-            m_ImGuiLayer->End();
+            AllocatorStats::ReportFrame();
+            MemoryTracker::ReportFrame();
+            FrameArena::EndFrame();
+        }
+        Profiler::EndFrame();
+    }
+
+    // layers free their GL resources on this thread when they are destroyed
+    RenderThread::Stop();
+}
 
-            // Swap the screen buffers
-            glfwSwapBuffers(m_Window->GetNativeWindow());
+void Application::RunFrame()
+{
+    {
+        PROFILE_SCOPE("Input");
+        // doMovement();
+        m_Window->OnUpdate();
+        InputManager::Instance().ProcessInput();
+    }
+
+    // delta time
+    float currentFrame = glfwGetTime();
+    m_DeltaTime = currentFrame - lastFrame;
+    lastFrame = currentFrame;
+
+    // before the update, so the frame renders the newest physics state
+    RunFixedUpdates();
+
+    for (Layer *layer : m_LayerStack)
+    {
+        PROFILE_SCOPE(Profiler::InternName(layer->GetName()));
+        PROFILE_SCOPE("Layer::OnUpdate");
+        layer->OnUpdate(m_DeltaTime);
+    }
+
+    {
+        PROFILE_SCOPE("ImGui");
+        m_ImGuiLayer->Begin();
+        for (Layer *layer : m_LayerStack)
+        {
+            PROFILE_SCOPE(Profiler::InternName(layer->GetName()));
+            layer->OnImGuiRender();
+        }
+        m_ImGuiLayer->End();
+    }
+    RenderThread::Submit([] { RenderCommand::EndFrame(); });
+
+    if (RenderThread::IsRunning())
+    {
+        // the render thread swaps once it drew the frame
+        RenderThread::EndFrame();
+        return;
+    }
+
+    // Swap the screen buffers
+    PROFILE_SCOPE("SwapBuffers");
+    glfwSwapBuffers(m_Window->GetNativeWindow());
+}
+
+void Application::RunFixedUpdates()
+{
+    PROFILE_FUNCTION();
+    const float step = s_Settings.FixedTimestep;
+    m_FixedAccumulator += m_DeltaTime;
+
+    uint32_t steps = 0;
+    while (m_FixedAccumulator >= step && steps < s_Settings.MaxFixedSteps)
+    {
+        for (Layer *layer : m_LayerStack)
+        {
+            PROFILE_SCOPE(Profiler::InternName(layer->GetName()));
+            PROFILE_SCOPE("Layer::OnFixedUpdate");
+            layer->OnFixedUpdate(step);
         }
+        m_FixedAccumulator -= step;
+        steps++;
+    }
+
+    // after a hitch the simulation slows down for a moment rather than spending every following frame on steps
+    if (m_FixedAccumulator >= step)
+    {
+        LOG_CORE_WARN_LIMITED(1.0, "Dropped {} fixed steps", (uint32_t)(m_FixedAccumulator / step));
+        m_FixedAccumulator = std::fmod(m_FixedAccumulator, step);
     }
+
+    s_InterpolationAlpha = m_FixedAccumulator / step;
+    PROFILE_COUNTER("Fixed Steps", steps);
 }
 
 void Application::SetupInputSystem() {}
@@ -87,16 +193,19 @@ void Application::RegisterLayerEventCallbacks(Layer *layer)
                                                std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
 }
 
-void Application::ExecuteMainThreadQueue() 
+void Application::ExecuteMainThreadQueue()
 {
-    std::scoped_lock<std::mutex> lock(m_MainThreadQueueMutex);
-
-	for (auto &func : m_MainThreadQueue)
-		func();
-	m_MainThreadQueue.clear();
+    m_MainThreadQueue.Execute(s_Settings.MainThreadBudgetMs);
+    // what the budget left over runs with the next frames, even when rendering on demand
+    if (m_MainThreadQueue.GetPendingCount() > 0) FramePacer::RequestRedraw();
 }
 
-Application::~Application() { glfwTerminate(); }
+Application::~Application()
+{
+    VirtualFileSystem::Shutdown();
+    JobSystem::Shutdown();
+    glfwTerminate();
+}
 
 void Application::PushLayer(Layer *layer)
 {
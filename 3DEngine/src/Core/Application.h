@@ -3,8 +3,10 @@
 #include <memory>
 
 #include "Window.h"
+#include "FramePacer.h"
 #include "LayerStack.h"
 #include "ImGuiLayer.h"
+#include "MainThreadQueue.h"
 
 #include <functional>
 #include <iostream>
@@ -16,6 +18,26 @@ int main(int argc, char **argv);
 
 namespace Engine
 {
+struct ApplicationSettings
+{
+    // render on a RenderThread, frame N while the main thread updates frame N+1; the layers must not use GL
+    // outside of RenderThread::Submit then
+    bool PipelinedRendering = false;
+    // frames the update may run ahead of rendering, 1 or 2
+    uint32_t FrameLatency = 1;
+
+    // layers get OnFixedUpdate with this step, as many times as the elapsed time covers
+    float FixedTimestep = 1.0f / 90.0f;
+    // steps per frame at most, a slower frame drops the time it can't catch up on instead of falling further behind
+    uint32_t MaxFixedSteps = 5;
+
+    // caps, vsync and render on demand; FramePacer::GetSettings() changes them at runtime
+    FramePacingSettings FramePacing;
+
+    // main thread time per frame for tasks below TaskPriority::High, see MainThreadQueue
+    float MainThreadBudgetMs = 2.0f;
+};
+
 class Application
 {
   public:
@@ -30,14 +52,23 @@ class Application
 
     bool IsRunning() const { return m_IsRunning; }
     float GetDeltaTime() const { return m_DeltaTime; }
+    // how far the frame is past the last fixed step, in steps from 0 to 1; rendering blends the last two physics
+    // states by it
+    static float GetInterpolationAlpha() { return s_InterpolationAlpha; }
 
     // GLFWwindow *GetNativeWindow() const { return m_Window->GetNativeWindow(); }
     static const std::shared_ptr<Window> &GetWindow() { return m_Window; }
 
-	static void SubmitToMainThread(const std::function<void()> &func);
+    // picked before the application is created, like the renderer API
+    static void SetSettings(const ApplicationSettings &settings) { s_Settings = settings; }
+    static const ApplicationSettings &GetSettings() { return s_Settings; }
+
+	static void SubmitToMainThread(Task task, TaskPriority priority = TaskPriority::Normal);
 
   private:
     void Run();
+    void RunFrame();
+    void RunFixedUpdates();
     void SetupInputSystem();
     void RegisterLayerEventCallbacks(Layer *layer);
 
@@ -45,16 +76,18 @@ class Application
 
   private:
     static std::shared_ptr<Window> m_Window;
+    inline static ApplicationSettings s_Settings;
 
     static bool m_IsRunning;
 	static bool m_Minimized;
     float m_DeltaTime = 0.0f;
+    float m_FixedAccumulator = 0.0f;
+    inline static float s_InterpolationAlpha = 1.0f;
 
     LayerStack m_LayerStack{};
     ImGuiLayer *m_ImGuiLayer;
 
-	static std::vector<std::function<void()>> m_MainThreadQueue;
-	static std::mutex m_MainThreadQueueMutex;
+	static MainThreadQueue m_MainThreadQueue;
 
   private:
     friend int ::main(int argc, char **argv);
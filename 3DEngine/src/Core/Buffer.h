@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <cstdlib>
 #include <cstring>
 
 namespace Engine
@@ -46,19 +47,50 @@ struct Buffer
     operator bool() const { return (bool)Data; }
 };
 
+// Owning buffer, frees its memory when it goes out of scope
 struct ScopedBuffer
 {
+    ScopedBuffer() = default;
+
     ScopedBuffer(Buffer buffer) : m_Buffer(buffer) {}
 
     ScopedBuffer(uint64_t size) : m_Buffer(size) {}
 
+    ScopedBuffer(const ScopedBuffer &) = delete;
+    ScopedBuffer &operator=(const ScopedBuffer &) = delete;
+
+    ScopedBuffer(ScopedBuffer &&other) noexcept : m_Buffer(other.m_Buffer) { other.m_Buffer = Buffer(); }
+
+    ScopedBuffer &operator=(ScopedBuffer &&other) noexcept
+    {
+        if (this != &other)
+        {
+            m_Buffer.Release();
+            m_Buffer = other.m_Buffer;
+            other.m_Buffer = Buffer();
+        }
+        return *this;
+    }
+
     ~ScopedBuffer() { m_Buffer.Release(); }
 
     uint8_t *Data() { return m_Buffer.Data; }
-    uint64_t Size() { return m_Buffer.Size; }
+    const uint8_t *Data() const { return m_Buffer.Data; }
+    uint64_t Size() const { return m_Buffer.Size; }
 
     template <typename T> T *As() { return m_Buffer.As<T>(); }
 
+    // non-owning view, valid as long as this buffer
+    Buffer Get() const { return m_Buffer; }
+
+    // hands the memory to the caller, who releases it
+    Buffer Detach()
+    {
+        Buffer buffer = m_Buffer;
+        m_Buffer = Buffer();
+        return buffer;
+    }
+
     operator bool() const { return m_Buffer; }
 
   private:
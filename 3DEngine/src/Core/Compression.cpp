@@ -0,0 +1,235 @@
+#include "Compression.h"
+
+#include "Log.h"
+
+#include <cstring>
+
+namespace Engine
+{
+namespace Utils
+{
+// LZ4 block format: sequences of a token, literals and a match. The token's high nibble is the literal count and the
+// low one the match length minus four, 15 means more length bytes follow, each adding up to 255. Matches are an
+// offset of up to 64 KB back into the output. The last five bytes are always literals and the last match starts at
+// least twelve bytes before the end, so decoders may copy in wide steps.
+constexpr uint32_t LZ4MinMatch = 4;
+constexpr uint32_t LZ4LastLiterals = 5;
+constexpr uint32_t LZ4MatchFindLimit = 12;
+constexpr uint32_t LZ4MaxOffset = 65535;
+constexpr uint32_t LZ4HashBits = 12;
+
+static uint32_t Read32(const uint8_t *ptr)
+{
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+static uint32_t HashLZ4(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - LZ4HashBits); }
+
+// 15 in the token, then 255s and the rest
+static bool WriteLZ4Length(uint8_t *&op, const uint8_t *end, uint64_t length)
+{
+    for (length -= 15; length >= 255; length -= 255)
+    {
+        if (op >= end) return false;
+        *op++ = 255;
+    }
+    if (op >= end) return false;
+    *op++ = (uint8_t)length;
+    return true;
+}
+
+static bool ReadLZ4Length(const uint8_t *&ip, const uint8_t *end, uint64_t &length)
+{
+    uint8_t byte;
+    do
+    {
+        if (ip >= end) return false;
+        byte = *ip++;
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+static bool WriteLZ4Sequence(uint8_t *&op, const uint8_t *end, const uint8_t *literals, uint64_t literalCount,
+                             uint32_t offset, uint64_t matchLength)
+{
+    if (op >= end) return false;
+    uint8_t *token = op++;
+    *token = (uint8_t)((literalCount >= 15 ? 15 : literalCount) << 4);
+    if (literalCount >= 15 && !WriteLZ4Length(op, end, literalCount)) return false;
+
+    if ((uint64_t)(end - op) < literalCount) return false;
+    if (literalCount > 0) memcpy(op, literals, literalCount);
+    op += literalCount;
+
+    // the last sequence has no match
+    if (matchLength == 0) return true;
+
+    if (end - op < 2) return false;
+    *op++ = (uint8_t)offset;
+    *op++ = (uint8_t)(offset >> 8);
+
+    matchLength -= LZ4MinMatch;
+    *token |= (uint8_t)(matchLength >= 15 ? 15 : matchLength);
+    return matchLength < 15 || WriteLZ4Length(op, end, matchLength);
+}
+
+// greedy, one candidate per hash
+static uint64_t CompressLZ4(const uint8_t *src, uint64_t srcSize, uint8_t *dst, uint64_t dstCapacity)
+{
+    uint8_t *op = dst;
+    const uint8_t *end = dst + dstCapacity;
+    uint64_t anchor = 0;
+
+    // the hash table holds 32-bit positions
+    if (srcSize >= UINT32_MAX) return 0;
+
+    if (srcSize > LZ4MatchFindLimit)
+    {
+        // positions plus one, zero is empty
+        uint32_t table[1 << LZ4HashBits] = {};
+        const uint64_t matchLimit = srcSize - LZ4LastLiterals;
+        uint64_t ip = 0;
+
+        while (ip + LZ4MatchFindLimit <= srcSize)
+        {
+            const uint32_t sequence = Read32(src + ip);
+            uint32_t &slot = table[HashLZ4(sequence)];
+            const uint64_t candidate = slot;
+            slot = (uint32_t)(ip + 1);
+
+            if (candidate == 0 || ip - (candidate - 1) > LZ4MaxOffset || Read32(src + candidate - 1) != sequence)
+            {
+                ip++;
+                continue;
+            }
+
+            uint64_t match = candidate - 1;
+            uint64_t length = LZ4MinMatch;
+            while (ip + length < matchLimit && src[match + length] == src[ip + length]) length++;
+
+            // the match may start earlier than the hash found it
+            while (ip > anchor && match > 0 && src[ip - 1] == src[match - 1])
+            {
+                ip--;
+                match--;
+                length++;
+            }
+
+            if (!WriteLZ4Sequence(op, end, src + anchor, ip - anchor, (uint32_t)(ip - match), length)) return 0;
+            ip += length;
+            anchor = ip;
+        }
+    }
+
+    if (!WriteLZ4Sequence(op, end, src + anchor, srcSize - anchor, 0, 0)) return 0;
+    return (uint64_t)(op - dst);
+}
+
+static bool DecompressLZ4(const uint8_t *src, uint64_t srcSize, uint8_t *dst, uint64_t dstSize)
+{
+    const uint8_t *ip = src;
+    const uint8_t *srcEnd = src + srcSize;
+    uint8_t *op = dst;
+    const uint8_t *dstEnd = dst + dstSize;
+
+    while (true)
+    {
+        if (ip >= srcEnd) return false;
+        const uint8_t token = *ip++;
+
+        uint64_t literalCount = token >> 4;
+        if (literalCount == 15 && !ReadLZ4Length(ip, srcEnd, literalCount)) return false;
+        if ((uint64_t)(srcEnd - ip) < literalCount || (uint64_t)(dstEnd - op) < literalCount) return false;
+        if (literalCount > 0) memcpy(op, ip, literalCount);
+        ip += literalCount;
+        op += literalCount;
+
+        // only the last sequence ends the input without a match
+        if (ip == srcEnd) break;
+
+        if (srcEnd - ip < 2) return false;
+        const uint32_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (uint64_t)(op - dst)) return false;
+
+        uint64_t matchLength = token & 15;
+        if (matchLength == 15 && !ReadLZ4Length(ip, srcEnd, matchLength)) return false;
+        matchLength += LZ4MinMatch;
+        if ((uint64_t)(dstEnd - op) < matchLength) return false;
+
+        // overlapping matches repeat the bytes they just wrote
+        const uint8_t *match = op - offset;
+        if (offset >= matchLength)
+        {
+            memcpy(op, match, matchLength);
+            op += matchLength;
+        }
+        else
+        {
+            for (uint64_t i = 0; i < matchLength; i++) *op++ = *match++;
+        }
+    }
+
+    return op == dstEnd;
+}
+} // namespace Utils
+
+bool Compression::IsSupported(CompressionType type)
+{
+    return type == CompressionType::None || type == CompressionType::LZ4;
+}
+
+const char *Compression::GetName(CompressionType type)
+{
+    switch (type)
+    {
+        case CompressionType::None: return "None";
+        case CompressionType::LZ4: return "LZ4";
+        case CompressionType::Zstd: return "Zstd";
+    }
+    return "Unknown";
+}
+
+uint64_t Compression::GetMaxCompressedSize(CompressionType type, uint64_t size)
+{
+    switch (type)
+    {
+        case CompressionType::LZ4: return size + size / 255 + 16;
+        default: return size;
+    }
+}
+
+uint64_t Compression::Compress(CompressionType type, const void *src, uint64_t srcSize, void *dst,
+                               uint64_t dstCapacity)
+{
+    switch (type)
+    {
+        case CompressionType::None:
+            if (dstCapacity < srcSize) return 0;
+            memcpy(dst, src, srcSize);
+            return srcSize;
+        case CompressionType::LZ4:
+            return Utils::CompressLZ4((const uint8_t *)src, srcSize, (uint8_t *)dst, dstCapacity);
+        default: return 0;
+    }
+}
+
+bool Compression::Decompress(CompressionType type, const void *src, uint64_t srcSize, void *dst, uint64_t dstSize)
+{
+    switch (type)
+    {
+        case CompressionType::None:
+            if (srcSize != dstSize) return false;
+            memcpy(dst, src, srcSize);
+            return true;
+        case CompressionType::LZ4:
+            return Utils::DecompressLZ4((const uint8_t *)src, srcSize, (uint8_t *)dst, dstSize);
+        default:
+            LOG_CORE_ERROR("Compression::Decompress - {} isn't supported", GetName(type));
+            return false;
+    }
+}
+} // namespace Engine
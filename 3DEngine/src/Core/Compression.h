@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+// stored in pak entries, values must not change
+enum class CompressionType : uint8_t
+{
+    None = 0,
+    LZ4 = 1,  // LZ4 block format, fast enough to decompress on load
+    Zstd = 2, // reserved, no zstd library is linked yet
+};
+
+// Whole buffers at once, there is no streaming. The decompressed size isn't part of the compressed data, the caller
+// stores it next to it.
+class Compression
+{
+  public:
+    static bool IsSupported(CompressionType type);
+    static const char *GetName(CompressionType type);
+
+    // worst case for a buffer of size bytes that doesn't compress at all
+    static uint64_t GetMaxCompressedSize(CompressionType type, uint64_t size);
+
+    // the compressed size, 0 when dst is too small or the type isn't supported
+    static uint64_t Compress(CompressionType type, const void *src, uint64_t srcSize, void *dst, uint64_t dstCapacity);
+    // dstSize is the exact decompressed size; false for corrupt data, which is never read or written out of bounds
+    static bool Decompress(CompressionType type, const void *src, uint64_t srcSize, void *dst, uint64_t dstSize);
+};
+} // namespace Engine
@@ -1,12 +1,42 @@
 #include "Application.h"
+#include "Log.h"
+#include "RendererAPI.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 extern Engine::Application *CreateApplication();
 
 int main(int argc, char **argv)
 {
+    // the render backend has to be picked before the application creates its renderer
+    Engine::ApplicationSettings settings;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strcmp(argv[i], "--renderer=null") == 0)
+            Engine::RendererAPI::SetAPI(Engine::RendererAPI::API::Null);
+        else if (std::strcmp(argv[i], "--renderer=opengl") == 0)
+            Engine::RendererAPI::SetAPI(Engine::RendererAPI::API::OpenGL);
+        else if (std::strcmp(argv[i], "--pipelined") == 0)
+            settings.PipelinedRendering = true;
+        else if (std::strcmp(argv[i], "--frame-latency=2") == 0)
+            settings.FrameLatency = 2;
+        else if (std::strncmp(argv[i], "--fixed-rate=", 13) == 0 && std::atoi(argv[i] + 13) > 0)
+            settings.FixedTimestep = 1.0f / std::atoi(argv[i] + 13);
+        else if (std::strncmp(argv[i], "--fps=", 6) == 0)
+            settings.FramePacing.ForegroundFPS = std::max(std::atoi(argv[i] + 6), 0);
+        else if (std::strcmp(argv[i], "--no-vsync") == 0)
+            settings.FramePacing.VSync = false;
+        else if (std::strcmp(argv[i], "--render-on-demand") == 0)
+            settings.FramePacing.RenderOnDemand = true;
+    }
+    Engine::Application::SetSettings(settings);
+
     auto app = Engine::CreateApplication();
     app->Run();
     delete app;
+    // layers log until they are destroyed
+    Engine::Log::Shutdown();
 }
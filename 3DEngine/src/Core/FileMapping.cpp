@@ -0,0 +1,159 @@
+#include "FileMapping.h"
+
+#include <fstream>
+#include <utility>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Engine
+{
+FileMapping::FileMapping(const std::filesystem::path &path)
+{
+    if (!Map(path)) Read(path);
+}
+
+FileMapping::~FileMapping() { Close(); }
+
+FileMapping FileMapping::FromView(std::shared_ptr<const FileMapping> parent, uint64_t offset, uint64_t size)
+{
+    FileMapping view;
+    if (!parent || !parent->IsValid() || offset > parent->GetSize() || size > parent->GetSize() - offset) return view;
+
+    view.m_Data = parent->GetData() + offset;
+    view.m_Size = size;
+    view.m_Valid = true;
+    view.m_Mapped = parent->IsMapped();
+    view.m_Parent = std::move(parent);
+    return view;
+}
+
+FileMapping FileMapping::FromBuffer(ScopedBuffer buffer)
+{
+    FileMapping file;
+    file.m_Storage = std::move(buffer);
+    file.m_Data = file.m_Storage.Data();
+    file.m_Size = file.m_Storage.Size();
+    file.m_Valid = true;
+    return file;
+}
+
+FileMapping::FileMapping(FileMapping &&other) noexcept { *this = std::move(other); }
+
+FileMapping &FileMapping::operator=(FileMapping &&other) noexcept
+{
+    if (this == &other) return *this;
+
+    Close();
+    m_Data = std::exchange(other.m_Data, nullptr);
+    m_Size = std::exchange(other.m_Size, 0);
+    m_Valid = std::exchange(other.m_Valid, false);
+    m_Mapped = std::exchange(other.m_Mapped, false);
+    m_Storage = std::move(other.m_Storage);
+    m_Parent = std::move(other.m_Parent);
+    return *this;
+}
+
+bool FileMapping::Map(const std::filesystem::path &path)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    // an empty file can't be mapped
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return false;
+    }
+
+    // the view keeps the mapping and the file open on its own
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (!mapping) return false;
+
+    void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!view) return false;
+
+    m_Size = (uint64_t)size.QuadPart;
+#elif defined(__unix__) || defined(__APPLE__)
+    const int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) return false;
+
+    struct stat info;
+    if (fstat(file, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+    {
+        close(file);
+        return false;
+    }
+
+    // the mapping keeps the file open on its own
+    void *view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (view == MAP_FAILED) return false;
+
+    // loaders read the file front to back right away
+    madvise(view, (size_t)info.st_size, MADV_WILLNEED);
+    m_Size = (uint64_t)info.st_size;
+#else
+    return false;
+#endif
+
+    m_Data = (const uint8_t *)view;
+    m_Valid = m_Mapped = true;
+    return true;
+}
+
+bool FileMapping::Read(const std::filesystem::path &path)
+{
+    // a directory opens fine on some platforms
+    std::error_code error;
+    if (!std::filesystem::is_regular_file(path, error)) return false;
+
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream) return false;
+
+    const std::streamoff size = stream.tellg();
+    if (size < 0) return false;
+    stream.seekg(0, std::ios::beg);
+
+    if (size > 0)
+    {
+        ScopedBuffer storage((uint64_t)size);
+        if (!storage || !stream.read((char *)storage.Data(), size)) return false;
+        m_Storage = std::move(storage);
+    }
+
+    m_Data = m_Storage.Data();
+    m_Size = (uint64_t)size;
+    m_Valid = true;
+    return true;
+}
+
+void FileMapping::Close()
+{
+    if (m_Mapped && !m_Parent)
+    {
+#ifdef _WIN32
+        UnmapViewOfFile(m_Data);
+#elif defined(__unix__) || defined(__APPLE__)
+        munmap((void *)m_Data, (size_t)m_Size);
+#endif
+    }
+    m_Storage = ScopedBuffer();
+    m_Parent.reset();
+    m_Data = nullptr;
+    m_Size = 0;
+    m_Valid = m_Mapped = false;
+}
+} // namespace Engine
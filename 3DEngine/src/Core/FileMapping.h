@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Buffer.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <memory>
+#include <streambuf>
+#include <string_view>
+
+namespace Engine
+{
+// A read-only view of a whole file. Where the platform allows it the file is mapped into memory, so pages are only
+// read when first touched and nothing is copied; otherwise, or when mapping fails, the file is read into memory the
+// mapping owns. Either way the data stays valid as long as the mapping.
+// A mapped file must not be truncated by another process while it is in use.
+//
+// Files inside a pak are views into the pak's mapping, which they keep alive, or buffers they were decompressed to.
+class FileMapping
+{
+  public:
+    FileMapping() = default;
+    explicit FileMapping(const std::filesystem::path &path);
+    ~FileMapping();
+
+    // size bytes at offset of parent, sharing its pages
+    static FileMapping FromView(std::shared_ptr<const FileMapping> parent, uint64_t offset, uint64_t size);
+    // takes over memory, e.g. a decompressed file
+    static FileMapping FromBuffer(ScopedBuffer buffer);
+
+    FileMapping(const FileMapping &) = delete;
+    FileMapping &operator=(const FileMapping &) = delete;
+    FileMapping(FileMapping &&other) noexcept;
+    FileMapping &operator=(FileMapping &&other) noexcept;
+
+    // false when the file could not be opened; an empty file is valid with no data
+    bool IsValid() const { return m_Valid; }
+    // whether the data is the file's pages rather than a copy
+    bool IsMapped() const { return m_Mapped; }
+
+    const uint8_t *GetData() const { return m_Data; }
+    uint64_t GetSize() const { return m_Size; }
+
+    // non-owning views, valid as long as the mapping
+    Buffer GetBuffer() const { return Buffer(m_Data, m_Size); }
+    std::string_view GetString() const { return std::string_view((const char *)m_Data, m_Size); }
+
+    explicit operator bool() const { return m_Valid; }
+
+  private:
+    bool Map(const std::filesystem::path &path);
+    bool Read(const std::filesystem::path &path);
+    void Close();
+
+  private:
+    const uint8_t *m_Data = nullptr;
+    uint64_t m_Size = 0;
+    bool m_Valid = false;
+    bool m_Mapped = false;
+    // the copy when the file could not be mapped
+    ScopedBuffer m_Storage;
+    // what a view points into, it is unmapped with the parent
+    std::shared_ptr<const FileMapping> m_Parent;
+};
+
+// std::istream over memory it does not own, for parsers that only take streams, e.g. YAML::Load
+class MemoryStream : public std::istream
+{
+  public:
+    MemoryStream(const void *data, uint64_t size) : std::istream(&m_StreamBuffer), m_StreamBuffer(data, size) {}
+    explicit MemoryStream(const FileMapping &file) : MemoryStream(file.GetData(), file.GetSize()) {}
+
+  private:
+    class StreamBuffer : public std::streambuf
+    {
+      public:
+        StreamBuffer(const void *data, uint64_t size)
+        {
+            char *begin = (char *)data;
+            setg(begin, begin, begin + size);
+        }
+
+      protected:
+        pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode) override
+        {
+            char *position = dir == std::ios_base::beg ? eback() : dir == std::ios_base::cur ? gptr() : egptr();
+            position += offset;
+            if (position < eback() || position > egptr()) return pos_type(off_type(-1));
+
+            setg(eback(), position, egptr());
+            return pos_type(position - eback());
+        }
+
+        pos_type seekpos(pos_type position, std::ios_base::openmode mode) override
+        {
+            return seekoff(off_type(position), std::ios_base::beg, mode);
+        }
+    };
+
+    StreamBuffer m_StreamBuffer;
+};
+} // namespace Engine
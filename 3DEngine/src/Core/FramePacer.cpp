@@ -0,0 +1,102 @@
+#include "FramePacer.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#include <timeapi.h>
+#endif
+
+namespace Engine
+{
+namespace Utils
+{
+static FramePacingSettings s_Settings;
+// the first frames are always drawn
+static std::atomic<uint32_t> s_RedrawFrames = 2;
+static std::atomic<bool> s_WaitingForEvents = false;
+static double s_NextFrame = 0.0;
+
+// running mean and deviation of what a 1 ms sleep really takes, starting pessimistic
+static double s_SleepMean = 0.005, s_SleepM2 = 0.0, s_SleepEstimate = 0.005;
+static uint64_t s_SleepCount = 1;
+static bool s_TimerResolutionRaised = false;
+} // namespace Utils
+
+FramePacingSettings &FramePacer::GetSettings() { return Utils::s_Settings; }
+
+void FramePacer::RequestRedraw()
+{
+    Utils::s_RedrawFrames = 2;
+    // a loop blocked on events would only notice with the next one
+    if (Utils::s_WaitingForEvents) glfwPostEmptyEvent();
+}
+
+bool FramePacer::WaitForNextFrame(bool focused, bool minimized)
+{
+    const auto &settings = Utils::s_Settings;
+    if (minimized || (settings.RenderOnDemand && Utils::s_RedrawFrames == 0))
+    {
+        Utils::s_WaitingForEvents = true;
+        // checked again now that the flag is up, a request in between would sleep until the timeout otherwise
+        if (minimized || Utils::s_RedrawFrames == 0) glfwWaitEventsTimeout(1.0 / std::max(settings.IdleFPS, 1.0f));
+        Utils::s_WaitingForEvents = false;
+
+        // the window callbacks request a redraw for input that came in
+        if (minimized || (settings.RenderOnDemand && Utils::s_RedrawFrames == 0)) return false;
+    }
+
+    const float fps = focused ? settings.ForegroundFPS : settings.BackgroundFPS;
+    if (fps > 0.0f)
+    {
+        const double interval = 1.0 / fps;
+        const double now = glfwGetTime();
+        if (now < Utils::s_NextFrame)
+            WaitUntil(Utils::s_NextFrame);
+        // after a long frame or an idle stretch the cadence starts over instead of rushing frames to catch up
+        else if (now - Utils::s_NextFrame > interval)
+            Utils::s_NextFrame = now;
+        Utils::s_NextFrame += interval;
+    }
+
+    uint32_t frames = Utils::s_RedrawFrames;
+    while (frames > 0 && !Utils::s_RedrawFrames.compare_exchange_weak(frames, frames - 1)) {}
+    return true;
+}
+
+void FramePacer::WaitUntil(double deadline)
+{
+#ifdef _WIN32
+    // Windows sleeps in 15.6 ms steps otherwise
+    if (!Utils::s_TimerResolutionRaised) timeBeginPeriod(1);
+#endif
+    Utils::s_TimerResolutionRaised = true;
+
+    double remaining = deadline - glfwGetTime();
+    while (remaining > Utils::s_SleepEstimate)
+    {
+        const double start = glfwGetTime();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        const double slept = glfwGetTime() - start;
+        remaining -= slept;
+
+        // Welford's update, sleeping stops a deviation short of where it overshot before
+        Utils::s_SleepCount++;
+        const double delta = slept - Utils::s_SleepMean;
+        Utils::s_SleepMean += delta / Utils::s_SleepCount;
+        Utils::s_SleepM2 += delta * (slept - Utils::s_SleepMean);
+        Utils::s_SleepEstimate = Utils::s_SleepMean + std::sqrt(Utils::s_SleepM2 / (Utils::s_SleepCount - 1));
+    }
+
+    // the rest is shorter than a sleep reliably is
+    while (glfwGetTime() < deadline)
+        std::this_thread::yield();
+}
+} // namespace Engine
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+struct FramePacingSettings
+{
+    bool VSync = true;
+    // frame rate caps, 0 leaves it to vsync
+    float ForegroundFPS = 0.0f;
+    float BackgroundFPS = 30.0f;
+    // how often a loop with nothing to draw wakes up to run the main thread queue, minimized or idle on demand
+    float IdleFPS = 10.0f;
+    // frames are only drawn after input, or when something calls RequestRedraw
+    bool RenderOnDemand = false;
+};
+
+// Decides when the application loop starts its next frame. Frame rate caps wait with a hybrid limiter: it sleeps
+// in short slices while the deadline is further away than sleeping tends to overshoot, and spins the rest.
+//
+// Without RenderOnDemand every frame is drawn. With it, the loop blocks on window events until input arrives or
+// RequestRedraw is called; playing scenes, reloaded assets and animating panels keep asking for frames that way.
+class FramePacer
+{
+  public:
+    static FramePacingSettings &GetSettings();
+
+    // draws the next couple of frames, ImGui settles a frame after the input that changed it; any thread
+    static void RequestRedraw();
+
+    // blocks until the next frame is due; false if it shouldn't be drawn, the loop only runs its queue then
+    static bool WaitForNextFrame(bool focused, bool minimized);
+
+  private:
+    static void WaitUntil(double deadline);
+};
+} // namespace Engine
@@ -0,0 +1,204 @@
+#include "JobSystem.h"
+
+#include "Log.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+namespace Utils
+{
+struct QueuedJob
+{
+    Job Function;
+    JobCounter *Counter;
+};
+
+struct JobQueue
+{
+    std::mutex Mutex;
+    std::deque<QueuedJob> Jobs;
+};
+
+// queue 0 belongs to the threads that aren't workers, worker i owns queue i + 1
+static std::vector<std::unique_ptr<JobQueue>> s_Queues;
+static std::vector<std::thread> s_Workers;
+
+static std::atomic<bool> s_Running = false;
+// can dip below zero for a moment, when a job is taken before its submitter counted it
+static std::atomic<int32_t> s_QueuedJobs = 0;
+static std::mutex s_SleepMutex;
+static std::condition_variable s_WakeUp;
+
+static thread_local uint32_t t_QueueIndex = 0;
+static thread_local bool t_IsWorker = false;
+
+static bool PopJob(uint32_t self, QueuedJob &job)
+{
+    // own jobs newest first, they are the most likely to still be in cache
+    {
+        auto &queue = *s_Queues[self];
+        std::scoped_lock<std::mutex> lock(queue.Mutex);
+        if (!queue.Jobs.empty())
+        {
+            job = std::move(queue.Jobs.back());
+            queue.Jobs.pop_back();
+            return true;
+        }
+    }
+
+    // then the oldest job of someone else, starting next to us so thieves spread out
+    const uint32_t queueCount = s_Queues.size();
+    for (uint32_t i = 1; i < queueCount; i++)
+    {
+        auto &queue = *s_Queues[(self + i) % queueCount];
+        std::scoped_lock<std::mutex> lock(queue.Mutex);
+        if (queue.Jobs.empty()) continue;
+
+        job = std::move(queue.Jobs.front());
+        queue.Jobs.pop_front();
+        return true;
+    }
+    return false;
+}
+} // namespace Utils
+
+void JobSystem::Init(uint32_t workerCount)
+{
+    if (Utils::s_Running) return;
+
+    if (workerCount == 0) workerCount = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+    Utils::s_Queues.clear();
+    for (uint32_t i = 0; i <= workerCount; i++)
+        Utils::s_Queues.push_back(std::make_unique<Utils::JobQueue>());
+
+    Utils::s_Running = true;
+    for (uint32_t i = 0; i < workerCount; i++)
+        Utils::s_Workers.emplace_back(WorkerMain, i);
+
+    LOG_CORE_INFO("JobSystem: {} workers", workerCount);
+}
+
+void JobSystem::Shutdown()
+{
+    if (!Utils::s_Running) return;
+
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_SleepMutex);
+        Utils::s_Running = false;
+    }
+    Utils::s_WakeUp.notify_all();
+
+    for (auto &worker : Utils::s_Workers)
+        worker.join();
+    Utils::s_Workers.clear();
+
+    // what the workers left runs here; the queues stay until the next Init for submits racing with this
+    while (RunOneJob()) {}
+    Utils::s_QueuedJobs = 0;
+}
+
+uint32_t JobSystem::GetWorkerCount() { return Utils::s_Workers.size(); }
+
+bool JobSystem::IsWorkerThread() { return Utils::t_IsWorker; }
+
+void JobSystem::Submit(Job job, JobCounter *counter)
+{
+    if (!Utils::s_Running)
+    {
+        job();
+        return;
+    }
+
+    if (counter) counter->m_Pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        auto &queue = *Utils::s_Queues[Utils::t_QueueIndex];
+        std::scoped_lock<std::mutex> lock(queue.Mutex);
+        queue.Jobs.push_back({std::move(job), counter});
+    }
+
+    // taken under the sleep lock so a worker can't check for jobs and go to sleep in between
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_SleepMutex);
+        Utils::s_QueuedJobs++;
+    }
+    Utils::s_WakeUp.notify_one();
+
+    // Shutdown began meanwhile and may be done draining
+    if (!Utils::s_Running)
+    {
+        while (RunOneJob()) {}
+    }
+}
+
+void JobSystem::Wait(JobCounter &counter)
+{
+    while (!counter.IsDone())
+    {
+        if (!RunOneJob()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)> &func)
+{
+    if (count == 0) return;
+
+    // a few chunks per thread evens out uneven work without drowning the queues
+    const size_t threads = GetWorkerCount() + 1;
+    const size_t chunk = std::max(std::max(minChunk, (size_t)1), (count + threads * 4 - 1) / (threads * 4));
+    if (chunk >= count || !Utils::s_Running)
+    {
+        func(0, count);
+        return;
+    }
+
+    JobCounter counter;
+    for (size_t begin = chunk; begin < count; begin += chunk)
+    {
+        const size_t end = std::min(begin + chunk, count);
+        Submit([&func, begin, end] { func(begin, end); }, &counter);
+    }
+    func(0, chunk);
+    Wait(counter);
+}
+
+bool JobSystem::RunOneJob()
+{
+    // also after Shutdown, so waiting on a counter finishes its jobs inline
+    if (Utils::s_Queues.empty()) return false;
+
+    Utils::QueuedJob job;
+    if (!Utils::PopJob(Utils::t_QueueIndex, job)) return false;
+
+    Utils::s_QueuedJobs--;
+    job.Function();
+    if (job.Counter) job.Counter->m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::WorkerMain(uint32_t index)
+{
+    Utils::t_QueueIndex = index + 1;
+    Utils::t_IsWorker = true;
+    Profiler::SetThreadName("Worker " + std::to_string(index));
+
+    for (;;)
+    {
+        if (RunOneJob()) continue;
+        // the queues are empty before a worker leaves
+        if (!Utils::s_Running) return;
+
+        std::unique_lock<std::mutex> lock(Utils::s_SleepMutex);
+        Utils::s_WakeUp.wait(lock, [] { return !Utils::s_Running || Utils::s_QueuedJobs > 0; });
+    }
+}
+} // namespace Engine
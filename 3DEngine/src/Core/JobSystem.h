@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+namespace Engine
+{
+using Job = std::function<void()>;
+
+// Number of jobs submitted against it that haven't finished yet. JobSystem::Wait returns once it drops to zero.
+class JobCounter
+{
+  public:
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    bool IsDone() const { return m_Pending.load(std::memory_order_acquire) == 0; }
+
+  private:
+    friend class JobSystem;
+    std::atomic<uint32_t> m_Pending = 0;
+};
+
+// A fixed set of worker threads with a deque each. A worker pushes and pops its own jobs at the back and, once it
+// runs dry, steals from the front of the others; threads that aren't workers share one more deque. A thread that
+// waits for a counter runs jobs meanwhile, so jobs may wait on jobs they submit.
+//
+// Without Init(), or with no workers, Submit runs the job right away and everything else still works. Shutdown
+// finishes the jobs still queued, and a Wait after it runs whatever is left on the waiting thread.
+class JobSystem
+{
+  public:
+    // 0 picks hardware_concurrency() - 1, at least one
+    static void Init(uint32_t workerCount = 0);
+    static void Shutdown();
+
+    static uint32_t GetWorkerCount();
+    static bool IsWorkerThread();
+
+    // counter may be null for jobs nobody waits for
+    static void Submit(Job job, JobCounter *counter = nullptr);
+    static void Wait(JobCounter &counter);
+
+    // func(begin, end) over [0, count) in chunks of at least minChunk items, the caller takes a chunk as well;
+    // returns when all of them are done
+    static void ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)> &func);
+
+  private:
+    static bool RunOneJob();
+    static void WorkerMain(uint32_t index);
+};
+} // namespace Engine
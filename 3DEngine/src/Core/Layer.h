@@ -25,6 +25,8 @@ class Layer
     virtual void OnMouseScrolled(double xOffset, double yOffset) {}
     virtual void OnWindowResize(int width, int height) {}
 
+    const std::string &GetName() const { return m_DebugName; }
+
   protected:
     std::string m_DebugName;
 };
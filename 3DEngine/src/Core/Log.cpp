@@ -1,20 +1,61 @@
 #include "Log.h"
 
+#include <spdlog/async.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
 
+#include <chrono>
+
 namespace Engine
 {
 std::shared_ptr<spdlog::logger> Log::s_CoreLogger;
 std::shared_ptr<spdlog::logger> Log::s_ClientLogger;
 
-void Log::Init()
+void Log::Init(const LogSettings &settings)
+{
+    if (s_CoreLogger) return;
+
+    // one sink thread keeps the messages in order
+    spdlog::init_thread_pool(settings.QueueSize, 1);
+    const auto overflow = settings.Overflow == LogOverflowPolicy::Block ? spdlog::async_overflow_policy::block
+                                                                        : spdlog::async_overflow_policy::overrun_oldest;
+    auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+
+    s_CoreLogger = std::make_shared<spdlog::async_logger>("Engine", sink, spdlog::thread_pool(), overflow);
+    s_ClientLogger = std::make_shared<spdlog::async_logger>("App", sink, spdlog::thread_pool(), overflow);
+    for (const auto &logger : {s_CoreLogger, s_ClientLogger})
+    {
+        logger->set_pattern("%^[%T] %n: %v%$");
+        logger->set_level(spdlog::level::trace);
+        spdlog::register_logger(logger);
+    }
+}
+
+void Log::Shutdown()
+{
+    // drains the queue and joins the sink thread, later messages are reported to stderr and dropped
+    spdlog::shutdown();
+}
+
+size_t Log::GetDroppedCount()
+{
+    auto threadPool = spdlog::thread_pool();
+    return threadPool ? threadPool->overrun_counter() : 0;
+}
+
+bool LogRateLimiter::Allow(double intervalSeconds, uint32_t &suppressed)
 {
-    spdlog::set_pattern("%^[%T] %n: %v%$");
-    s_CoreLogger = spdlog::stdout_color_mt("Engine");
-    s_CoreLogger->set_level(spdlog::level::trace);
+    const int64_t now =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    int64_t next = m_NextAllowed.load(std::memory_order_relaxed);
+    if (now < next || !m_NextAllowed.compare_exchange_strong(next, now + (int64_t)(intervalSeconds * 1e9)))
+    {
+        m_Suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
 
-    s_ClientLogger = spdlog::stdout_color_mt("App");
-    s_ClientLogger->set_level(spdlog::level::trace);
+    suppressed = m_Suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
 }
 } // namespace Engine
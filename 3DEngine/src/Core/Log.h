@@ -1,5 +1,8 @@
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 
 #pragma warning(push, 0)
@@ -7,12 +10,42 @@
 #include <spdlog/fmt/ostr.h>
 #pragma warning(pop)
 
+// messages below this level compile out, Dist builds keep warnings and up; one of the SPDLOG_LEVEL_* values
+#ifndef ENGINE_LOG_LEVEL
+#ifdef HZ_DIST
+#define ENGINE_LOG_LEVEL SPDLOG_LEVEL_WARN
+#else
+#define ENGINE_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
 namespace Engine
 {
+enum class LogOverflowPolicy
+{
+    // the logging thread waits for room, nothing is lost
+    Block,
+    // the oldest queued message makes room, logging never waits
+    DropOldest
+};
+
+struct LogSettings
+{
+    // messages queued for the sink thread at most
+    size_t QueueSize = 8192;
+    LogOverflowPolicy Overflow = LogOverflowPolicy::DropOldest;
+};
+
+// Loggers hand their messages to one background thread, which formats and writes them out; the calling thread only
+// formats the message text and queues it. Shutdown() writes what is still queued, once nothing logs anymore.
 class Log
 {
   public:
-    static void Init();
+    static void Init(const LogSettings &settings = LogSettings());
+    static void Shutdown();
+
+    // messages DropOldest threw away so far
+    static size_t GetDroppedCount();
 
     inline static std::shared_ptr<spdlog::logger> &GetCoreLogger() { return s_CoreLogger; }
     inline static std::shared_ptr<spdlog::logger> &GetClientLogger() { return s_ClientLogger; }
@@ -21,16 +54,69 @@ class Log
     static std::shared_ptr<spdlog::logger> s_CoreLogger;
     static std::shared_ptr<spdlog::logger> s_ClientLogger;
 };
+
+// Lets one message through per interval, used by the *_LIMITED macros with one limiter per call site.
+class LogRateLimiter
+{
+  public:
+    // suppressed is how many were held back since the last one that passed
+    bool Allow(double intervalSeconds, uint32_t &suppressed);
+
+  private:
+    std::atomic<int64_t> m_NextAllowed = 0;
+    std::atomic<uint32_t> m_Suppressed = 0;
+};
 } // namespace Engine
 
+#if ENGINE_LOG_LEVEL <= SPDLOG_LEVEL_TRACE
 #define LOG_CORE_TRACE(...) ::Engine::Log::GetCoreLogger()->trace(__VA_ARGS__)
-#define LOG_CORE_INFO(...) ::Engine::Log::GetCoreLogger()->info(__VA_ARGS__)
-#define LOG_CORE_WARN(...) ::Engine::Log::GetCoreLogger()->warn(__VA_ARGS__)
-#define LOG_CORE_ERROR(...) ::Engine::Log::GetCoreLogger()->error(__VA_ARGS__)
-#define LOG_CORE_CRITICAL(...) ::Engine::Log::GetCoreLogger()->critical(__VA_ARGS__)
-
 #define LOG_TRACE(...) ::Engine::Log::GetClientLogger()->trace(__VA_ARGS__)
+#else
+#define LOG_CORE_TRACE(...) (void)0
+#define LOG_TRACE(...) (void)0
+#endif
+
+#if ENGINE_LOG_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_CORE_INFO(...) ::Engine::Log::GetCoreLogger()->info(__VA_ARGS__)
 #define LOG_INFO(...) ::Engine::Log::GetClientLogger()->info(__VA_ARGS__)
+#else
+#define LOG_CORE_INFO(...) (void)0
+#define LOG_INFO(...) (void)0
+#endif
+
+#if ENGINE_LOG_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_CORE_WARN(...) ::Engine::Log::GetCoreLogger()->warn(__VA_ARGS__)
 #define LOG_WARN(...) ::Engine::Log::GetClientLogger()->warn(__VA_ARGS__)
+#else
+#define LOG_CORE_WARN(...) (void)0
+#define LOG_WARN(...) (void)0
+#endif
+
+#if ENGINE_LOG_LEVEL <= SPDLOG_LEVEL_ERROR
+#define LOG_CORE_ERROR(...) ::Engine::Log::GetCoreLogger()->error(__VA_ARGS__)
 #define LOG_ERROR(...) ::Engine::Log::GetClientLogger()->error(__VA_ARGS__)
+#else
+#define LOG_CORE_ERROR(...) (void)0
+#define LOG_ERROR(...) (void)0
+#endif
+
+#define LOG_CORE_CRITICAL(...) ::Engine::Log::GetCoreLogger()->critical(__VA_ARGS__)
 #define LOG_CRITICAL(...) ::Engine::Log::GetClientLogger()->critical(__VA_ARGS__)
+
+// for messages a hot path may repeat every frame: at most one per interval from the call site
+#define ENGINE_LOG_LIMITED(log, seconds, ...)                                                                          \
+    do                                                                                                                 \
+    {                                                                                                                  \
+        static ::Engine::LogRateLimiter s_LogLimiter;                                                                  \
+        uint32_t suppressed = 0;                                                                                       \
+        if (s_LogLimiter.Allow(seconds, suppressed))                                                                   \
+        {                                                                                                              \
+            if (suppressed > 0) log("{} similar messages suppressed", suppressed);                                     \
+            log(__VA_ARGS__);                                                                                          \
+        }                                                                                                              \
+    } while (false)
+
+#define LOG_CORE_WARN_LIMITED(seconds, ...) ENGINE_LOG_LIMITED(LOG_CORE_WARN, seconds, __VA_ARGS__)
+#define LOG_CORE_ERROR_LIMITED(seconds, ...) ENGINE_LOG_LIMITED(LOG_CORE_ERROR, seconds, __VA_ARGS__)
+#define LOG_WARN_LIMITED(seconds, ...) ENGINE_LOG_LIMITED(LOG_WARN, seconds, __VA_ARGS__)
+#define LOG_ERROR_LIMITED(seconds, ...) ENGINE_LOG_LIMITED(LOG_ERROR, seconds, __VA_ARGS__)
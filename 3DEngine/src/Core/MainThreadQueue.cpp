@@ -0,0 +1,71 @@
+#include "MainThreadQueue.h"
+
+#include "Profiler.h"
+
+#include <chrono>
+
+namespace Engine
+{
+void MainThreadQueue::Submit(Task task, TaskPriority priority)
+{
+    std::scoped_lock<std::mutex> lock(m_Mutex);
+    m_Submitted.push_back({std::move(task), priority});
+}
+
+uint32_t MainThreadQueue::Execute(double budgetMs)
+{
+    // the batch keeps its allocation from one drain to the next
+    {
+        std::scoped_lock<std::mutex> lock(m_Mutex);
+        std::swap(m_Submitted, m_Batch);
+    }
+    for (auto &entry : m_Batch)
+        m_Pending[(size_t)entry.Priority].push_back(std::move(entry.Function));
+    m_Batch.clear();
+
+    const auto start = std::chrono::steady_clock::now();
+    uint32_t executed = 0;
+
+    auto &high = m_Pending[(size_t)TaskPriority::High];
+    while (!high.empty())
+    {
+        Task task = std::move(high.front());
+        high.pop_front();
+        task();
+        executed++;
+    }
+
+    bool ranBudgeted = false;
+    for (size_t priority = (size_t)TaskPriority::Normal; priority < (size_t)TaskPriority::Count; priority++)
+    {
+        auto &tasks = m_Pending[priority];
+        while (!tasks.empty())
+        {
+            const double elapsedMs =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (ranBudgeted && elapsedMs >= budgetMs) break;
+
+            Task task = std::move(tasks.front());
+            tasks.pop_front();
+            task();
+            executed++;
+            ranBudgeted = true;
+        }
+    }
+
+    PROFILE_COUNTER("Main Thread Tasks", executed);
+    PROFILE_COUNTER("Main Thread Tasks Deferred",
+                    m_Pending[(size_t)TaskPriority::Normal].size() + m_Pending[(size_t)TaskPriority::Low].size());
+    return executed;
+}
+
+size_t MainThreadQueue::GetPendingCount()
+{
+    size_t count = 0;
+    for (const auto &tasks : m_Pending)
+        count += tasks.size();
+
+    std::scoped_lock<std::mutex> lock(m_Mutex);
+    return count + m_Submitted.size();
+}
+} // namespace Engine
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Task.h"
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace Engine
+{
+enum class TaskPriority : uint8_t
+{
+    // runs with the next drain whatever it costs, for work something waits on
+    High = 0,
+    // run oldest first while the drain's time budget lasts, the rest waits for the next frame
+    Normal,
+    // only once no Normal task is left, e.g. GPU uploads of assets loaded in the background
+    Low,
+    Count
+};
+
+// Work other threads hand to the main thread. Submitting only appends under a short lock; the drain swaps the
+// submitted batch out and runs it without the lock, so tasks may submit more, which then runs with the next drain.
+class MainThreadQueue
+{
+  public:
+    // any thread
+    void Submit(Task task, TaskPriority priority = TaskPriority::Normal);
+
+    // main thread; runs every High task and others until budgetMs is spent, but at least one so nothing starves
+    uint32_t Execute(double budgetMs);
+
+    // submitted or carried over, main thread
+    size_t GetPendingCount();
+
+  private:
+    struct Entry
+    {
+        Task Function;
+        TaskPriority Priority;
+    };
+
+    std::mutex m_Mutex;
+    std::vector<Entry> m_Submitted;
+
+    // main thread only
+    std::vector<Entry> m_Batch;
+    std::deque<Task> m_Pending[(size_t)TaskPriority::Count];
+};
+} // namespace Engine
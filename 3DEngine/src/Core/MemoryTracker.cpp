@@ -0,0 +1,231 @@
+#include "MemoryTracker.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+namespace Engine
+{
+namespace Utils
+{
+constexpr size_t TagCount = (size_t)MemoryTag::Count;
+constexpr size_t GPUTypeCount = (size_t)GPUMemoryType::Count;
+
+// what malloc guarantees on 64-bit Windows and Linux
+constexpr size_t MallocAlignment = 16;
+
+// in front of every block, so Free knows the size and tag without a lookup
+struct alignas(MallocAlignment) AllocationHeader
+{
+    size_t Size;
+    uint32_t Offset; // from the start of the malloc block to the user pointer
+    MemoryTag Tag;
+};
+static_assert(sizeof(AllocationHeader) == MallocAlignment);
+
+struct Counters
+{
+    std::atomic<size_t> Current = 0;
+    std::atomic<size_t> Peak = 0;
+    std::atomic<size_t> Allocations = 0;
+    std::atomic<size_t> Budget = 0;
+
+    void Add(size_t bytes)
+    {
+        const size_t current = Current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+
+        size_t peak = Peak.load(std::memory_order_relaxed);
+        while (current > peak && !Peak.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+    }
+
+    void Remove(size_t bytes)
+    {
+        Current.fetch_sub(bytes, std::memory_order_relaxed);
+        Allocations.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    MemoryStats Load() const
+    {
+        return {Current.load(std::memory_order_relaxed), Peak.load(std::memory_order_relaxed),
+                Allocations.load(std::memory_order_relaxed), Budget.load(std::memory_order_relaxed)};
+    }
+};
+
+// constant initialized, operator new may run before any dynamic initializer
+static Counters s_Tags[TagCount];
+static Counters s_Total;
+static thread_local MemoryTag t_Tag = MemoryTag::Untagged;
+
+static Counters s_GPU[GPUTypeCount];
+static std::mutex s_GPUMutex;
+// GL deletes only know the id, so the size is remembered per object
+static std::unordered_map<uint32_t, size_t> s_GPUSizes[GPUTypeCount];
+
+static const char *s_TagNames[TagCount] = {"Untagged", "Renderer", "Assets", "Physics", "Scripting", "Editor"};
+static const char *s_GPUTypeNames[GPUTypeCount] = {"Textures", "Buffers", "Renderbuffers"};
+
+static size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+#ifdef ENGINE_TRACK_MEMORY
+static void *AllocateOrThrow(size_t size, size_t alignment)
+{
+    void *ptr = MemoryTracker::Allocate(size, alignment, t_Tag);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+static void *AllocateNoThrow(size_t size, size_t alignment) { return MemoryTracker::Allocate(size, alignment, t_Tag); }
+#endif
+} // namespace Utils
+
+void *MemoryTracker::Allocate(size_t size, size_t alignment, MemoryTag tag)
+{
+    using Utils::AllocationHeader;
+
+    alignment = std::max(alignment, Utils::MallocAlignment);
+    size = std::max<size_t>(size, 1);
+
+    const size_t padding = sizeof(AllocationHeader) + alignment - Utils::MallocAlignment;
+    auto *raw = static_cast<std::byte *>(std::malloc(size + padding));
+    if (!raw) return nullptr;
+
+    auto *ptr = reinterpret_cast<std::byte *>(Utils::AlignUp((uintptr_t)raw + sizeof(AllocationHeader), alignment));
+    auto *header = reinterpret_cast<AllocationHeader *>(ptr) - 1;
+    header->Size = size;
+    header->Offset = (uint32_t)(ptr - raw);
+    header->Tag = tag;
+
+    Utils::s_Tags[(size_t)tag].Add(size);
+    Utils::s_Total.Add(size);
+    return ptr;
+}
+
+void MemoryTracker::Free(void *ptr)
+{
+    if (!ptr) return;
+
+    const auto *header = static_cast<const Utils::AllocationHeader *>(ptr) - 1;
+    Utils::s_Tags[(size_t)header->Tag].Remove(header->Size);
+    Utils::s_Total.Remove(header->Size);
+    std::free(static_cast<std::byte *>(ptr) - header->Offset);
+}
+
+MemoryTag MemoryTracker::GetThreadTag() { return Utils::t_Tag; }
+
+void MemoryTracker::SetThreadTag(MemoryTag tag) { Utils::t_Tag = tag; }
+
+MemoryStats MemoryTracker::GetStats(MemoryTag tag) { return Utils::s_Tags[(size_t)tag].Load(); }
+
+MemoryStats MemoryTracker::GetTotalStats() { return Utils::s_Total.Load(); }
+
+const char *MemoryTracker::GetTagName(MemoryTag tag) { return Utils::s_TagNames[(size_t)tag]; }
+
+void MemoryTracker::TrackGPU(GPUMemoryType type, uint32_t id, size_t bytes)
+{
+    if (id == 0) return;
+
+    std::scoped_lock<std::mutex> lock(Utils::s_GPUMutex);
+    auto &counters = Utils::s_GPU[(size_t)type];
+    // storage of an existing object being respecified replaces what it had
+    auto [it, inserted] = Utils::s_GPUSizes[(size_t)type].try_emplace(id, bytes);
+    if (!inserted)
+    {
+        counters.Remove(it->second);
+        it->second = bytes;
+    }
+    counters.Add(bytes);
+}
+
+void MemoryTracker::UntrackGPU(GPUMemoryType type, uint32_t id)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_GPUMutex);
+    auto &sizes = Utils::s_GPUSizes[(size_t)type];
+    auto it = sizes.find(id);
+    if (it == sizes.end()) return;
+
+    Utils::s_GPU[(size_t)type].Remove(it->second);
+    sizes.erase(it);
+}
+
+MemoryStats MemoryTracker::GetGPUStats(GPUMemoryType type) { return Utils::s_GPU[(size_t)type].Load(); }
+
+const char *MemoryTracker::GetGPUTypeName(GPUMemoryType type) { return Utils::s_GPUTypeNames[(size_t)type]; }
+
+void MemoryTracker::SetBudget(MemoryTag tag, size_t bytes)
+{
+    Utils::s_Tags[(size_t)tag].Budget.store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::SetGPUBudget(GPUMemoryType type, size_t bytes)
+{
+    Utils::s_GPU[(size_t)type].Budget.store(bytes, std::memory_order_relaxed);
+}
+
+void MemoryTracker::ReportFrame()
+{
+#ifdef ENGINE_PROFILE
+    constexpr double MB = 1024.0 * 1024.0;
+    PROFILE_COUNTER("Heap MB", GetTotalStats().Current / MB);
+    PROFILE_COUNTER("Heap Allocations", GetTotalStats().Allocations);
+    PROFILE_COUNTER("GPU Textures MB", GetGPUStats(GPUMemoryType::Textures).Current / MB);
+    PROFILE_COUNTER("GPU Buffers MB", GetGPUStats(GPUMemoryType::Buffers).Current / MB);
+    PROFILE_COUNTER("GPU Renderbuffers MB", GetGPUStats(GPUMemoryType::Renderbuffers).Current / MB);
+#endif
+}
+} // namespace Engine
+
+#ifdef ENGINE_TRACK_MEMORY
+// replacements of the global allocation functions, everything the executable allocates with new lands here
+void *operator new(size_t size) { return Engine::Utils::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new[](size_t size) { return Engine::Utils::AllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new(size_t size, std::align_val_t alignment)
+{
+    return Engine::Utils::AllocateOrThrow(size, (size_t)alignment);
+}
+void *operator new[](size_t size, std::align_val_t alignment)
+{
+    return Engine::Utils::AllocateOrThrow(size, (size_t)alignment);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return Engine::Utils::AllocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return Engine::Utils::AllocateNoThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+void *operator new(size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return Engine::Utils::AllocateNoThrow(size, (size_t)alignment);
+}
+void *operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t &) noexcept
+{
+    return Engine::Utils::AllocateNoThrow(size, (size_t)alignment);
+}
+
+void operator delete(void *ptr) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete[](void *ptr) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete(void *ptr, size_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete[](void *ptr, size_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete(void *ptr, std::align_val_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete[](void *ptr, std::align_val_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete(void *ptr, size_t, std::align_val_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete[](void *ptr, size_t, std::align_val_t) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete(void *ptr, const std::nothrow_t &) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete[](void *ptr, const std::nothrow_t &) noexcept { Engine::MemoryTracker::Free(ptr); }
+void operator delete(void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    Engine::MemoryTracker::Free(ptr);
+}
+void operator delete[](void *ptr, std::align_val_t, const std::nothrow_t &) noexcept
+{
+    Engine::MemoryTracker::Free(ptr);
+}
+#endif
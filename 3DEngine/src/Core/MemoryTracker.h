@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// the global operator new/delete hook is compiled out of Dist builds
+#ifndef HZ_DIST
+#define ENGINE_TRACK_MEMORY 1
+#endif
+
+namespace Engine
+{
+enum class MemoryTag : uint8_t
+{
+    Untagged = 0,
+    Renderer,
+    Assets,
+    Physics,
+    Scripting,
+    Editor,
+    Count
+};
+
+// what the GL driver holds for us, estimated from the formats and sizes we asked for
+enum class GPUMemoryType : uint8_t
+{
+    Textures = 0,
+    Buffers,
+    Renderbuffers,
+    Count
+};
+
+// bytes
+struct MemoryStats
+{
+    size_t Current = 0;
+    size_t Peak = 0;
+    size_t Allocations = 0; // live
+    size_t Budget = 0;      // 0 when there is none
+};
+
+// Heap use by subsystem. Every operator new of the engine goes through here and is counted under the calling
+// thread's tag, see MemoryTagScope; allocators of libraries that take hooks, like Jolt's, pass their tag directly.
+class MemoryTracker
+{
+  public:
+    static void *Allocate(size_t size, size_t alignment, MemoryTag tag);
+    // any block of Allocate, whatever its alignment
+    static void Free(void *ptr);
+
+    static MemoryTag GetThreadTag();
+    static void SetThreadTag(MemoryTag tag);
+
+    static MemoryStats GetStats(MemoryTag tag);
+    static MemoryStats GetTotalStats();
+    static const char *GetTagName(MemoryTag tag);
+
+    static void TrackGPU(GPUMemoryType type, uint32_t id, size_t bytes);
+    // ids that were never tracked are ignored
+    static void UntrackGPU(GPUMemoryType type, uint32_t id);
+    static MemoryStats GetGPUStats(GPUMemoryType type);
+    static const char *GetGPUTypeName(GPUMemoryType type);
+
+    static void SetBudget(MemoryTag tag, size_t bytes);
+    static void SetGPUBudget(GPUMemoryType type, size_t bytes);
+
+    // current totals as profiler counters, main thread once a frame
+    static void ReportFrame();
+
+    // whether operator new is hooked, otherwise only the explicitly tagged allocations are counted
+    static constexpr bool IsHookingNew()
+    {
+#ifdef ENGINE_TRACK_MEMORY
+        return true;
+#else
+        return false;
+#endif
+    }
+};
+
+// tags what the current thread allocates until the scope ends
+class MemoryTagScope
+{
+  public:
+    explicit MemoryTagScope(MemoryTag tag) : m_Previous(MemoryTracker::GetThreadTag())
+    {
+        MemoryTracker::SetThreadTag(tag);
+    }
+    ~MemoryTagScope() { MemoryTracker::SetThreadTag(m_Previous); }
+
+    MemoryTagScope(const MemoryTagScope &) = delete;
+    MemoryTagScope &operator=(const MemoryTagScope &) = delete;
+
+  private:
+    MemoryTag m_Previous;
+};
+} // namespace Engine
+
+#define ENGINE_MEMORY_CONCAT_IMPL(a, b) a##b
+#define ENGINE_MEMORY_CONCAT(a, b) ENGINE_MEMORY_CONCAT_IMPL(a, b)
+#define MEMORY_TAG(tag)                                                                                                \
+    ::Engine::MemoryTagScope ENGINE_MEMORY_CONCAT(memoryTagScope, __LINE__)(::Engine::MemoryTag::tag)
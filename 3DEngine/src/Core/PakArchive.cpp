@@ -0,0 +1,263 @@
+#include "PakArchive.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+namespace Utils
+{
+// big files start on a page so their data can be mapped on its own, small ones stay packed
+constexpr uint64_t PakPageAlignment = 4096;
+constexpr uint64_t PakPageAlignedSize = 64 * 1024;
+constexpr uint64_t PakAlignment = 16;
+// smaller files aren't worth a decompression
+constexpr uint64_t PakMinCompressedSize = 256;
+
+static uint64_t AlignUp(uint64_t value, uint64_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+static void WritePadding(std::ofstream &stream, uint64_t &offset, uint64_t alignment)
+{
+    static const char zeros[PakPageAlignment] = {};
+    const uint64_t aligned = AlignUp(offset, alignment);
+    stream.write(zeros, (std::streamsize)(aligned - offset));
+    offset = aligned;
+}
+} // namespace Utils
+
+std::shared_ptr<PakArchive> PakArchive::Open(const std::filesystem::path &path)
+{
+    auto file = std::make_shared<FileMapping>(path);
+    if (!file->IsValid()) return nullptr;
+
+    PakHeader header;
+    if (file->GetSize() >= sizeof(header)) memcpy(&header, file->GetData(), sizeof(header));
+    if (file->GetSize() < sizeof(header) || header.Magic != PakMagic || header.Version != PakVersion)
+    {
+        LOG_CORE_ERROR("PakArchive::Open - Not a pak of version {}: {}", PakVersion, path.string());
+        return nullptr;
+    }
+
+    const uint64_t tocSize = (uint64_t)header.EntryCount * sizeof(PakEntry);
+    if (header.TocOffset % alignof(PakEntry) != 0 || header.TocOffset > file->GetSize() ||
+        file->GetSize() - header.TocOffset < tocSize + header.NamesSize)
+    {
+        LOG_CORE_ERROR("PakArchive::Open - Truncated table of contents: {}", path.string());
+        return nullptr;
+    }
+
+    auto pak = std::make_shared<PakArchive>();
+    pak->m_Path = path;
+    pak->m_Entries = (const PakEntry *)(file->GetData() + header.TocOffset);
+    pak->m_EntryCount = header.EntryCount;
+    pak->m_Names = (const char *)(file->GetData() + header.TocOffset + tocSize);
+
+    // checked once here, so lookups and reads can trust the table
+    for (uint32_t i = 0; i < pak->m_EntryCount; i++)
+    {
+        const PakEntry &entry = pak->m_Entries[i];
+        if ((uint64_t)entry.NameOffset + entry.NameLength > header.NamesSize || entry.Offset > header.TocOffset ||
+            entry.StoredSize > header.TocOffset - entry.Offset)
+        {
+            LOG_CORE_ERROR("PakArchive::Open - Corrupt entry {}: {}", i, path.string());
+            return nullptr;
+        }
+    }
+
+    pak->m_File = std::move(file);
+    return pak;
+}
+
+bool PakArchive::Build(const std::filesystem::path &directory, const std::filesystem::path &pakPath,
+                       CompressionType compression)
+{
+    if (!Compression::IsSupported(compression))
+    {
+        LOG_CORE_WARN("PakArchive::Build - {} isn't supported, storing files uncompressed",
+                      Compression::GetName(compression));
+        compression = CompressionType::None;
+    }
+
+    struct Source
+    {
+        std::filesystem::path Path;
+        std::string Name;
+        uint64_t Hash;
+    };
+    std::vector<Source> sources;
+
+    std::error_code error;
+    for (const auto &file : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        std::error_code ignored;
+        if (!file.is_regular_file() || std::filesystem::equivalent(file.path(), pakPath, ignored)) continue;
+
+        std::string name = file.path().lexically_relative(directory).generic_string();
+        if (name.size() > UINT16_MAX) continue;
+        const uint64_t hash = HashPath(name);
+        sources.push_back({file.path(), std::move(name), hash});
+    }
+    if (error)
+    {
+        LOG_CORE_ERROR("PakArchive::Build - Could not list {}: {}", directory.string(), error.message());
+        return false;
+    }
+
+    std::sort(sources.begin(), sources.end(), [](const Source &a, const Source &b) {
+        return a.Hash != b.Hash ? a.Hash < b.Hash : a.Name < b.Name;
+    });
+
+    // written next to the pak and moved over it at the end, so a failed build keeps the old one
+    const std::filesystem::path tempPath = pakPath.string() + ".tmp";
+    std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+    if (!stream)
+    {
+        LOG_CORE_ERROR("PakArchive::Build - Could not write {}", tempPath.string());
+        return false;
+    }
+
+    PakHeader header;
+    stream.write((const char *)&header, sizeof(header));
+    uint64_t offset = sizeof(header);
+
+    std::vector<PakEntry> entries;
+    std::string names;
+    entries.reserve(sources.size());
+    uint64_t totalSize = 0;
+
+    for (const Source &source : sources)
+    {
+        FileMapping file(source.Path);
+        if (!file)
+        {
+            LOG_CORE_WARN("PakArchive::Build - Skipping unreadable file {}", source.Path.string());
+            continue;
+        }
+
+        PakEntry entry;
+        entry.PathHash = source.Hash;
+        entry.Size = file.GetSize();
+        entry.NameOffset = (uint32_t)names.size();
+        entry.NameLength = (uint16_t)source.Name.size();
+        names += source.Name;
+
+        const uint8_t *data = file.GetData();
+        entry.StoredSize = file.GetSize();
+
+        ScopedBuffer compressed;
+        if (compression != CompressionType::None && file.GetSize() >= Utils::PakMinCompressedSize)
+        {
+            compressed = ScopedBuffer(Compression::GetMaxCompressedSize(compression, file.GetSize()));
+            const uint64_t size = Compression::Compress(compression, file.GetData(), file.GetSize(),
+                                                        compressed.Data(), compressed.Size());
+            if (size != 0 && size <= file.GetSize() - file.GetSize() / 8)
+            {
+                data = compressed.Data();
+                entry.StoredSize = size;
+                entry.Compression = compression;
+            }
+        }
+
+        const bool pageAligned = entry.StoredSize >= Utils::PakPageAlignedSize;
+        Utils::WritePadding(stream, offset, pageAligned ? Utils::PakPageAlignment : Utils::PakAlignment);
+        entry.Offset = offset;
+        stream.write((const char *)data, (std::streamsize)entry.StoredSize);
+        offset += entry.StoredSize;
+        totalSize += entry.Size;
+
+        entries.push_back(entry);
+    }
+
+    Utils::WritePadding(stream, offset, Utils::PakAlignment);
+    header.EntryCount = (uint32_t)entries.size();
+    header.TocOffset = offset;
+    header.NamesSize = names.size();
+    stream.write((const char *)entries.data(), (std::streamsize)(entries.size() * sizeof(PakEntry)));
+    stream.write(names.data(), (std::streamsize)names.size());
+    offset += entries.size() * sizeof(PakEntry) + names.size();
+
+    stream.seekp(0);
+    stream.write((const char *)&header, sizeof(header));
+    stream.close();
+    if (!stream)
+    {
+        LOG_CORE_ERROR("PakArchive::Build - Failed writing {}", tempPath.string());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    std::filesystem::rename(tempPath, pakPath, error);
+    if (error)
+    {
+        LOG_CORE_ERROR("PakArchive::Build - Could not replace {}: {}", pakPath.string(), error.message());
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+
+    LOG_CORE_INFO("Packed {} files, {:.1f} MB into {:.1f} MB: {}", entries.size(), totalSize / (1024.0 * 1024.0),
+                  offset / (1024.0 * 1024.0), pakPath.string());
+    return true;
+}
+
+uint64_t PakArchive::HashPath(std::string_view path)
+{
+    // 64-bit FNV-1a
+    uint64_t hash = 14695981039346656037ull;
+    for (char c : path)
+    {
+        hash ^= (uint8_t)c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+const PakEntry *PakArchive::FindEntry(std::string_view path) const
+{
+    const uint64_t hash = HashPath(path);
+    const PakEntry *end = m_Entries + m_EntryCount;
+    const PakEntry *entry =
+        std::lower_bound(m_Entries, end, hash, [](const PakEntry &e, uint64_t value) { return e.PathHash < value; });
+
+    // collisions sit next to each other
+    for (; entry != end && entry->PathHash == hash; entry++)
+    {
+        if (GetEntryPath(*entry) == path) return entry;
+    }
+    return nullptr;
+}
+
+FileMapping PakArchive::Read(std::string_view path) const
+{
+    const PakEntry *entry = FindEntry(path);
+    return entry ? Read(*entry) : FileMapping();
+}
+
+FileMapping PakArchive::Read(const PakEntry &entry) const
+{
+    if (entry.Compression == CompressionType::None)
+    {
+        if (entry.StoredSize != entry.Size) return FileMapping();
+        return FileMapping::FromView(m_File, entry.Offset, entry.Size);
+    }
+
+    ScopedBuffer data(entry.Size);
+    if ((entry.Size > 0 && !data) ||
+        !Compression::Decompress(entry.Compression, m_File->GetData() + entry.Offset, entry.StoredSize, data.Data(),
+                                 entry.Size))
+    {
+        LOG_CORE_ERROR("PakArchive::Read - Could not decompress {} from {}", GetEntryPath(entry), m_Path.string());
+        return FileMapping();
+    }
+    return FileMapping::FromBuffer(std::move(data));
+}
+
+std::string_view PakArchive::GetEntryPath(const PakEntry &entry) const
+{
+    return std::string_view(m_Names + entry.NameOffset, entry.NameLength);
+}
+} // namespace Engine
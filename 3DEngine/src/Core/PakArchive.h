@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Compression.h"
+#include "FileMapping.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace Engine
+{
+// Layout on disk, little endian: the header, the files' data, then the table of contents, which is the entries
+// sorted by path hash followed by all paths in one blob. Paths are relative to the pak's root with forward slashes.
+// Data of big files starts on a page boundary, so an uncompressed one maps like a loose file.
+constexpr uint32_t PakMagic = 0x4B415033; // "3PAK"
+constexpr uint32_t PakVersion = 1;
+
+struct PakHeader
+{
+    uint32_t Magic = PakMagic;
+    uint32_t Version = PakVersion;
+    uint32_t EntryCount = 0;
+    uint32_t Reserved = 0;
+    uint64_t TocOffset = 0;
+    uint64_t NamesSize = 0;
+};
+
+struct PakEntry
+{
+    uint64_t PathHash = 0;
+    uint64_t Offset = 0;
+    uint64_t StoredSize = 0; // in the pak, compressed or not
+    uint64_t Size = 0;       // of the file
+    uint32_t NameOffset = 0; // into the paths
+    uint16_t NameLength = 0;
+    CompressionType Compression = CompressionType::None;
+    uint8_t Reserved = 0;
+};
+static_assert(sizeof(PakHeader) == 32 && sizeof(PakEntry) == 40, "the pak layout is part of the format");
+
+// A pak file, mapped once and read from by any thread. Uncompressed files are views into its pages and compressed
+// ones are decompressed into memory of their own; either way they keep the pak mapped while they exist.
+class PakArchive
+{
+  public:
+    // nullptr when the file is missing, isn't a pak or is of another version
+    static std::shared_ptr<PakArchive> Open(const std::filesystem::path &path);
+
+    // Packs every file below directory; files only compress when that saves at least an eighth of their size.
+    // Unmount a pak before rebuilding it, a mapped file can't be replaced on Windows.
+    static bool Build(const std::filesystem::path &directory, const std::filesystem::path &pakPath,
+                      CompressionType compression = CompressionType::LZ4);
+
+    static uint64_t HashPath(std::string_view path);
+
+    // nullptr when it isn't in the pak
+    const PakEntry *FindEntry(std::string_view path) const;
+    bool Contains(std::string_view path) const { return FindEntry(path) != nullptr; }
+    // invalid when it isn't in the pak or doesn't decompress
+    FileMapping Read(std::string_view path) const;
+    FileMapping Read(const PakEntry &entry) const;
+
+    std::string_view GetEntryPath(const PakEntry &entry) const;
+    uint32_t GetEntryCount() const { return m_EntryCount; }
+    const PakEntry *GetEntries() const { return m_Entries; }
+    const std::filesystem::path &GetPath() const { return m_Path; }
+
+  private:
+    std::filesystem::path m_Path;
+    std::shared_ptr<const FileMapping> m_File;
+    // into m_File
+    const PakEntry *m_Entries = nullptr;
+    uint32_t m_EntryCount = 0;
+    const char *m_Names = nullptr;
+};
+} // namespace Engine
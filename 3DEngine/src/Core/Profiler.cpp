@@ -0,0 +1,277 @@
+#include "Profiler.h"
+
+#include "Log.h"
+#include "RenderCommand.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+
+namespace Engine
+{
+namespace Utils
+{
+// each thread appends to its own buffer, the lock is only contended while EndFrame drains it
+struct ProfileThreadBuffer
+{
+    std::mutex Mutex;
+    std::vector<ProfileEvent> Events;
+};
+
+static const auto s_ProfilerEpoch = std::chrono::steady_clock::now();
+
+static std::mutex s_ThreadsMutex;
+static std::vector<std::shared_ptr<ProfileThreadBuffer>> s_ThreadBuffers;
+static std::map<uint32_t, std::string> s_ThreadNames;
+static std::atomic<uint32_t> s_NextThreadId = 1;
+
+static std::mutex s_FrameDataMutex;
+static std::vector<ProfileEvent> s_GPUEvents;
+static std::vector<ProfileCounter> s_Counters;
+static std::vector<ProfileScheduleEntry> s_Schedule;
+
+static std::mutex s_NamesMutex;
+static std::unordered_set<std::string> s_Names;
+
+static thread_local ProfileThreadBuffer *t_ThreadBuffer = nullptr;
+static thread_local uint32_t t_ThreadId = 0;
+static thread_local uint32_t t_Depth = 0;
+
+static ProfileThreadBuffer &GetThreadBuffer()
+{
+    if (t_ThreadBuffer) return *t_ThreadBuffer;
+
+    // owned by the list so events of a thread that already exited can still be drained
+    auto buffer = std::make_shared<ProfileThreadBuffer>();
+    std::scoped_lock<std::mutex> lock(s_ThreadsMutex);
+    s_ThreadBuffers.push_back(buffer);
+    t_ThreadBuffer = buffer.get();
+    return *t_ThreadBuffer;
+}
+
+static std::string EscapeJSON(const char *text)
+{
+    std::string result;
+    for (const char *c = text; *c; c++)
+    {
+        if (*c == '"' || *c == '\\') result += '\\';
+        if ((unsigned char)*c < 0x20) continue;
+        result += *c;
+    }
+    return result;
+}
+} // namespace Utils
+
+double Profiler::Now()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - Utils::s_ProfilerEpoch)
+        .count();
+}
+
+uint32_t Profiler::GetThreadId()
+{
+    if (Utils::t_ThreadId == 0) Utils::t_ThreadId = Utils::s_NextThreadId++;
+    return Utils::t_ThreadId;
+}
+
+void Profiler::SetThreadName(const std::string &name)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_ThreadsMutex);
+    Utils::s_ThreadNames[GetThreadId()] = name;
+}
+
+std::string Profiler::GetThreadName(uint32_t threadId)
+{
+    if (threadId == GPUThreadId) return "GPU";
+
+    std::scoped_lock<std::mutex> lock(Utils::s_ThreadsMutex);
+    auto it = Utils::s_ThreadNames.find(threadId);
+    return it != Utils::s_ThreadNames.end() ? it->second : "Thread " + std::to_string(threadId);
+}
+
+const char *Profiler::InternName(const std::string &name)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_NamesMutex);
+    return Utils::s_Names.insert(name).first->c_str();
+}
+
+void Profiler::BeginFrame() { s_FrameStart = Now(); }
+
+void Profiler::EndFrame()
+{
+    // the render thread may be filling the live counters right now
+    const RenderStats stats = RenderCommand::GetFrameStats();
+    SetCounter("Draw Calls", stats.DrawCalls);
+    SetCounter("Triangles", stats.Triangles);
+    SetCounter("State Changes", stats.StateChanges);
+    SetCounter("Uploads", stats.Uploads);
+    SetCounter("Upload KB", stats.UploadBytes / 1024.0);
+
+    ProfileFrame frame;
+    frame.Index = s_FrameIndex++;
+    frame.Start = s_FrameStart;
+    frame.Duration = Now() - s_FrameStart;
+
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_ThreadsMutex);
+        for (auto &buffer : Utils::s_ThreadBuffers)
+        {
+            std::scoped_lock<std::mutex> bufferLock(buffer->Mutex);
+            frame.Events.insert(frame.Events.end(), buffer->Events.begin(), buffer->Events.end());
+            buffer->Events.clear();
+        }
+    }
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_FrameDataMutex);
+        frame.GPUEvents.swap(Utils::s_GPUEvents);
+        frame.Counters.swap(Utils::s_Counters);
+        frame.Schedule.swap(Utils::s_Schedule);
+    }
+
+    // parents start no later than their children, depth breaks the tie
+    std::sort(frame.Events.begin(), frame.Events.end(), [](const ProfileEvent &a, const ProfileEvent &b)
+              { return a.Start != b.Start ? a.Start < b.Start : a.Depth < b.Depth; });
+    std::sort(frame.Schedule.begin(), frame.Schedule.end(),
+              [](const ProfileScheduleEntry &a, const ProfileScheduleEntry &b) { return a.Start < b.Start; });
+
+    s_FrameTimeHistory[s_HistoryOffset] = frame.Duration / 1000.0;
+    s_HistoryOffset = (s_HistoryOffset + 1) % HistorySize;
+
+    if (s_Capturing)
+    {
+        s_CapturedFrames.push_back(frame);
+        if (s_CapturedFrames.size() >= MaxCaptureFrames)
+        {
+            LOG_CORE_WARN("Profiler: capture stopped after {} frames", MaxCaptureFrames);
+            EndCapture();
+        }
+    }
+
+    if (!s_Paused) s_LastFrame = std::move(frame);
+}
+
+void Profiler::RecordEvent(const char *name, double start, double duration, uint32_t depth)
+{
+    auto &buffer = Utils::GetThreadBuffer();
+    std::scoped_lock<std::mutex> lock(buffer.Mutex);
+    buffer.Events.push_back({name, start, duration, GetThreadId(), depth});
+}
+
+void Profiler::RecordGPU(const char *name, double cpuStart, float milliseconds)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_FrameDataMutex);
+    Utils::s_GPUEvents.push_back({name, cpuStart, milliseconds * 1000.0, GPUThreadId, 0});
+}
+
+void Profiler::SetCounter(const char *name, double value)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_FrameDataMutex);
+    for (auto &counter : Utils::s_Counters)
+    {
+        if (counter.Name != name) continue;
+        counter.Value = value;
+        return;
+    }
+    Utils::s_Counters.push_back({name, value});
+}
+
+void Profiler::RecordSchedule(std::vector<ProfileScheduleEntry> entries)
+{
+    std::scoped_lock<std::mutex> lock(Utils::s_FrameDataMutex);
+    Utils::s_Schedule.insert(Utils::s_Schedule.end(), std::make_move_iterator(entries.begin()),
+                             std::make_move_iterator(entries.end()));
+}
+
+void Profiler::BeginCapture()
+{
+    s_CapturedFrames.clear();
+    s_Capturing = true;
+}
+
+void Profiler::EndCapture() { s_Capturing = false; }
+
+bool Profiler::WriteChromeTrace(const std::filesystem::path &path)
+{
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+
+    std::ofstream stream(path);
+    if (!stream)
+    {
+        LOG_CORE_ERROR("Profiler: could not write '{}'", path.string());
+        return false;
+    }
+
+    stream << std::fixed << std::setprecision(3);
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    auto separator = [&]() -> std::ostream &
+    {
+        if (!first) stream << ",\n";
+        first = false;
+        return stream;
+    };
+
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_ThreadsMutex);
+        for (const auto &[id, name] : Utils::s_ThreadNames)
+            separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << id
+                        << ",\"args\":{\"name\":\"" << Utils::EscapeJSON(name.c_str()) << "\"}}";
+    }
+    separator() << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GPUThreadId
+                << ",\"args\":{\"name\":\"GPU\"}}";
+
+    for (const auto &frame : s_CapturedFrames)
+    {
+        for (const auto *events : {&frame.Events, &frame.GPUEvents})
+        {
+            for (const auto &event : *events)
+                separator() << "{\"name\":\"" << Utils::EscapeJSON(event.Name) << "\",\"cat\":\""
+                            << (event.ThreadId == GPUThreadId ? "GPU" : "CPU") << "\",\"ph\":\"X\",\"ts\":"
+                            << event.Start << ",\"dur\":" << event.Duration << ",\"pid\":1,\"tid\":" << event.ThreadId
+                            << "}";
+        }
+
+        for (const auto &counter : frame.Counters)
+            separator() << "{\"name\":\"" << Utils::EscapeJSON(counter.Name) << "\",\"ph\":\"C\",\"ts\":"
+                        << frame.Start << ",\"pid\":1,\"args\":{\"value\":" << counter.Value << "}}";
+    }
+
+    stream << "\n]}\n";
+    LOG_CORE_INFO("Profiler: wrote {} frames to '{}'", s_CapturedFrames.size(), path.string());
+    return true;
+}
+
+GPUTimer &Profiler::GetGPUTimer(const char *name)
+{
+    // leaked on purpose, the GL context is gone by the time statics are destroyed
+    static auto *timers = new std::map<std::string, GPUTimer>();
+    return timers->try_emplace(name).first->second;
+}
+
+ProfileScope::ProfileScope(const char *name) : m_Name(name), m_Start(Profiler::Now()), m_Depth(Utils::t_Depth++) {}
+
+ProfileScope::~ProfileScope()
+{
+    Utils::t_Depth--;
+    Profiler::RecordEvent(m_Name, m_Start, Profiler::Now() - m_Start, m_Depth);
+}
+
+GPUProfileScope::GPUProfileScope(const char *name)
+    : m_Name(name), m_Start(Profiler::Now()), m_Timer(Profiler::GetGPUTimer(name))
+{
+    m_Timer.Begin();
+}
+
+GPUProfileScope::~GPUProfileScope()
+{
+    m_Timer.End();
+    Profiler::RecordGPU(m_Name, m_Start, m_Timer.GetTime());
+}
+} // namespace Engine
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "GPUTimer.h"
+
+// profiling scopes are compiled out of Dist builds
+#ifndef HZ_DIST
+#define ENGINE_PROFILE 1
+#endif
+
+namespace Engine
+{
+struct ProfileEvent
+{
+    const char *Name; // string literal or Profiler::InternName
+    double Start;     // microseconds since the profiler epoch
+    double Duration;  // microseconds
+    uint32_t ThreadId;
+    uint32_t Depth; // nesting on its thread
+};
+
+struct ProfileCounter
+{
+    const char *Name;
+    double Value;
+};
+
+// a system the SystemScheduler ran, with the systems it had to wait for
+struct ProfileScheduleEntry
+{
+    const char *Name;
+    const char *Phase;
+    double Start;    // microseconds since the profiler epoch
+    double Duration; // microseconds
+    uint32_t ThreadId;
+    std::vector<const char *> DependsOn;
+};
+
+struct ProfileFrame
+{
+    uint64_t Index = 0;
+    double Start = 0.0;
+    double Duration = 0.0;
+    std::vector<ProfileEvent> Events;    // every thread, sorted by start
+    std::vector<ProfileEvent> GPUEvents; // durations are from a query a few frames old
+    std::vector<ProfileCounter> Counters;
+    std::vector<ProfileScheduleEntry> Schedule; // by start
+};
+
+// Collects CPU scopes from any thread, GPU pass timings and per-frame counters. The last finished frame is kept
+// for the editor panel; while a capture runs every frame is also kept so it can be written out as a Chrome
+// trace_event JSON file (chrome://tracing, Perfetto).
+class Profiler
+{
+  public:
+    static constexpr uint32_t HistorySize = 240;
+    static constexpr uint32_t MaxCaptureFrames = 3600;
+    // the pseudo thread GPU events are shown on
+    static constexpr uint32_t GPUThreadId = 0xFFFF;
+
+    static void BeginFrame();
+    static void EndFrame();
+
+    static double Now();
+    static uint32_t GetThreadId();
+    static void SetThreadName(const std::string &name);
+    static std::string GetThreadName(uint32_t threadId);
+
+    // a pointer that stays valid for the rest of the program, for names that aren't literals
+    static const char *InternName(const std::string &name);
+
+    static void RecordEvent(const char *name, double start, double duration, uint32_t depth);
+    // GPU time in milliseconds of work issued at cpuStart, drawn on the GPU track at that time
+    static void RecordGPU(const char *name, double cpuStart, float milliseconds);
+    static void SetCounter(const char *name, double value);
+    static void RecordSchedule(std::vector<ProfileScheduleEntry> entries);
+
+    static void BeginCapture();
+    static void EndCapture();
+    static bool IsCapturing() { return s_Capturing; }
+    static size_t GetCapturedFrameCount() { return s_CapturedFrames.size(); }
+    static bool WriteChromeTrace(const std::filesystem::path &path);
+
+    static bool IsPaused() { return s_Paused; }
+    static void SetPaused(bool paused) { s_Paused = paused; }
+
+    static const ProfileFrame &GetLastFrame() { return s_LastFrame; }
+    // CPU frame times in milliseconds, oldest at GetHistoryOffset()
+    static const std::array<float, HistorySize> &GetFrameTimeHistory() { return s_FrameTimeHistory; }
+    static uint32_t GetHistoryOffset() { return s_HistoryOffset; }
+
+  private:
+    friend class GPUProfileScope;
+    static GPUTimer &GetGPUTimer(const char *name);
+
+  private:
+    inline static uint64_t s_FrameIndex = 0;
+    inline static double s_FrameStart = 0.0;
+    inline static ProfileFrame s_LastFrame;
+
+    inline static bool s_Paused = false;
+    inline static bool s_Capturing = false;
+    inline static std::vector<ProfileFrame> s_CapturedFrames;
+
+    inline static std::array<float, HistorySize> s_FrameTimeHistory{};
+    inline static uint32_t s_HistoryOffset = 0;
+};
+
+class ProfileScope
+{
+  public:
+    ProfileScope(const char *name);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+    const char *m_Name;
+    double m_Start;
+    uint32_t m_Depth;
+};
+
+// Times GPU work with a timer query per name. GL timer queries don't nest, so these must not overlap each other or
+// a RenderGraph pass, which is timed the same way.
+class GPUProfileScope
+{
+  public:
+    GPUProfileScope(const char *name);
+    ~GPUProfileScope();
+
+    GPUProfileScope(const GPUProfileScope &) = delete;
+    GPUProfileScope &operator=(const GPUProfileScope &) = delete;
+
+  private:
+    const char *m_Name;
+    double m_Start;
+    GPUTimer &m_Timer;
+};
+} // namespace Engine
+
+#define ENGINE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef ENGINE_PROFILE
+#define PROFILE_SCOPE(name) ::Engine::ProfileScope ENGINE_PROFILE_CONCAT(profileScope, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__FUNCTION__)
+#define PROFILE_GPU_SCOPE(name) ::Engine::GPUProfileScope ENGINE_PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+#define PROFILE_COUNTER(name, value) ::Engine::Profiler::SetCounter(name, value)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_GPU_SCOPE(name)
+#define PROFILE_COUNTER(name, value)
+#endif
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Engine
+{
+// A move-only void() callable. Captures of up to InlineSize bytes live inside the task, so queueing the usual small
+// lambda doesn't allocate; bigger ones go to the heap.
+class Task
+{
+  public:
+    static constexpr size_t InlineSize = 48;
+
+    Task() = default;
+
+    template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>>> Task(F &&func)
+    {
+        using Func = std::decay_t<F>;
+        if constexpr (sizeof(Func) <= InlineSize && alignof(Func) <= alignof(std::max_align_t) &&
+                      std::is_nothrow_move_constructible_v<Func>)
+        {
+            new (m_Storage) Func(std::forward<F>(func));
+            m_Ops = &s_InlineOps<Func>;
+        }
+        else
+        {
+            new (m_Storage) Func *(new Func(std::forward<F>(func)));
+            m_Ops = &s_HeapOps<Func>;
+        }
+    }
+
+    Task(Task &&other) noexcept { MoveFrom(other); }
+    Task &operator=(Task &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Reset();
+            MoveFrom(other);
+        }
+        return *this;
+    }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+    ~Task() { Reset(); }
+
+    explicit operator bool() const { return m_Ops != nullptr; }
+    void operator()() { m_Ops->Invoke(m_Storage); }
+
+  private:
+    struct Ops
+    {
+        void (*Invoke)(void *storage);
+        // leaves src destroyed
+        void (*Move)(void *dst, void *src);
+        void (*Destroy)(void *storage);
+    };
+
+    template <typename Func>
+    static constexpr Ops s_InlineOps = {
+        [](void *storage) { (*static_cast<Func *>(storage))(); },
+        [](void *dst, void *src)
+        {
+            new (dst) Func(std::move(*static_cast<Func *>(src)));
+            static_cast<Func *>(src)->~Func();
+        },
+        [](void *storage) { static_cast<Func *>(storage)->~Func(); }};
+
+    template <typename Func>
+    static constexpr Ops s_HeapOps = {[](void *storage) { (**static_cast<Func **>(storage))(); },
+                                      [](void *dst, void *src) { *static_cast<Func **>(dst) = *static_cast<Func **>(src); },
+                                      [](void *storage) { delete *static_cast<Func **>(storage); }};
+
+    void MoveFrom(Task &other)
+    {
+        m_Ops = other.m_Ops;
+        if (m_Ops) m_Ops->Move(m_Storage, other.m_Storage);
+        other.m_Ops = nullptr;
+    }
+
+    void Reset()
+    {
+        if (m_Ops) m_Ops->Destroy(m_Storage);
+        m_Ops = nullptr;
+    }
+
+  private:
+    alignas(std::max_align_t) unsigned char m_Storage[InlineSize];
+    const Ops *m_Ops = nullptr;
+};
+} // namespace Engine
@@ -0,0 +1,245 @@
+#include "VirtualFileSystem.h"
+
+#include "Log.h"
+#include "MemoryTracker.h"
+#include "PakArchive.h"
+#include "Profiler.h"
+
+#include <algorithm>
+#include <deque>
+#include <shared_mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+namespace Utils
+{
+struct MountEntry
+{
+    std::string Point;
+    // one or the other
+    std::filesystem::path Directory;
+    std::shared_ptr<PakArchive> Pak;
+};
+
+struct QueuedRead
+{
+    AsyncFileReadRef Read;
+    AsyncFileReadCallback OnDone;
+};
+
+// in mount order, lookups go from the back
+static std::vector<MountEntry> s_Mounts;
+static std::shared_mutex s_MountMutex;
+
+static std::vector<std::thread> s_IOThreads;
+static std::deque<QueuedRead> s_Reads;
+static std::mutex s_ReadMutex;
+static std::condition_variable s_ReadQueued;
+static bool s_Running = false;
+
+// false for a path on disk, otherwise its mount point and the path below it
+static bool SplitVirtualPath(const std::filesystem::path &path, std::string &mountPoint, std::string &relative)
+{
+    if (path.empty() || path.has_root_path()) return false;
+
+    const std::string normal = path.lexically_normal().generic_string();
+    const size_t slash = normal.find('/');
+    mountPoint = normal.substr(0, slash);
+    relative = slash == std::string::npos ? std::string() : normal.substr(slash + 1);
+    return true;
+}
+
+// what is mounted at the path's mount point, latest first; false when the path isn't virtual
+static bool FindMounts(const std::filesystem::path &path, std::vector<MountEntry> &mounts, std::string &relative)
+{
+    std::string mountPoint;
+    if (!SplitVirtualPath(path, mountPoint, relative)) return false;
+
+    std::shared_lock<std::shared_mutex> lock(s_MountMutex);
+    for (auto it = s_Mounts.rbegin(); it != s_Mounts.rend(); it++)
+    {
+        if (it->Point == mountPoint) mounts.push_back(*it);
+    }
+    return !mounts.empty();
+}
+
+static bool IsInsideMount(std::string_view relative)
+{
+    return !relative.empty() && relative != ".." && relative.substr(0, 3) != "../";
+}
+
+// touches every page of a mapped file, so the loader that gets it doesn't stall on page faults
+static void Prefault(const FileMapping &file)
+{
+    if (!file.IsMapped()) return;
+
+    constexpr uint64_t PageSize = 4096;
+    volatile uint8_t sink = 0;
+    for (uint64_t offset = 0; offset < file.GetSize(); offset += PageSize) sink = sink + file.GetData()[offset];
+}
+} // namespace Utils
+
+void AsyncFileRead::Wait()
+{
+    if (IsDone()) return;
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Finished.wait(lock, [this] { return IsDone(); });
+}
+
+void VirtualFileSystem::Init(uint32_t threadCount)
+{
+    if (Utils::s_Running) return;
+
+    Utils::s_Running = true;
+    for (uint32_t i = 0; i < std::max(threadCount, 1u); i++) Utils::s_IOThreads.emplace_back(IOThreadMain, i);
+
+    LOG_CORE_INFO("VirtualFileSystem: {} IO threads", Utils::s_IOThreads.size());
+}
+
+void VirtualFileSystem::Shutdown()
+{
+    if (!Utils::s_Running) return;
+
+    // the threads finish what is queued, nobody waits forever
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_ReadMutex);
+        Utils::s_Running = false;
+    }
+    Utils::s_ReadQueued.notify_all();
+
+    for (auto &thread : Utils::s_IOThreads) thread.join();
+    Utils::s_IOThreads.clear();
+    UnmountAll();
+}
+
+void VirtualFileSystem::Mount(const std::string &mountPoint, const std::filesystem::path &directory)
+{
+    std::scoped_lock<std::shared_mutex> lock(Utils::s_MountMutex);
+    Utils::s_Mounts.push_back({mountPoint, directory, nullptr});
+    LOG_CORE_INFO("Mounted {} at {}", directory.string(), mountPoint);
+}
+
+bool VirtualFileSystem::MountPak(const std::string &mountPoint, const std::filesystem::path &pakPath)
+{
+    std::shared_ptr<PakArchive> pak = PakArchive::Open(pakPath);
+    if (!pak) return false;
+
+    std::scoped_lock<std::shared_mutex> lock(Utils::s_MountMutex);
+    Utils::s_Mounts.push_back({mountPoint, std::filesystem::path(), pak});
+    LOG_CORE_INFO("Mounted {} ({} files) at {}", pakPath.string(), pak->GetEntryCount(), mountPoint);
+    return true;
+}
+
+void VirtualFileSystem::Unmount(const std::string &mountPoint)
+{
+    // files read from a pak keep it mapped until they are gone
+    std::scoped_lock<std::shared_mutex> lock(Utils::s_MountMutex);
+    std::erase_if(Utils::s_Mounts, [&](const Utils::MountEntry &mount) { return mount.Point == mountPoint; });
+}
+
+void VirtualFileSystem::UnmountAll()
+{
+    std::scoped_lock<std::shared_mutex> lock(Utils::s_MountMutex);
+    Utils::s_Mounts.clear();
+}
+
+bool VirtualFileSystem::Exists(const std::filesystem::path &path)
+{
+    std::vector<Utils::MountEntry> mounts;
+    std::string relative;
+    std::error_code error;
+    if (!Utils::FindMounts(path, mounts, relative)) return std::filesystem::is_regular_file(path, error);
+    if (!Utils::IsInsideMount(relative)) return false;
+
+    for (const auto &mount : mounts)
+    {
+        if (mount.Pak ? mount.Pak->Contains(relative)
+                      : std::filesystem::is_regular_file(mount.Directory / relative, error))
+            return true;
+    }
+    return false;
+}
+
+FileMapping VirtualFileSystem::Open(const std::filesystem::path &path)
+{
+    std::vector<Utils::MountEntry> mounts;
+    std::string relative;
+    if (!Utils::FindMounts(path, mounts, relative)) return FileMapping(path);
+    if (!Utils::IsInsideMount(relative)) return FileMapping();
+
+    for (const auto &mount : mounts)
+    {
+        if (mount.Pak)
+        {
+            if (const PakEntry *entry = mount.Pak->FindEntry(relative)) return mount.Pak->Read(*entry);
+        }
+        else if (FileMapping file(mount.Directory / relative); file)
+        {
+            return file;
+        }
+    }
+    return FileMapping();
+}
+
+AsyncFileReadRef VirtualFileSystem::ReadAsync(const std::filesystem::path &path, AsyncFileReadCallback onDone)
+{
+    auto read = std::make_shared<AsyncFileRead>();
+    read->m_Path = path;
+
+    {
+        std::unique_lock<std::mutex> lock(Utils::s_ReadMutex);
+        if (Utils::s_Running)
+        {
+            Utils::s_Reads.push_back({read, std::move(onDone)});
+            lock.unlock();
+            Utils::s_ReadQueued.notify_one();
+            return read;
+        }
+    }
+
+    read->m_File = Open(path);
+    Finish(*read, onDone);
+    return read;
+}
+
+void VirtualFileSystem::Finish(AsyncFileRead &read, const AsyncFileReadCallback &onDone)
+{
+    if (!read.m_File) LOG_CORE_ERROR("VirtualFileSystem::ReadAsync - Could not read {}", read.m_Path.string());
+    if (onDone) onDone(read);
+
+    {
+        std::scoped_lock<std::mutex> lock(read.m_Mutex);
+        read.m_Done.store(true, std::memory_order_release);
+    }
+    read.m_Finished.notify_all();
+}
+
+void VirtualFileSystem::IOThreadMain(uint32_t index)
+{
+    Profiler::SetThreadName("IO " + std::to_string(index));
+    MemoryTracker::SetThreadTag(MemoryTag::Assets);
+
+    while (true)
+    {
+        Utils::QueuedRead queued;
+        {
+            std::unique_lock<std::mutex> lock(Utils::s_ReadMutex);
+            Utils::s_ReadQueued.wait(lock, [] { return !Utils::s_Running || !Utils::s_Reads.empty(); });
+            if (Utils::s_Reads.empty()) return;
+
+            queued = std::move(Utils::s_Reads.front());
+            Utils::s_Reads.pop_front();
+        }
+
+        PROFILE_SCOPE("ReadAsync");
+        AsyncFileRead &read = *queued.Read;
+        read.m_File = Open(read.m_Path);
+        Utils::Prefault(read.m_File);
+        Finish(read, queued.OnDone);
+    }
+}
+} // namespace Engine
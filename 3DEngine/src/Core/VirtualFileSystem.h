@@ -0,0 +1,73 @@
+#pragma once
+
+#include "FileMapping.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Engine
+{
+class PakArchive;
+
+// A read started by VirtualFileSystem::ReadAsync
+class AsyncFileRead
+{
+  public:
+    bool IsDone() const { return m_Done.load(std::memory_order_acquire); }
+    void Wait();
+
+    // once done; invalid when the file could not be read
+    FileMapping &GetFile() { return m_File; }
+    const std::filesystem::path &GetPath() const { return m_Path; }
+
+  private:
+    friend class VirtualFileSystem;
+    std::filesystem::path m_Path;
+    FileMapping m_File;
+    std::atomic<bool> m_Done = false;
+    std::mutex m_Mutex;
+    std::condition_variable m_Finished;
+};
+
+using AsyncFileReadRef = std::shared_ptr<AsyncFileRead>;
+using AsyncFileReadCallback = std::function<void(AsyncFileRead &)>;
+
+// Loose directories and pak archives mounted under names. A path whose first component is a mount point, like
+// "Assets/Textures/wood.png", is looked up in everything mounted there, the latest mount first, so loose files
+// override a pak mounted before them; any other path is a file on disk as before. Virtual paths are relative and
+// use forward slashes, they can't leave their mount with "..".
+//
+// Mounting happens on the main thread between loads; reads may come from any thread.
+class VirtualFileSystem
+{
+  public:
+    // starts the IO threads, without them ReadAsync reads right away
+    static void Init(uint32_t threadCount = 2);
+    static void Shutdown();
+
+    static void Mount(const std::string &mountPoint, const std::filesystem::path &directory);
+    // false when the pak can't be opened
+    static bool MountPak(const std::string &mountPoint, const std::filesystem::path &pakPath);
+    // everything mounted there
+    static void Unmount(const std::string &mountPoint);
+    static void UnmountAll();
+
+    static bool Exists(const std::filesystem::path &path);
+    // invalid when it doesn't exist
+    static FileMapping Open(const std::filesystem::path &path);
+
+    // Opens, decompresses and pages in the file on an IO thread. onDone runs there as well once the file is ready,
+    // GL uploads go through Application::SubmitToMainThread.
+    static AsyncFileReadRef ReadAsync(const std::filesystem::path &path, AsyncFileReadCallback onDone = {});
+
+  private:
+    static void IOThreadMain(uint32_t index);
+    static void Finish(AsyncFileRead &read, const AsyncFileReadCallback &onDone);
+};
+} // namespace Engine
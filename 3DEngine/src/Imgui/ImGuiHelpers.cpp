@@ -28,8 +28,10 @@ const char* _labelPrefix(const char *const label, const char *field)
 	return labelIDChar;
 }
 
-void _drawVec3Control(const std::string &label, glm::vec3 &values, float resetValue)
+// true when one of the values changed
+bool _drawVec3Control(const std::string &label, glm::vec3 &values, float resetValue)
 {
+    bool changed = false;
     ImGuiIO &io = ImGui::GetIO();
     auto boldFont = io.Fonts->Fonts[0];
     ImGuiStyle &style = ImGui::GetStyle();
@@ -57,12 +59,16 @@ void _drawVec3Control(const std::string &label, glm::vec3 &values, float resetVa
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.9f, 0.2f, 0.2f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.8f, 0.1f, 0.15f, 1.0f});
     ImGui::PushFont(boldFont);
-    if (ImGui::Button("", buttonSize)) values.x = resetValue;
+    if (ImGui::Button("", buttonSize))
+    {
+        values.x = resetValue;
+        changed = true;
+    }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
@@ -71,12 +77,16 @@ void _drawVec3Control(const std::string &label, glm::vec3 &values, float resetVa
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.3f, 0.8f, 0.3f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.2f, 0.7f, 0.2f, 1.0f});
     ImGui::PushFont(boldFont);
-    if (ImGui::Button("", buttonSize)) values.y = resetValue;
+    if (ImGui::Button("", buttonSize))
+    {
+        values.y = resetValue;
+        changed = true;
+    }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
@@ -85,12 +95,16 @@ void _drawVec3Control(const std::string &label, glm::vec3 &values, float resetVa
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.2f, 0.35f, 0.9f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.1f, 0.25f, 0.8f, 1.0f});
     ImGui::PushFont(boldFont);
-    if (ImGui::Button("", buttonSize)) values.z = resetValue;
+    if (ImGui::Button("", buttonSize))
+    {
+        values.z = resetValue;
+        changed = true;
+    }
     ImGui::PopFont();
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
 
     ImGui::PopStyleVar();
@@ -98,6 +112,7 @@ void _drawVec3Control(const std::string &label, glm::vec3 &values, float resetVa
     ImGui::Spacing();
 
     ImGui::PopID();
+    return changed;
 }
 
 void _collapsingHeaderStyle()
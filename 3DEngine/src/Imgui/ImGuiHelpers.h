@@ -6,6 +6,6 @@
 namespace Engine
 {
 	const char* _labelPrefix(const char* const label, const char* field = "");
-	void _drawVec3Control(const std::string& label, glm::vec3& values, float resetValue = 0.0f);
+	bool _drawVec3Control(const std::string& label, glm::vec3& values, float resetValue = 0.0f);
     void _collapsingHeaderStyle();
 } // namespace Engine
@@ -8,9 +8,50 @@
 
 #include "Application.h"
 #include "IconsFontAwesome5.h"
+#include "Profiler.h"
+#include "RenderThread.h"
+
+#include <memory>
+#include <vector>
 
 namespace Engine
 {
+namespace Utils
+{
+// A deep copy of ImGui's draw data, which the next NewFrame() overwrites, for rendering on the render thread.
+class ImGuiDrawDataCopy
+{
+  public:
+    ImGuiDrawDataCopy(const ImDrawData &source) : m_DrawData(source)
+    {
+        for (int i = 0; i < source.CmdListsCount; i++)
+            m_Lists.push_back(source.CmdLists[i]->CloneOutput());
+#if IMGUI_VERSION_NUM >= 18973
+        m_DrawData.CmdLists.resize(0);
+        for (ImDrawList *list : m_Lists)
+            m_DrawData.CmdLists.push_back(list);
+#else
+        m_DrawData.CmdLists = m_Lists.data();
+#endif
+    }
+
+    ~ImGuiDrawDataCopy()
+    {
+        for (ImDrawList *list : m_Lists)
+            IM_DELETE(list);
+    }
+
+    ImGuiDrawDataCopy(const ImGuiDrawDataCopy &) = delete;
+    ImGuiDrawDataCopy &operator=(const ImGuiDrawDataCopy &) = delete;
+
+    ImDrawData *Get() { return &m_DrawData; }
+
+  private:
+    ImDrawData m_DrawData;
+    std::vector<ImDrawList *> m_Lists;
+};
+} // namespace Utils
+
 ImGuiLayer::ImGuiLayer() {}
 
 ImGuiLayer::~ImGuiLayer() {}
@@ -63,7 +104,8 @@ void ImGuiLayer::OnDetach()
 
 void ImGuiLayer::Begin()
 {
-    ImGui_ImplOpenGL3_NewFrame();
+    // creates the font texture on first use, so it runs where the context is
+    RenderThread::Submit([] { ImGui_ImplOpenGL3_NewFrame(); });
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
     ImGuizmo::BeginFrame();
@@ -72,7 +114,20 @@ void ImGuiLayer::Begin()
 void ImGuiLayer::End()
 {
     ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    if (!RenderThread::IsRunning())
+    {
+        PROFILE_GPU_SCOPE("ImGui");
+        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        return;
+    }
+
+    // timed where the context is current
+    auto drawData = std::make_shared<Utils::ImGuiDrawDataCopy>(*ImGui::GetDrawData());
+    RenderThread::Submit([drawData]
+                         {
+                             PROFILE_GPU_SCOPE("ImGui");
+                             ImGui_ImplOpenGL3_RenderDrawData(drawData->Get());
+                         });
 }
 
 void ImGuiLayer::SetDarkThemeColors()
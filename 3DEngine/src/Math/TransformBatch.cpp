@@ -0,0 +1,281 @@
+#include "TransformBatch.h"
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENGINE_TRANSFORM_SSE 1
+#include <emmintrin.h>
+#endif
+
+// 8-wide only when the whole build targets AVX2 (/arch:AVX2, -mavx2), there is no runtime dispatch
+#if defined(ENGINE_TRANSFORM_SSE) && defined(__AVX2__)
+#define ENGINE_TRANSFORM_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace Engine
+{
+namespace Math
+{
+namespace Utils
+{
+enum Stream
+{
+    TX, TY, TZ, RX, RY, RZ, SX, SY, SZ, StreamCount
+};
+
+#ifdef ENGINE_TRANSFORM_SSE
+// cephes sinf/cosf: x - j * pi/2 in three parts keeps the argument within [-pi/4, pi/4] for the polynomials,
+// the quadrant j & 3 then picks which of the two is the sine and the signs
+constexpr float TwoOverPi = 0.636619772367581f;
+constexpr float HalfPi1 = 1.5703125f, HalfPi2 = 4.837512969970703125e-4f, HalfPi3 = 7.54978995489188216e-8f;
+constexpr float Sin1 = -1.6666654611e-1f, Sin2 = 8.3321608736e-3f, Sin3 = -1.9515295891e-4f;
+constexpr float Cos1 = 4.166664568298827e-2f, Cos2 = -1.388731625493765e-3f, Cos3 = 2.443315711809948e-5f;
+
+struct SSELanes
+{
+    using Float = __m128;
+    static constexpr size_t Width = 4;
+
+    static Float Load(const float *values) { return _mm_loadu_ps(values); }
+    static Float Set(float value) { return _mm_set1_ps(value); }
+    static Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+
+    static void SinCos(Float x, Float &outSin, Float &outCos)
+    {
+        const __m128i j = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TwoOverPi)));
+        const __m128 fj = _mm_cvtepi32_ps(j);
+        __m128 r = _mm_sub_ps(x, _mm_mul_ps(fj, _mm_set1_ps(HalfPi1)));
+        r = _mm_sub_ps(r, _mm_mul_ps(fj, _mm_set1_ps(HalfPi2)));
+        r = _mm_sub_ps(r, _mm_mul_ps(fj, _mm_set1_ps(HalfPi3)));
+        const __m128 r2 = _mm_mul_ps(r, r);
+
+        __m128 s = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Sin3), r2), _mm_set1_ps(Sin2));
+        s = _mm_add_ps(_mm_mul_ps(s, r2), _mm_set1_ps(Sin1));
+        s = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(s, r2), r), r);
+
+        __m128 c = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(Cos3), r2), _mm_set1_ps(Cos2));
+        c = _mm_add_ps(_mm_mul_ps(c, r2), _mm_set1_ps(Cos1));
+        c = _mm_mul_ps(_mm_mul_ps(c, r2), r2);
+        c = _mm_add_ps(_mm_sub_ps(c, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+        const __m128i one = _mm_set1_epi32(1), two = _mm_set1_epi32(2);
+        const __m128 swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(j, one), one));
+        const __m128 sinSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(j, two), 30));
+        const __m128 cosSign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(j, one), two), 30));
+
+        outSin = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, c), _mm_andnot_ps(swap, s)), sinSign);
+        outCos = _mm_xor_ps(_mm_or_ps(_mm_and_ps(swap, s), _mm_andnot_ps(swap, c)), cosSign);
+    }
+
+    // elements[c * 4 + r] holds row r of column c for four matrices, one per lane
+    static void Store(const __m128 *elements, glm::mat4 *out)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            __m128 a = elements[column * 4 + 0], b = elements[column * 4 + 1];
+            __m128 c = elements[column * 4 + 2], d = elements[column * 4 + 3];
+            _MM_TRANSPOSE4_PS(a, b, c, d);
+            _mm_storeu_ps(glm::value_ptr(out[0]) + column * 4, a);
+            _mm_storeu_ps(glm::value_ptr(out[1]) + column * 4, b);
+            _mm_storeu_ps(glm::value_ptr(out[2]) + column * 4, c);
+            _mm_storeu_ps(glm::value_ptr(out[3]) + column * 4, d);
+        }
+    }
+};
+#endif
+
+#ifdef ENGINE_TRANSFORM_AVX2
+struct AVX2Lanes
+{
+    using Float = __m256;
+    static constexpr size_t Width = 8;
+
+    static Float Load(const float *values) { return _mm256_loadu_ps(values); }
+    static Float Set(float value) { return _mm256_set1_ps(value); }
+    static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+    static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+    static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+
+    static void SinCos(Float x, Float &outSin, Float &outCos)
+    {
+        const __m256i j = _mm256_cvtps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(TwoOverPi)));
+        const __m256 fj = _mm256_cvtepi32_ps(j);
+        __m256 r = _mm256_sub_ps(x, _mm256_mul_ps(fj, _mm256_set1_ps(HalfPi1)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(fj, _mm256_set1_ps(HalfPi2)));
+        r = _mm256_sub_ps(r, _mm256_mul_ps(fj, _mm256_set1_ps(HalfPi3)));
+        const __m256 r2 = _mm256_mul_ps(r, r);
+
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(Sin3), r2), _mm256_set1_ps(Sin2));
+        s = _mm256_add_ps(_mm256_mul_ps(s, r2), _mm256_set1_ps(Sin1));
+        s = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(s, r2), r), r);
+
+        __m256 c = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(Cos3), r2), _mm256_set1_ps(Cos2));
+        c = _mm256_add_ps(_mm256_mul_ps(c, r2), _mm256_set1_ps(Cos1));
+        c = _mm256_mul_ps(_mm256_mul_ps(c, r2), r2);
+        c = _mm256_add_ps(_mm256_sub_ps(c, _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+        const __m256i one = _mm256_set1_epi32(1), two = _mm256_set1_epi32(2);
+        const __m256 swap = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(j, one), one));
+        const __m256 sinSign = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(j, two), 30));
+        const __m256 cosSign =
+            _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(_mm256_add_epi32(j, one), two), 30));
+
+        outSin = _mm256_xor_ps(_mm256_or_ps(_mm256_and_ps(swap, c), _mm256_andnot_ps(swap, s)), sinSign);
+        outCos = _mm256_xor_ps(_mm256_or_ps(_mm256_and_ps(swap, s), _mm256_andnot_ps(swap, c)), cosSign);
+    }
+
+    // the two halves go through the SSE transpose
+    static void Store(const __m256 *elements, glm::mat4 *out)
+    {
+        __m128 low[16], high[16];
+        for (int i = 0; i < 16; i++)
+        {
+            low[i] = _mm256_castps256_ps128(elements[i]);
+            high[i] = _mm256_extractf128_ps(elements[i], 1);
+        }
+        SSELanes::Store(low, out);
+        SSELanes::Store(high, out + 4);
+    }
+};
+#endif
+
+// Lanes::Width transforms starting at index; the same steps as glm::quat(eulerAngles) and glm::mat3_cast
+template <typename Lanes>
+static void ComputeLanes(const float *const *streams, size_t index, glm::mat4 *out)
+{
+    using L = Lanes;
+    using Float = typename Lanes::Float;
+
+    const Float half = L::Set(0.5f), one = L::Set(1.0f), two = L::Set(2.0f), zero = L::Set(0.0f);
+
+    Float sx, cx, sy, cy, sz, cz;
+    L::SinCos(L::Mul(L::Load(streams[RX] + index), half), sx, cx);
+    L::SinCos(L::Mul(L::Load(streams[RY] + index), half), sy, cy);
+    L::SinCos(L::Mul(L::Load(streams[RZ] + index), half), sz, cz);
+
+    const Float cxcy = L::Mul(cx, cy), sxsy = L::Mul(sx, sy), sxcy = L::Mul(sx, cy), cxsy = L::Mul(cx, sy);
+    const Float qw = L::Add(L::Mul(cxcy, cz), L::Mul(sxsy, sz));
+    const Float qx = L::Sub(L::Mul(sxcy, cz), L::Mul(cxsy, sz));
+    const Float qy = L::Add(L::Mul(cxsy, cz), L::Mul(sxcy, sz));
+    const Float qz = L::Sub(L::Mul(cxcy, sz), L::Mul(sxsy, cz));
+
+    const Float xx = L::Mul(qx, qx), yy = L::Mul(qy, qy), zz = L::Mul(qz, qz);
+    const Float xy = L::Mul(qx, qy), xz = L::Mul(qx, qz), yz = L::Mul(qy, qz);
+    const Float wx = L::Mul(qw, qx), wy = L::Mul(qw, qy), wz = L::Mul(qw, qz);
+
+    const Float scaleX = L::Load(streams[SX] + index);
+    const Float scaleY = L::Load(streams[SY] + index);
+    const Float scaleZ = L::Load(streams[SZ] + index);
+
+    Float elements[16];
+    elements[0] = L::Mul(L::Sub(one, L::Mul(two, L::Add(yy, zz))), scaleX);
+    elements[1] = L::Mul(L::Mul(two, L::Add(xy, wz)), scaleX);
+    elements[2] = L::Mul(L::Mul(two, L::Sub(xz, wy)), scaleX);
+    elements[3] = zero;
+    elements[4] = L::Mul(L::Mul(two, L::Sub(xy, wz)), scaleY);
+    elements[5] = L::Mul(L::Sub(one, L::Mul(two, L::Add(xx, zz))), scaleY);
+    elements[6] = L::Mul(L::Mul(two, L::Add(yz, wx)), scaleY);
+    elements[7] = zero;
+    elements[8] = L::Mul(L::Mul(two, L::Add(xz, wy)), scaleZ);
+    elements[9] = L::Mul(L::Mul(two, L::Sub(yz, wx)), scaleZ);
+    elements[10] = L::Mul(L::Sub(one, L::Mul(two, L::Add(xx, yy))), scaleZ);
+    elements[11] = zero;
+    elements[12] = L::Load(streams[TX] + index);
+    elements[13] = L::Load(streams[TY] + index);
+    elements[14] = L::Load(streams[TZ] + index);
+    elements[15] = one;
+
+    L::Store(elements, out + index);
+}
+} // namespace Utils
+
+glm::mat4 ComposeTransform(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale)
+{
+    const glm::vec3 c = glm::cos(rotation * 0.5f);
+    const glm::vec3 s = glm::sin(rotation * 0.5f);
+
+    const float qw = c.x * c.y * c.z + s.x * s.y * s.z;
+    const float qx = s.x * c.y * c.z - c.x * s.y * s.z;
+    const float qy = c.x * s.y * c.z + s.x * c.y * s.z;
+    const float qz = c.x * c.y * s.z - s.x * s.y * c.z;
+
+    const float xx = qx * qx, yy = qy * qy, zz = qz * qz;
+    const float xy = qx * qy, xz = qx * qz, yz = qy * qz;
+    const float wx = qw * qx, wy = qw * qy, wz = qw * qz;
+
+    glm::mat4 result;
+    result[0] = glm::vec4(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f) * scale.x;
+    result[1] = glm::vec4(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f) * scale.y;
+    result[2] = glm::vec4(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f) * scale.z;
+    result[3] = glm::vec4(translation, 1.0f);
+    return result;
+}
+
+void TransformBatch::Clear()
+{
+    for (auto *stream : {&m_TX, &m_TY, &m_TZ, &m_RX, &m_RY, &m_RZ, &m_SX, &m_SY, &m_SZ})
+        stream->clear();
+}
+
+void TransformBatch::Reserve(size_t count)
+{
+    for (auto *stream : {&m_TX, &m_TY, &m_TZ, &m_RX, &m_RY, &m_RZ, &m_SX, &m_SY, &m_SZ})
+        stream->reserve(count);
+}
+
+void TransformBatch::Add(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale)
+{
+    m_TX.push_back(translation.x);
+    m_TY.push_back(translation.y);
+    m_TZ.push_back(translation.z);
+    m_RX.push_back(rotation.x);
+    m_RY.push_back(rotation.y);
+    m_RZ.push_back(rotation.z);
+    m_SX.push_back(scale.x);
+    m_SY.push_back(scale.y);
+    m_SZ.push_back(scale.z);
+}
+
+void TransformBatch::Compute(glm::mat4 *out) const { Compute(out, 0, GetCount()); }
+
+void TransformBatch::Compute(glm::mat4 *out, size_t first, size_t last) const
+{
+    const float *streams[Utils::StreamCount] = {m_TX.data(), m_TY.data(), m_TZ.data(), m_RX.data(), m_RY.data(),
+                                                m_RZ.data(), m_SX.data(), m_SY.data(), m_SZ.data()};
+    const size_t count = last;
+    size_t i = first;
+
+#ifdef ENGINE_TRANSFORM_AVX2
+    for (; i + Utils::AVX2Lanes::Width <= count; i += Utils::AVX2Lanes::Width)
+        Utils::ComputeLanes<Utils::AVX2Lanes>(streams, i, out);
+#endif
+#ifdef ENGINE_TRANSFORM_SSE
+    for (; i + Utils::SSELanes::Width <= count; i += Utils::SSELanes::Width)
+        Utils::ComputeLanes<Utils::SSELanes>(streams, i, out);
+#endif
+
+    // the tail that doesn't fill a register
+    for (; i < count; i++)
+    {
+        out[i] = ComposeTransform(glm::vec3(m_TX[i], m_TY[i], m_TZ[i]), glm::vec3(m_RX[i], m_RY[i], m_RZ[i]),
+                                  glm::vec3(m_SX[i], m_SY[i], m_SZ[i]));
+    }
+}
+
+const char *TransformBatch::GetInstructionSet()
+{
+#if defined(ENGINE_TRANSFORM_AVX2)
+    return "AVX2";
+#elif defined(ENGINE_TRANSFORM_SSE)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+}
+} // namespace Math
+} // namespace Engine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace Engine
+{
+namespace Math
+{
+// translate * toMat4(quat(rotation)) * scale without the three matrix products, rotation being Euler angles in
+// radians like TransformComponent::Rotation
+glm::mat4 ComposeTransform(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale);
+
+// Translation, rotation and scale of many transforms in structure-of-arrays layout, so Compute() turns a whole
+// SIMD register of them (8 with AVX2, 4 with SSE) into world matrices at once. The results match
+// ComposeTransform up to float rounding of the polynomial sin/cos.
+class TransformBatch
+{
+  public:
+    void Clear();
+    void Reserve(size_t count);
+    void Add(const glm::vec3 &translation, const glm::vec3 &rotation, const glm::vec3 &scale);
+
+    size_t GetCount() const { return m_TX.size(); }
+
+    // out has room for GetCount() matrices
+    void Compute(glm::mat4 *out) const;
+    // only [first, last) into the same places of out, for splitting a batch across threads
+    void Compute(glm::mat4 *out, size_t first, size_t last) const;
+
+    static const char *GetInstructionSet();
+
+  private:
+    std::vector<float> m_TX, m_TY, m_TZ;
+    std::vector<float> m_RX, m_RY, m_RZ;
+    std::vector<float> m_SX, m_SY, m_SZ;
+};
+} // namespace Math
+} // namespace Engine
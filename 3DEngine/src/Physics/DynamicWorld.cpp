@@ -1,12 +1,13 @@
 #include "DynamicWorld.h"
 
+#include "JoltJobSystem.h"
 #include "Log.h"
+#include "MemoryTracker.h"
 
 #include <Jolt/Jolt.h>
 #include <Jolt/RegisterTypes.h>
 #include <Jolt/Core/Factory.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
 #include <Jolt/Physics/PhysicsSettings.h>
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/BoxShape.h>
@@ -64,6 +65,20 @@ static bool AssertFailedImpl(const char *inExpression, const char *inMessage, co
 
 #endif // JPH_ENABLE_ASSERTS
 
+#ifdef ENGINE_TRACK_MEMORY
+
+// Jolt allocates on its job threads, so the tag is passed along instead of taken from the calling thread
+static void *AllocateImpl(size_t inSize) { return MemoryTracker::Allocate(inSize, 16, MemoryTag::Physics); }
+
+static void *AlignedAllocateImpl(size_t inSize, size_t inAlignment)
+{
+    return MemoryTracker::Allocate(inSize, inAlignment, MemoryTag::Physics);
+}
+
+static void FreeImpl(void *inBlock) { MemoryTracker::Free(inBlock); }
+
+#endif // ENGINE_TRACK_MEMORY
+
 // Layer that objects can be in, determines which other objects it can collide with
 // Typically you at least want to have 1 layer for moving bodies and 1 layer for static bodies, but you can have more
 // layers if you want. E.g. you could have a layer for high detail collision (which is not used by the physics
@@ -185,8 +200,17 @@ namespace Physics
 {
 DynamicWorld::DynamicWorld(Scene *scene) : m_Scene(scene)
 {
+    MEMORY_TAG(Physics);
+
     // Register allocation hook
+#ifdef ENGINE_TRACK_MEMORY
+    JPH::Allocate = AllocateImpl;
+    JPH::Free = FreeImpl;
+    JPH::AlignedAllocate = AlignedAllocateImpl;
+    JPH::AlignedFree = FreeImpl;
+#else
     RegisterDefaultAllocator();
+#endif
 
     // Install callbacks
     Trace = TraceImpl;
@@ -224,8 +248,9 @@ DynamicWorld::DynamicWorld(Scene *scene) : m_Scene(scene)
     // every frame or when e.g. streaming in a new level section as it is an expensive operation. Instead insert all new
     // objects in batches instead of 1 at a time to keep the broad phase efficient.
     m_JoltPhysicsSystem->OptimizeBroadPhase();
-    const uint32_t availableThreads = std::thread::hardware_concurrency() - 1;
-    m_JoltJobSystem = new JPH::JobSystemThreadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, availableThreads);
+    // on the engine's workers, physics and the rest of the frame share one thread budget
+    m_JoltJobSystem = std::make_shared<JoltJobSystem>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    m_JoltTempAllocator = std::make_shared<JPH::TempAllocatorImpl>(10 * 1024 * 1024);
 }
 
 void DynamicWorld::SetGravity(const glm::vec3 &gravity)
@@ -235,6 +260,7 @@ void DynamicWorld::SetGravity(const glm::vec3 &gravity)
 
 void DynamicWorld::AddRigidBody(RigidBodyRef rb)
 {
+    MEMORY_TAG(Physics);
     JPH::BodyInterface &bodyInterface = m_JoltPhysicsSystem->GetBodyInterface();
 
     const float mass = rb->Mass;
@@ -389,11 +415,21 @@ void DynamicWorld::SyncEntitiesTransforms()
         auto entId = static_cast<int>(bodyInterface.GetUserData(bodyId));
         Entity entity = Entity{(entt::entity)entId, m_Scene};
 
-        auto &transformComponent = entity.GetComponent<TransformComponent>();
-
         // update transform
-        transformComponent.Translation = pos;
-        transformComponent.Rotation = glm::vec3(rotation.x, rotation.y, rotation.z);
+        entity.PatchComponent<TransformComponent>(
+            [&](auto &transformComponent)
+            {
+                transformComponent.Translation = pos;
+                transformComponent.Rotation = glm::eulerAngles(rotation);
+                transformComponent.MarkDirty();
+            });
+
+        auto &rigidBody = entity.GetComponent<RigidBodyComponent>();
+        rigidBody.PreviousPosition = rigidBody.HasPose ? rigidBody.CurrentPosition : pos;
+        rigidBody.PreviousRotation = rigidBody.HasPose ? rigidBody.CurrentRotation : rotation;
+        rigidBody.CurrentPosition = pos;
+        rigidBody.CurrentRotation = rotation;
+        rigidBody.HasPose = true;
         // transformComponent.Scale = scale;
 
         // transformComponent.SetTransform(transform);
@@ -404,6 +440,7 @@ void DynamicWorld::SyncCharactersTransforms() {}
 
 void DynamicWorld::StepSimulation(float dt)
 {
+    MEMORY_TAG(Physics);
     // If you take larger steps than 1 / 90th of a second you need to do multiple collision steps in order to keep the
     // simulation stable. Do 1 collision step per 1 / 60th of a second (round up).
     int collisionSteps = 1;
@@ -412,13 +449,13 @@ void DynamicWorld::StepSimulation(float dt)
 
     if (dt > minStepDuration)
     {
-        LOG_CORE_WARN("Large step detected: {}", dt);
+        LOG_CORE_WARN_LIMITED(1.0, "Large step detected: {}", dt);
         collisionSteps = static_cast<float>(dt) / minStepDuration;
     }
 
     if (collisionSteps >= maxStepCount)
     {
-        LOG_CORE_WARN("Very large step detected: {}", dt);
+        LOG_CORE_WARN_LIMITED(1.0, "Very large step detected: {}", dt);
     }
 
     // Prevents having too many steps and running out of jobs
@@ -427,11 +464,9 @@ void DynamicWorld::StepSimulation(float dt)
     // step the world
     try
     {
-        auto joltTempAllocator = std::make_shared<JPH::TempAllocatorMalloc>();
-
         // TODO: character stepping
 
-        m_JoltPhysicsSystem->Update(dt, collisionSteps, joltTempAllocator.get(), m_JoltJobSystem);
+        m_JoltPhysicsSystem->Update(dt, collisionSteps, m_JoltTempAllocator.get(), m_JoltJobSystem.get());
     }
     catch (...)
     {
@@ -13,11 +13,11 @@
 namespace JPH
 {
 class PhysicsSystem;
-class JobSystemThreadPool;
 class ContactListener;
 class BodyInterface;
 class Shape;
 class Character;
+class TempAllocator;
 
 template <class T> class Ref;
 } // namespace JPH
@@ -31,6 +31,8 @@ class Scene;
 
 namespace Physics
 {
+class JoltJobSystem;
+
 class DynamicWorld
 {
   public:
@@ -55,7 +57,9 @@ class DynamicWorld
 
   private:
     std::shared_ptr<JPH::PhysicsSystem> m_JoltPhysicsSystem;
-    JPH::JobSystemThreadPool *m_JoltJobSystem;
+    std::shared_ptr<JoltJobSystem> m_JoltJobSystem;
+    // Jolt's own linear allocator for the scratch memory of a step, reset by every step
+    std::shared_ptr<JPH::TempAllocator> m_JoltTempAllocator;
     JPH::BodyInterface *m_JoltBodyInterface;
     BPLayerInterfaceImpl *m_JoltBroadphaseLayerInterface;
 
@@ -0,0 +1,61 @@
+#include "JoltJobSystem.h"
+
+#include "JobSystem.h"
+#include "Log.h"
+
+#include <thread>
+
+namespace Engine
+{
+namespace Physics
+{
+JoltJobSystem::JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers) : JPH::JobSystemWithBarrier(maxBarriers)
+{
+    m_Jobs.Init(maxJobs, maxJobs);
+}
+
+// inside the class JobSystem names Jolt's base, the engine's needs its namespace
+int JoltJobSystem::GetMaxConcurrency() const { return (int)Engine::JobSystem::GetWorkerCount() + 1; }
+
+JPH::JobSystem::JobHandle JoltJobSystem::CreateJob(const char *name, JPH::ColorArg color,
+                                                   const JobFunction &function, JPH::uint32 dependencyCount)
+{
+    JPH::uint32 index = m_Jobs.ConstructObject(name, color, this, function, dependencyCount);
+    while (index == decltype(m_Jobs)::cInvalidObjectIndex)
+    {
+        // the free list is sized for a step, running out means jobs of an earlier one are still queued
+        LOG_CORE_WARN_LIMITED(1.0, "JoltJobSystem: out of jobs");
+        std::this_thread::yield();
+        index = m_Jobs.ConstructObject(name, color, this, function, dependencyCount);
+    }
+    Job *job = &m_Jobs.Get(index);
+
+    // the handle keeps the job alive, it may finish before this returns
+    JobHandle handle(job);
+    if (dependencyCount == 0) QueueJob(job);
+    return handle;
+}
+
+void JoltJobSystem::QueueJob(Job *job)
+{
+    if (Engine::JobSystem::GetWorkerCount() == 0) return;
+
+    // executing a job a barrier already ran does nothing, the reference only keeps it alive until then
+    job->AddRef();
+    Engine::JobSystem::Submit(
+        [job]
+        {
+            job->Execute();
+            job->Release();
+        });
+}
+
+void JoltJobSystem::QueueJobs(Job **jobs, JPH::uint count)
+{
+    for (JPH::uint i = 0; i < count; i++)
+        QueueJob(jobs[i]);
+}
+
+void JoltJobSystem::FreeJob(Job *job) { m_Jobs.DestructObject(job); }
+} // namespace Physics
+} // namespace Engine
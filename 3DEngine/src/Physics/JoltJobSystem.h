@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+namespace Engine
+{
+namespace Physics
+{
+// Runs Jolt's jobs on the engine JobSystem instead of a thread pool of its own, so the simulation shares the
+// workers with everything else. Jolt keeps its job objects and barriers; a queued job becomes an engine job that
+// executes it. Without workers the jobs are left to the barrier, which runs them on the waiting thread.
+class JoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+  public:
+    JoltJobSystem(JPH::uint maxJobs, JPH::uint maxBarriers);
+
+    int GetMaxConcurrency() const override;
+    JobHandle CreateJob(const char *name, JPH::ColorArg color, const JobFunction &function,
+                        JPH::uint32 dependencyCount = 0) override;
+
+  protected:
+    void QueueJob(Job *job) override;
+    void QueueJobs(Job **jobs, JPH::uint count) override;
+    void FreeJob(Job *job) override;
+
+  private:
+    JPH::FixedSizeFreeList<Job> m_Jobs;
+};
+} // namespace Physics
+} // namespace Engine
@@ -1,6 +1,7 @@
 #include "PhysicsManager.h"
 
 #include "Scene.h"
+#include "Profiler.h"
 
 namespace Engine
 {
@@ -8,6 +9,7 @@ void PhysicsManager::RegisterBody(Physics::RigidBodyRef rb) { m_World->AddRigidB
 
 void PhysicsManager::Step(float dt) 
 {
+    PROFILE_FUNCTION();
     if (m_IsRunning || m_StepCount-- > 0) m_World->StepSimulation(dt);
 }
 
@@ -2,6 +2,8 @@
 
 #include "ProjectSerializer.h"
 #include "Log.h"
+#include "PakArchive.h"
+#include "VirtualFileSystem.h"
 #include <iostream>
 
 namespace Engine
@@ -32,6 +34,7 @@ std::shared_ptr<Project> Project::New(const std::filesystem::path &path)
         .AssetDirectory = "Assets",
     };
     s_ActiveProject->SetConfig(config);
+    MountAssets();
     auto fileName = path.filename().string() + ".3dproj";
     SaveActive(path / fileName);
 
@@ -47,6 +50,7 @@ std::shared_ptr<Project> Project::Load(const std::filesystem::path &path)
     {
         s_ActiveProject = project;
         s_ActiveProject->m_ProjectDirectory = path.parent_path();
+        MountAssets();
 
         std::shared_ptr<EditorAssetManager> editorAssetManager = std::make_shared<EditorAssetManager>();
         s_ActiveProject->m_AssetManager = editorAssetManager;
@@ -58,6 +62,25 @@ std::shared_ptr<Project> Project::Load(const std::filesystem::path &path)
     return nullptr;
 }
 
+void Project::MountAssets()
+{
+    VirtualFileSystem::Unmount(AssetMountPoint);
+
+    const std::filesystem::path pakPath = GetAssetPakPath();
+    std::error_code error;
+    if (std::filesystem::exists(pakPath, error)) VirtualFileSystem::MountPak(AssetMountPoint, pakPath);
+    VirtualFileSystem::Mount(AssetMountPoint, GetAssetDirectory());
+}
+
+bool Project::RebuildAssetPak()
+{
+    // a mapped pak can't be replaced on Windows and elsewhere the old one would still be served, so it goes first
+    VirtualFileSystem::Unmount(AssetMountPoint);
+    const bool built = PakArchive::Build(GetAssetDirectory(), GetAssetPakPath());
+    MountAssets();
+    return built;
+}
+
 bool Project::SaveActive(const std::filesystem::path &path)
 {
     ProjectSerializer serializer(s_ActiveProject);
@@ -31,6 +31,17 @@ class Project
         return GetProjectDirectory() / s_ActiveProject->m_Config.AssetDirectory;
     }
 
+    // where the asset directory, and Assets.pak next to it, are mounted in the VirtualFileSystem
+    static constexpr const char *AssetMountPoint = "Assets";
+
+    static std::filesystem::path GetAssetPakPath() { return GetProjectDirectory() / "Assets.pak"; }
+
+    // the virtual path of a file below the asset directory, importers read through it
+    static std::filesystem::path GetAssetPath(const std::filesystem::path &path)
+    {
+        return std::filesystem::path(AssetMountPoint) / path;
+    }
+
     static std::filesystem::path GetAssetRegistryPath()
     {
         return GetAssetDirectory() / s_ActiveProject->m_Config.AssetRegistryPath;
@@ -41,6 +52,9 @@ class Project
 		return GetAssetDirectory() / s_ActiveProject->m_Config.ScriptModulePath;
 	}
 
+    // derived data (cooked assets) that can be deleted and rebuilt at any time
+    static std::filesystem::path GetCacheDirectory() { return GetProjectDirectory() / "Cache"; }
+
     ProjectConfig &GetConfig() { return m_Config; }
     void SetConfig(const ProjectConfig &config) { m_Config = config; }
 
@@ -56,6 +70,13 @@ class Project
     static std::shared_ptr<Project> Load(const std::filesystem::path &path);
     static bool SaveActive(const std::filesystem::path &path);
 
+    // packs the asset directory into Assets.pak and mounts the new pak; assets already loaded keep their data
+    static bool RebuildAssetPak();
+
+  private:
+    // loose files override the pak, so a shipped project can still be patched
+    static void MountAssets();
+
   private:
     ProjectConfig m_Config;
     std::filesystem::path m_ProjectDirectory;
@@ -3,6 +3,7 @@
 #include <fstream>
 #include <yaml-cpp/yaml.h>
 
+#include "FileMapping.h"
 #include "Log.h"
 
 namespace Engine
@@ -42,7 +43,9 @@ bool ProjectSerializer::Deserialize(const std::filesystem::path &filepath)
     YAML::Node data;
     try
     {
-        data = YAML::LoadFile(filepath.string());
+        FileMapping file(filepath);
+        MemoryStream stream(file);
+        data = YAML::Load(stream);
     }
     catch (YAML::ParserException e)
     {
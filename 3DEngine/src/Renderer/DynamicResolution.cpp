@@ -0,0 +1,54 @@
+#include "DynamicResolution.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine
+{
+// scales are snapped to this step, every distinct scale is another set of pooled render targets
+constexpr float ScaleStep = 0.05f;
+// frames to wait after a change, timer results trail the frame by a few frames
+constexpr uint32_t ChangeCooldown = 15;
+// don't react to frame times within this fraction of the target
+constexpr float Tolerance = 0.05f;
+
+void DynamicResolution::Update(float gpuFrameTime)
+{
+    m_FrameTimeHistory[m_HistoryOffset] = gpuFrameTime;
+    m_ScaleHistory[m_HistoryOffset] = GetScale();
+    m_HistoryOffset = (m_HistoryOffset + 1) % HistorySize;
+
+    m_SmoothedFrameTime = m_SmoothedFrameTime == 0.0f ? gpuFrameTime : glm::mix(m_SmoothedFrameTime, gpuFrameTime, 0.1f);
+
+    m_Settings.MinScale = std::clamp(m_Settings.MinScale, ScaleStep, 1.0f);
+    m_Settings.MaxScale = std::clamp(m_Settings.MaxScale, m_Settings.MinScale, 1.0f);
+
+    if (!m_Settings.Enabled || m_SmoothedFrameTime <= 0.0f || m_Settings.TargetFrameTime <= 0.0f)
+    {
+        m_Scale = std::clamp(m_Scale, m_Settings.MinScale, m_Settings.MaxScale);
+        return;
+    }
+
+    if (m_Cooldown > 0)
+    {
+        m_Cooldown--;
+        return;
+    }
+
+    float ratio = m_Settings.TargetFrameTime / m_SmoothedFrameTime;
+    if (std::abs(ratio - 1.0f) < Tolerance) return;
+
+    float scale = m_Scale * std::sqrt(ratio);
+    scale = std::round(scale / ScaleStep) * ScaleStep;
+    scale = std::clamp(scale, m_Settings.MinScale, m_Settings.MaxScale);
+    if (scale == m_Scale) return;
+
+    m_Scale = scale;
+    m_Cooldown = ChangeCooldown;
+}
+
+glm::vec2 DynamicResolution::GetRenderSize(const glm::vec2 &outputSize) const
+{
+    return glm::max(glm::floor(outputSize * GetScale()), glm::vec2(1.0f));
+}
+} // namespace Engine
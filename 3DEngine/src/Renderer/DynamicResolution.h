@@ -0,0 +1,50 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <stdint.h>
+
+namespace Engine
+{
+struct DynamicResolutionSettings
+{
+    bool Enabled = false;
+    float MinScale = 0.5f;
+    float MaxScale = 1.0f;
+    float TargetFrameTime = 16.6f; // milliseconds of GPU time
+    float Sharpness = 0.5f;        // applied while upscaling in the composite pass
+};
+
+// Picks the scale of the internal render resolution from measured GPU frame times. GPU cost is taken to follow
+// the pixel count, so the scale moves by the square root of the ratio to the target. It only moves in coarse
+// steps and after a cooldown, so render targets aren't reallocated every frame.
+class DynamicResolution
+{
+  public:
+    static constexpr uint32_t HistorySize = 120;
+
+  public:
+    void Update(float gpuFrameTime);
+
+    float GetScale() const { return m_Settings.Enabled ? m_Scale : 1.0f; }
+    glm::vec2 GetRenderSize(const glm::vec2 &outputSize) const;
+
+    DynamicResolutionSettings &GetSettings() { return m_Settings; }
+
+    // ring buffers for ImGui::PlotLines, the oldest sample sits at GetHistoryOffset()
+    const std::array<float, HistorySize> &GetFrameTimeHistory() const { return m_FrameTimeHistory; }
+    const std::array<float, HistorySize> &GetScaleHistory() const { return m_ScaleHistory; }
+    uint32_t GetHistoryOffset() const { return m_HistoryOffset; }
+
+  private:
+    DynamicResolutionSettings m_Settings;
+    float m_Scale = 1.0f;
+    float m_SmoothedFrameTime = 0.0f;
+    uint32_t m_Cooldown = 0;
+
+    std::array<float, HistorySize> m_FrameTimeHistory{};
+    std::array<float, HistorySize> m_ScaleHistory{};
+    uint32_t m_HistoryOffset = 0;
+};
+} // namespace Engine
@@ -8,6 +8,6 @@ Environment::Environment()
     ProceduralSkybox = std::make_shared<ProceduralSky>();
 
 	Bloom = std::make_shared<BloomRenderer>();
-	Bloom->Init(1280, 720);
+	Bloom->Init();
 }
 } // namespace Engine
@@ -32,6 +32,15 @@ class Environment
 	bool BloomEnabled = true;
 	float Exposure = 1.2f;
 	float BloomIntensity = 0.04f;
+	// depth-only pass over the opaque meshes before shading them with GL_EQUAL
+	bool DepthPrepass = false;
+	// G-buffer plus one tiled lighting pass instead of forward PBR
+	bool DeferredShading = false;
+	// diffuse ambient from the sky's SH9 projection instead of the convolved irradiance cubemap
+	bool SHIrradiance = true;
+
+	// compute bloom and the fused composite pass, the fragment passes are kept as a fallback
+	bool ComputePostFX = true;
 };
 
 static std::string SkyTypeToString(SkyType type)
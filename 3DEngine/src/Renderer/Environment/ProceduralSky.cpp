@@ -1,30 +1,48 @@
 #include "ProceduralSky.h"
 
-#include <glad/glad.h>
-
 #include "ShaderManager.h"
 #include "RenderCommand.h"
 #include "Renderer.h"
 
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+
 namespace Engine
 {
+namespace Utils
+{
+// bilinear lookup into a LUT copy whose texel centres sit on the ends of the [0, 1] parameter range
+static glm::vec3 SampleLUT(const std::vector<glm::vec4> &data, uint32_t width, uint32_t height, glm::vec2 param)
+{
+    if (data.empty()) return glm::vec3(0.0f);
+
+    glm::vec2 position = glm::clamp(param, 0.0f, 1.0f) * glm::vec2(width - 1, height - 1);
+    glm::uvec2 p0 = glm::uvec2(position);
+    glm::uvec2 p1 = glm::min(p0 + 1u, glm::uvec2(width - 1, height - 1));
+    glm::vec2 f = position - glm::vec2(p0);
+
+    auto texel = [&](uint32_t x, uint32_t y) { return glm::vec3(data[(size_t)y * width + x]); };
+    return glm::mix(glm::mix(texel(p0.x, p0.y), texel(p1.x, p0.y), f.x),
+                    glm::mix(texel(p0.x, p1.y), texel(p1.x, p1.y), f.x), f.y);
+}
+
+static uint32_t GroupCount(uint32_t size) { return (size + 7) / 8; }
+} // namespace Utils
+
 ProceduralSky::ProceduralSky() {}
 
 void ProceduralSky::Draw(glm::mat4 projection, glm::mat4 view)
 {
+    UpdateLUTs();
+
     Shader *skyShader = ShaderManager::GetShader("Resources/shaders/atmosphericSky");
     skyShader->Bind();
-    skyShader->SetUniform1f("SurfaceRadius", SurfaceRadius);
-    skyShader->SetUniform1f("AtmosphereRadius", AtmosphereRadius);
-    skyShader->SetUniform1f("SunIntensity", SunIntensity);
-
-    skyShader->SetUniform3f("RayleighScattering", RayleighScattering);
-    skyShader->SetUniform3f("MieScattering", MieScattering);
-    skyShader->SetUniform3f("CenterPoint", CenterPoint);
-    skyShader->SetUniform3f("SunDirection", SunDirection);
-
+    skyShader->SetUniform1i("SkyViewLUT", 0);
+    skyShader->SetUniform3f("SunDirection", glm::normalize(SunDirection));
     skyShader->SetUniformMatrix4fv("Projection", projection);
     skyShader->SetUniformMatrix4fv("View", view);
+    m_SkyViewLUT->Bind(0);
 
     RenderCommand::Disable(RendererEnum::DEPTH_TEST);
 
@@ -32,4 +50,140 @@ void ProceduralSky::Draw(glm::mat4 projection, glm::mat4 view)
 
     RenderCommand::Enable(RendererEnum::DEPTH_TEST);
 }
+
+void ProceduralSky::SetAtmosphereUniforms(Shader &shader) const
+{
+    // the LUT shaders work in kilometres
+    shader.SetUniform1f("groundRadius", SurfaceRadius * 1e-3f);
+    shader.SetUniform1f("atmosphereRadius", AtmosphereRadius * 1e-3f);
+    shader.SetUniform3f("rayleighScattering", RayleighScattering * 1e3f);
+    shader.SetUniform3f("mieScattering", MieScattering * 1e3f);
+}
+
+void ProceduralSky::UpdateLUTs()
+{
+    const AtmosphereParameters atmosphere{SurfaceRadius, AtmosphereRadius, RayleighScattering, MieScattering,
+                                          CenterPoint};
+    const SunParameters sun{glm::normalize(SunDirection), SunIntensity};
+
+    // the viewer sits at the origin, CenterPoint is the planet centre
+    const float viewHeight = std::max(glm::length(CenterPoint) - SurfaceRadius, 0.0f);
+
+    // copies of LUTs generated a frame or two ago
+    const bool transmittanceArrived = m_TransmittanceReadback.Fetch(m_TransmittanceData.data());
+    if (m_SkyViewReadback.Fetch(m_SkyViewData.data())) m_IrradianceSHDirty = true;
+
+    const bool atmosphereChanged = m_TransmittanceLUT == nullptr || atmosphere != m_AtmosphereParameters;
+    const bool sunChanged = sun != m_SunParameters;
+    if (atmosphereChanged || sunChanged) GenerateLUTs(sun, viewHeight, atmosphereChanged);
+    if (!transmittanceArrived && !atmosphereChanged && !sunChanged) return;
+
+    // same lookup skyMultiScattering.comp does for the sun at the viewer
+    const glm::vec2 sunParam(sun.SunDirection.y * 0.5f + 0.5f,
+                             viewHeight / std::max(AtmosphereRadius - SurfaceRadius, 1.0f));
+    m_SunColor = Utils::SampleLUT(m_TransmittanceData, TransmittanceWidth, TransmittanceHeight, sunParam);
+
+    m_AtmosphereParameters = atmosphere;
+    m_SunParameters = sun;
+}
+
+void ProceduralSky::GenerateLUTs(const SunParameters &sun, float viewHeight, bool atmosphereChanged)
+{
+    // the first copies are waited for, there is nothing to light with before them
+    const bool first = m_TransmittanceLUT == nullptr;
+    if (first)
+    {
+        auto lut = [](uint32_t width, uint32_t height)
+        {
+            return std::make_shared<Texture2D>(TextureSpecification{
+                .Width = width, .Height = height, .Format = ImageFormat::RGBA32F, .GenerateMips = false});
+        };
+        m_TransmittanceLUT = lut(TransmittanceWidth, TransmittanceHeight);
+        m_MultiScatteringLUT = lut(MultiScatteringSize, MultiScatteringSize);
+        m_SkyViewLUT = lut(SkyViewWidth, SkyViewHeight);
+        m_TransmittanceData.resize(TransmittanceWidth * TransmittanceHeight);
+        m_SkyViewData.resize(SkyViewWidth * SkyViewHeight);
+    }
+
+    if (atmosphereChanged)
+    {
+        Shader *transmittanceShader = ShaderManager::GetComputeShader("Resources/shaders/skyTransmittance");
+        transmittanceShader->Bind();
+        SetAtmosphereUniforms(*transmittanceShader);
+        RenderCommand::BindImageTexture(0, m_TransmittanceLUT->GetRendererID(), ImageFormat::RGBA32F,
+                                        RendererEnum::WRITE_ONLY);
+        RenderCommand::DispatchCompute(Utils::GroupCount(TransmittanceWidth), Utils::GroupCount(TransmittanceHeight));
+        RenderCommand::InsertMemoryBarrier();
+
+        Shader *multiScatteringShader = ShaderManager::GetComputeShader("Resources/shaders/skyMultiScattering");
+        multiScatteringShader->Bind();
+        SetAtmosphereUniforms(*multiScatteringShader);
+        multiScatteringShader->SetUniform3f("groundAlbedo", glm::vec3(0.3f));
+        m_TransmittanceLUT->Bind(0);
+        RenderCommand::BindImageTexture(0, m_MultiScatteringLUT->GetRendererID(), ImageFormat::RGBA32F,
+                                        RendererEnum::WRITE_ONLY);
+        RenderCommand::DispatchCompute(Utils::GroupCount(MultiScatteringSize), Utils::GroupCount(MultiScatteringSize));
+        RenderCommand::InsertMemoryBarrier();
+
+        const uint32_t size = m_TransmittanceData.size() * sizeof(glm::vec4);
+        if (first)
+            RenderCommand::ReadTextureData(m_TransmittanceLUT->GetRendererID(), ImageFormat::RGBA32F, size,
+                                           m_TransmittanceData.data());
+        else
+            m_TransmittanceReadback.Start(m_TransmittanceLUT->GetRendererID(), ImageFormat::RGBA32F, size);
+    }
+
+    Shader *skyViewShader = ShaderManager::GetComputeShader("Resources/shaders/skyView");
+    skyViewShader->Bind();
+    SetAtmosphereUniforms(*skyViewShader);
+    skyViewShader->SetUniform1f("viewHeight", viewHeight * 1e-3f);
+    skyViewShader->SetUniform3f("sunDirection", sun.SunDirection);
+    skyViewShader->SetUniform1f("sunIntensity", SunIntensity);
+    m_TransmittanceLUT->Bind(0);
+    m_MultiScatteringLUT->Bind(1);
+    RenderCommand::BindImageTexture(0, m_SkyViewLUT->GetRendererID(), ImageFormat::RGBA32F, RendererEnum::WRITE_ONLY);
+    RenderCommand::DispatchCompute(Utils::GroupCount(SkyViewWidth), Utils::GroupCount(SkyViewHeight));
+    RenderCommand::InsertMemoryBarrier();
+
+    const uint32_t size = m_SkyViewData.size() * sizeof(glm::vec4);
+    if (first)
+    {
+        RenderCommand::ReadTextureData(m_SkyViewLUT->GetRendererID(), ImageFormat::RGBA32F, size, m_SkyViewData.data());
+        m_IrradianceSHDirty = true;
+    }
+    else
+    {
+        m_SkyViewReadback.Start(m_SkyViewLUT->GetRendererID(), ImageFormat::RGBA32F, size);
+    }
+}
+
+glm::vec3 ProceduralSky::GetRadiance(const glm::vec3 &direction) const
+{
+    // the mapping atmosphericSky.frag uses to read the sky-view LUT
+    const float halfPi = glm::half_pi<float>();
+    const float elevation = std::asin(std::clamp(direction.y, -1.0f, 1.0f));
+
+    const glm::vec2 horizontal(direction.x, direction.z), sunHorizontal(SunDirection.x, SunDirection.z);
+    float azimuth = 0.0f;
+    if (glm::dot(horizontal, horizontal) > 1e-8f && glm::dot(sunHorizontal, sunHorizontal) > 1e-8f)
+    {
+        const float cosAzimuth = glm::dot(glm::normalize(horizontal), glm::normalize(sunHorizontal));
+        azimuth = std::acos(std::clamp(cosAzimuth, -1.0f, 1.0f));
+    }
+
+    const float x = (elevation < 0.0f ? -1.0f : 1.0f) * std::sqrt(std::abs(elevation) / halfPi);
+    const glm::vec2 param(azimuth / glm::pi<float>(), x * 0.5f + 0.5f);
+    return Utils::SampleLUT(m_SkyViewData, SkyViewWidth, SkyViewHeight, param) * 4.0f;
+}
+
+const SH9 &ProceduralSky::GetIrradianceSH()
+{
+    UpdateLUTs();
+    if (!m_IrradianceSHDirty) return m_IrradianceSH;
+
+    m_IrradianceSH = SphericalHarmonics::ConvolveCosine(
+        SphericalHarmonics::ProjectSphere([this](const glm::vec3 &direction) { return GetRadiance(direction); }));
+    m_IrradianceSHDirty = false;
+    return m_IrradianceSH;
+}
 } // namespace Engine
@@ -2,9 +2,18 @@
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
+
+#include "SphericalHarmonics.h"
+#include "Texture2D.h"
+#include "TextureReadback.h"
 
 namespace Engine
 {
+// Hillaire-style atmosphere: transmittance, multiple scattering and sky-view LUTs are computed on the GPU when the
+// parameters change, and the sky pass is one lookup into the sky-view LUT. CPU copies of the transmittance and
+// sky-view LUTs give the sun colour for the directional light and the ambient SH; they are read back without
+// stalling and trail the LUTs by a frame or two.
 class ProceduralSky
 {
   public:
@@ -13,6 +22,15 @@ class ProceduralSky
 
     glm::vec3 GetSunDirection() const { return SunDirection; };
 
+    // regenerates whatever depends on a parameter that changed since the last call
+    void UpdateLUTs();
+
+    // linear sky radiance (before the display encoding the sky pass applies), from the sky-view LUT
+    glm::vec3 GetRadiance(const glm::vec3 &direction) const;
+    // transmittance from the viewer towards the sun, the colour of the sunlight reaching the ground
+    glm::vec3 GetSunColor() const { return m_SunColor; }
+    const SH9 &GetIrradianceSH();
+
   public:
     float SurfaceRadius = 6360e3f;
     float AtmosphereRadius = 6380e3f;
@@ -22,6 +40,45 @@ class ProceduralSky
 
     glm::vec3 CenterPoint = glm::vec3(0.f, -SurfaceRadius, 0.f);
     glm::vec3 SunDirection = glm::vec3(0.20000f, 0.95917f, 0.20000f);
+
+  private:
+    // what the transmittance and multiple scattering LUTs depend on
+    struct AtmosphereParameters
+    {
+        float SurfaceRadius, AtmosphereRadius;
+        glm::vec3 RayleighScattering, MieScattering;
+        glm::vec3 CenterPoint;
+
+        bool operator==(const AtmosphereParameters &) const = default;
+    };
+
+    // ...and what only the sky-view LUT does
+    struct SunParameters
+    {
+        glm::vec3 SunDirection;
+        float SunIntensity;
+
+        bool operator==(const SunParameters &) const = default;
+    };
+
+    void SetAtmosphereUniforms(Shader &shader) const;
+    void GenerateLUTs(const SunParameters &sun, float viewHeight, bool atmosphereChanged);
+
+  private:
+    static constexpr uint32_t TransmittanceWidth = 256, TransmittanceHeight = 64;
+    static constexpr uint32_t MultiScatteringSize = 32;
+    static constexpr uint32_t SkyViewWidth = 192, SkyViewHeight = 108;
+
+    Texture2DRef m_TransmittanceLUT, m_MultiScatteringLUT, m_SkyViewLUT;
+    std::vector<glm::vec4> m_TransmittanceData, m_SkyViewData;
+    TextureReadback m_TransmittanceReadback, m_SkyViewReadback;
+
+    AtmosphereParameters m_AtmosphereParameters{};
+    SunParameters m_SunParameters{};
+    glm::vec3 m_SunColor = glm::vec3(1.0f);
+
+    SH9 m_IrradianceSH;
+    bool m_IrradianceSHDirty = true;
 };
 using ProceduralSkyRef = std::shared_ptr<ProceduralSky>;
 } // namespace Engine
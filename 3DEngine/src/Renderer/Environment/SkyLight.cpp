@@ -3,39 +3,197 @@
 #include <glad/glad.h>
 
 #include "Shader.h"
+#include "RenderCommand.h"
 #include "InputManager.h"
 #include "AssetManager.h"
 #include "ShaderManager.h"
 #include "TextureHDRI.h"
 #include "HDRIImporter.h"
+#include "Project.h"
+#include "MemoryTracker.h"
+#include "VirtualFileSystem.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
 
 namespace Engine
 {
+namespace Utils
+{
+// cooked IBL maps: this header, then the environment, irradiance and prefilter cubemaps, each as its size and mip
+// count followed by every mip of every face in RGB half floats
+constexpr uint32_t IBLCacheMagic = 0x4C424943; // "CIBL"
+constexpr uint32_t IBLCacheVersion = 1;
+
+struct IBLCacheHeader
+{
+    uint32_t Magic = IBLCacheMagic;
+    uint32_t Version = IBLCacheVersion;
+    uint64_t SourceHash = 0;
+    uint64_t Resolution = 0;
+};
+
+// 64-bit FNV-1a over the file contents
+static uint64_t HashFile(const std::filesystem::path &path)
+{
+    FileMapping file = VirtualFileSystem::Open(path);
+    uint64_t hash = 14695981039346656037ull;
+
+    const uint8_t *data = file.GetData();
+    for (uint64_t i = 0; i < file.GetSize(); i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint32_t GetMipCount(uint32_t size) { return (uint32_t)std::floor(std::log2(std::max(size, 1u))) + 1; }
+
+// six faces of RGB16F, which the driver pads to four halves per texel
+static size_t GetCubemapBytes(uint32_t size, uint32_t mipCount)
+{
+    size_t bytes = 0;
+    for (uint32_t mip = 0; mip < mipCount; mip++)
+    {
+        const size_t mipSize = std::max(size >> mip, 1u);
+        bytes += mipSize * mipSize * 6 * 8;
+    }
+    return bytes;
+}
+
+static void WriteCubemap(std::ofstream &stream, unsigned int texture, uint32_t size, uint32_t mipCount)
+{
+    stream.write((const char *)&size, sizeof(size));
+    stream.write((const char *)&mipCount, sizeof(mipCount));
+
+    std::vector<uint16_t> pixels((size_t)size * size * 3);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    for (uint32_t mip = 0; mip < mipCount; mip++)
+    {
+        const uint32_t mipSize = std::max(size >> mip, 1u);
+        for (uint32_t face = 0; face < 6; face++)
+        {
+            glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, GL_RGB, GL_HALF_FLOAT, pixels.data());
+            stream.write((const char *)pixels.data(), (size_t)mipSize * mipSize * 3 * sizeof(uint16_t));
+        }
+    }
+}
+
+// uploads the mips straight from the mapped cache and moves cursor past them
+static unsigned int ReadCubemap(const uint8_t *&cursor, const uint8_t *end)
+{
+    uint32_t size = 0, mipCount = 0;
+    if (end - cursor < (ptrdiff_t)(sizeof(size) + sizeof(mipCount))) return 0;
+    memcpy(&size, cursor, sizeof(size));
+    memcpy(&mipCount, cursor + sizeof(size), sizeof(mipCount));
+    cursor += sizeof(size) + sizeof(mipCount);
+    if (size == 0 || mipCount == 0 || mipCount > GetMipCount(size)) return 0;
+
+    uint64_t pixelBytes = 0;
+    for (uint32_t mip = 0; mip < mipCount; mip++)
+    {
+        const uint64_t mipSize = std::max(size >> mip, 1u);
+        pixelBytes += mipSize * mipSize * 3 * sizeof(uint16_t) * 6;
+    }
+    if ((uint64_t)(end - cursor) < pixelBytes) return 0;
+
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, mipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    // only the stored mips exist, so keep the texture complete without the rest of the chain
+    glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAX_LEVEL, mipCount - 1);
+
+    for (uint32_t mip = 0; mip < mipCount; mip++)
+    {
+        const uint32_t mipSize = std::max(size >> mip, 1u);
+        for (uint32_t face = 0; face < 6; face++)
+        {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, mip, GL_RGB16F, mipSize, mipSize, 0, GL_RGB,
+                         GL_HALF_FLOAT, cursor);
+            cursor += (size_t)mipSize * mipSize * 3 * sizeof(uint16_t);
+        }
+    }
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, texture, GetCubemapBytes(size, mipCount));
+    return texture;
+}
+} // namespace Utils
+
 // TODO: Allow blurring of cubemap
 void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t resolution)
 {
     glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
     SetupCube();
 
+    m_Shaders["cubemap"] =
+        std::make_shared<Shader>("Resources/shaders/cubemapBg.vert", "Resources/shaders/cubemapBg.frag");
+    m_Shaders["cubemap"]->SetUniform1i("environmentMap", 0);
+
+    // the LUT only depends on the BRDF, so every sky light shares one
+    if (s_BrdfLUT == 0) GenerateBrdfLUT();
+    m_BrdfLUT = s_BrdfLUT;
+
+    std::filesystem::path cachePath;
+    uint64_t hash = 0;
+    if (Project::GetActive())
+    {
+        hash = Utils::HashFile(hdrPath);
+        cachePath = Project::GetCacheDirectory() / "IBL" /
+                    fmt::format("{}_{:016x}_{}.ibl", hdrPath.stem().string(), hash, resolution);
+
+    }
+
+    if (cachePath.empty() || !LoadCache(cachePath, hash, resolution))
+    {
+        if (!Bake(hdrPath, resolution)) return;
+        if (!cachePath.empty()) SaveCache(cachePath, hash, resolution);
+
+        auto windowSize = InputManager::Instance().GetWindowState();
+        glViewport(0, 0, windowSize.Width, windowSize.Height);
+    }
+
+    ProjectIrradianceSH(resolution);
+}
+
+void SkyLight::ProjectIrradianceSH(const std::size_t resolution)
+{
+    // SH9 only holds low frequencies, so a small mip of the environment is plenty
+    const uint32_t level = std::max(0, (int)Utils::GetMipCount(resolution) - 7);
+    const uint32_t size = std::max<uint32_t>(resolution >> level, 1);
+
+    std::array<std::vector<glm::vec3>, 6> faces;
+    glBindTexture(GL_TEXTURE_CUBE_MAP, m_EnvCubemap);
+    for (uint32_t face = 0; face < 6; face++)
+    {
+        faces[face].resize((size_t)size * size);
+        glGetTexImage(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, level, GL_RGB, GL_FLOAT, faces[face].data());
+    }
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    m_IrradianceSH = SphericalHarmonics::ConvolveCosine(SphericalHarmonics::ProjectCubemap(faces, size));
+}
+
+bool SkyLight::Bake(const std::filesystem::path &hdrPath, const std::size_t resolution)
+{
 	TextureHDRIRef hdrTexture = HDRIImporter::LoadHDRI(hdrPath);
-    if (hdrTexture == nullptr) return;
+    if (hdrTexture == nullptr) return false;
 
     m_Shaders["equirectangularToCubemap"] =
         std::make_shared<Shader>("Resources/shaders/cubemap.vert", "Resources/shaders/cubemapConverter.frag");
-    m_Shaders["cubemap"] =
-        std::make_shared<Shader>("Resources/shaders/cubemapBg.vert", "Resources/shaders/cubemapBg.frag");
     m_Shaders["irradiance"] =
         std::make_shared<Shader>("Resources/shaders/cubemap.vert", "Resources/shaders/irradianceConvolution.frag");
     m_Shaders["prefilter"] =
         std::make_shared<Shader>("Resources/shaders/cubemap.vert", "Resources/shaders/prefilter.frag");
-    m_Shaders["brdf"] = std::make_shared<Shader>("Resources/shaders/brdf.vert", "Resources/shaders/brdf.frag");
-
-    m_Shaders["cubemap"]->SetUniform1i("environmentMap", 0);
 
     auto equirectangularToCubemapShader = m_Shaders["equirectangularToCubemap"];
     auto irradianceShader = m_Shaders["irradiance"];
     auto prefilterShader = m_Shaders["prefilter"];
-    auto brdfShader = m_Shaders["brdf"];
 
     unsigned int captureFBO, captureRBO;
     glGenFramebuffers(1, &captureFBO);
@@ -44,6 +202,7 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
     glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, resolution, resolution);
+    MemoryTracker::TrackGPU(GPUMemoryType::Renderbuffers, captureRBO, resolution * resolution * 4);
     glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, captureRBO);
 
     glGenTextures(1, &m_EnvCubemap);
@@ -89,6 +248,7 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
         RenderCube(); // renders a 1x1 cube
     }
     auto textureId = hdrTexture->GetRendererID();
+    MemoryTracker::UntrackGPU(GPUMemoryType::Textures, textureId);
     glDeleteTextures(1, &textureId);
     equirectangularToCubemapShader->Delete();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -101,6 +261,8 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     // Generate mipmaps from first mip face (again to reduce bright dots)
     glBindTexture(GL_TEXTURE_CUBE_MAP, m_EnvCubemap);
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, m_EnvCubemap,
+                            Utils::GetCubemapBytes(resolution, Utils::GetMipCount(resolution)));
 
     // create an irradiance cubemap, and re-scale capture FBO to irradiance scale.
     glGenTextures(1, &m_IrradianceMap);
@@ -115,6 +277,7 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, m_IrradianceMap, Utils::GetCubemapBytes(resolution / 16, 1));
 
     glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
     glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
@@ -162,6 +325,8 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
     glGenerateMipmap(GL_TEXTURE_CUBE_MAP);
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, m_PreFilterMap,
+                            Utils::GetCubemapBytes(resolution / 4, Utils::GetMipCount(resolution / 4)));
 
     prefilterShader->Bind();
     prefilterShader->SetUniform1i("environmentMap", 0);
@@ -171,7 +336,7 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     glBindTexture(GL_TEXTURE_CUBE_MAP, m_EnvCubemap);
 
     glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    const unsigned int maxMipLevels = 5;
+    const unsigned int maxMipLevels = PrefilterMipLevels;
     for (unsigned int mipLevel = 0; mipLevel < maxMipLevels; ++mipLevel)
     {
         const unsigned int mipWidth = (resolution / 4) * std::pow(0.5f, mipLevel);
@@ -197,39 +362,106 @@ void SkyLight::Init(const std::filesystem::path &hdrPath, const std::size_t reso
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
 
-    /*---------------------------------------------------------------------------------------------------------------------------------------------*/
-    /*---------------------------------------------------------------------------------------------------------------------------------------------*/
-    /*---------------------------------------------------------------------------------------------------------------------------------------------*/
-    /*---------------------------------------------------------------------------------------------------------------------------------------------*/
+    MemoryTracker::UntrackGPU(GPUMemoryType::Renderbuffers, captureRBO);
+    glDeleteRenderbuffers(1, &captureRBO);
+    glDeleteFramebuffers(1, &captureFBO);
+    return true;
+}
 
-    // generate 2D LUT from BRDF equations
-    glGenTextures(1, &m_BrdfLUT);
-    glBindTexture(GL_TEXTURE_2D, m_BrdfLUT);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, resolution, resolution, 0, GL_RG, GL_FLOAT, nullptr);
+void SkyLight::GenerateBrdfLUT()
+{
+    auto brdfShader = std::make_shared<Shader>("Resources/shaders/brdf.vert", "Resources/shaders/brdf.frag");
+
+    glGenTextures(1, &s_BrdfLUT);
+    glBindTexture(GL_TEXTURE_2D, s_BrdfLUT);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, BrdfLUTSize, BrdfLUTSize, 0, GL_RG, GL_FLOAT, nullptr);
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, s_BrdfLUT, BrdfLUTSize * BrdfLUTSize * 4);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Reconfigure capture framebuffer object and render screen-space quad with BRDF shader
+    // render a screen-space quad with the BRDF shader into the LUT
+    unsigned int captureFBO;
+    glGenFramebuffers(1, &captureFBO);
     glBindFramebuffer(GL_FRAMEBUFFER, captureFBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, captureRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, resolution, resolution);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_BrdfLUT, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, s_BrdfLUT, 0);
 
     brdfShader->Bind();
-    glViewport(0, 0, resolution, resolution);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glViewport(0, 0, BrdfLUTSize, BrdfLUTSize);
+    glClear(GL_COLOR_BUFFER_BIT);
     RenderQuad();
 
     brdfShader->Delete();
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glDeleteFramebuffers(1, &captureFBO);
     glBindTexture(GL_TEXTURE_2D, 0);
 
     auto windowSize = InputManager::Instance().GetWindowState();
     glViewport(0, 0, windowSize.Width, windowSize.Height);
 }
 
+bool SkyLight::LoadCache(const std::filesystem::path &cachePath, uint64_t hash, const std::size_t resolution)
+{
+    // the cooked maps are uploaded in place, nothing is copied on the way
+    FileMapping file(cachePath);
+    if (!file) return false;
+
+    Utils::IBLCacheHeader header;
+    if (file.GetSize() >= sizeof(header)) memcpy(&header, file.GetData(), sizeof(header));
+    if (file.GetSize() < sizeof(header) || header.Magic != Utils::IBLCacheMagic ||
+        header.Version != Utils::IBLCacheVersion || header.SourceHash != hash || header.Resolution != resolution)
+    {
+        LOG_CORE_WARN("SkyLight::LoadCache - Ignoring stale IBL cache: {}", cachePath.string());
+        return false;
+    }
+
+    const uint8_t *cursor = file.GetData() + sizeof(header);
+    const uint8_t *end = file.GetData() + file.GetSize();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    m_EnvCubemap = Utils::ReadCubemap(cursor, end);
+    m_IrradianceMap = Utils::ReadCubemap(cursor, end);
+    m_PreFilterMap = Utils::ReadCubemap(cursor, end);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+
+    if (m_EnvCubemap && m_IrradianceMap && m_PreFilterMap) return true;
+
+    LOG_CORE_WARN("SkyLight::LoadCache - Truncated IBL cache: {}", cachePath.string());
+    for (unsigned int texture : {m_EnvCubemap, m_IrradianceMap, m_PreFilterMap})
+        MemoryTracker::UntrackGPU(GPUMemoryType::Textures, texture);
+    glDeleteTextures(1, &m_EnvCubemap);
+    glDeleteTextures(1, &m_IrradianceMap);
+    glDeleteTextures(1, &m_PreFilterMap);
+    m_EnvCubemap = m_IrradianceMap = m_PreFilterMap = 0;
+    return false;
+}
+
+void SkyLight::SaveCache(const std::filesystem::path &cachePath, uint64_t hash, const std::size_t resolution)
+{
+    std::error_code error;
+    std::filesystem::create_directories(cachePath.parent_path(), error);
+
+    std::ofstream stream(cachePath, std::ios::binary);
+    if (!stream)
+    {
+        LOG_CORE_WARN("SkyLight::SaveCache - Could not write IBL cache: {}", cachePath.string());
+        return;
+    }
+
+    Utils::IBLCacheHeader header;
+    header.SourceHash = hash;
+    header.Resolution = resolution;
+    stream.write((const char *)&header, sizeof(header));
+
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    Utils::WriteCubemap(stream, m_EnvCubemap, resolution, Utils::GetMipCount(resolution));
+    Utils::WriteCubemap(stream, m_IrradianceMap, resolution / 16, 1);
+    Utils::WriteCubemap(stream, m_PreFilterMap, resolution / 4, PrefilterMipLevels);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
+}
+
 void SkyLight::Destroy()
 {
     glActiveTexture(GL_TEXTURE0);
@@ -249,12 +481,9 @@ void SkyLight::Render(const glm::mat4 &projection, const glm::mat4 &view)
 
 void SkyLight::BindMaps(int slot) const
 {
-    glActiveTexture(0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_IrradianceMap);
-    glActiveTexture(1);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, m_PreFilterMap);
-    glActiveTexture(2);
-    glBindTexture(GL_TEXTURE_2D, m_BrdfLUT);
+    RenderCommand::BindTexture(0, m_IrradianceMap, RendererEnum::TEXTURE_CUBE_MAP);
+    RenderCommand::BindTexture(1, m_PreFilterMap, RendererEnum::TEXTURE_CUBE_MAP);
+    RenderCommand::BindTexture(2, m_BrdfLUT);
 }
 
 void SkyLight::UnBindMaps() const
@@ -11,6 +11,7 @@
 #include "Camera.h"
 #include "Asset.h"
 #include "Log.h"
+#include "SphericalHarmonics.h"
 
 namespace Engine
 {
@@ -28,6 +29,7 @@ class SkyLight  : public Asset
     unsigned int GetIrradianceMap() { return m_IrradianceMap; }
     unsigned int GetPrefilterMap() { return m_PreFilterMap; }
     unsigned int GetBrdfLUT() { return m_BrdfLUT; }
+    const SH9 &GetIrradianceSH() const { return m_IrradianceSH; }
     const std::unordered_map<std::string, ShaderPtr> &GetShaders() { return m_Shaders; }
 
     AssetHandle GetHandle() const { 
@@ -43,6 +45,12 @@ class SkyLight  : public Asset
     virtual AssetType GetType() const override { return GetStaticType(); }
 
   private:
+    bool Bake(const std::filesystem::path &hdrPath, const std::size_t resolution);
+    void GenerateBrdfLUT();
+    void ProjectIrradianceSH(const std::size_t resolution);
+    bool LoadCache(const std::filesystem::path &cachePath, uint64_t hash, const std::size_t resolution);
+    void SaveCache(const std::filesystem::path &cachePath, uint64_t hash, const std::size_t resolution);
+
     void SetupCube();
     void RenderCube();
     void RenderQuad();
@@ -52,11 +60,16 @@ class SkyLight  : public Asset
     unsigned int m_IrradianceMap = 0;
     unsigned int m_PreFilterMap = 0;
     unsigned int m_BrdfLUT = 0;
+    SH9 m_IrradianceSH;
 
     VertexArray m_CubeVAO{};
     VertexArray m_QuadVAO{};
 
     std::unordered_map<std::string, ShaderPtr> m_Shaders;
+
+    static constexpr unsigned int PrefilterMipLevels = 5;
+    static constexpr unsigned int BrdfLUTSize = 512;
+    inline static unsigned int s_BrdfLUT = 0;
 };
 
 using SkyLightRef = std::shared_ptr<SkyLight>;
@@ -0,0 +1,263 @@
+#include "SphericalHarmonics.h"
+
+#include "JobSystem.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define ENGINE_SH_SSE 1
+#include <xmmintrin.h>
+#endif
+
+namespace Engine
+{
+namespace Utils
+{
+// samples in structure-of-arrays layout so four of them fit one SSE register per component
+struct SHSamples
+{
+    std::vector<float> X, Y, Z, Weight, R, G, B;
+
+    void Resize(size_t count)
+    {
+        for (auto *channel : {&X, &Y, &Z, &Weight, &R, &G, &B})
+            channel->resize(count);
+    }
+};
+
+static void EvaluateBasis(float x, float y, float z, float basis[9])
+{
+    basis[0] = 0.282095f;
+    basis[1] = 0.488603f * y;
+    basis[2] = 0.488603f * z;
+    basis[3] = 0.488603f * x;
+    basis[4] = 1.092548f * x * y;
+    basis[5] = 1.092548f * y * z;
+    basis[6] = 0.315392f * (3.0f * z * z - 1.0f);
+    basis[7] = 1.092548f * x * z;
+    basis[8] = 0.546274f * (x * x - y * y);
+}
+
+static void AccumulateScalar(const SHSamples &samples, size_t begin, size_t end, SH9 &sh)
+{
+    float basis[9];
+    for (size_t i = begin; i < end; i++)
+    {
+        EvaluateBasis(samples.X[i], samples.Y[i], samples.Z[i], basis);
+        const glm::vec3 radiance = glm::vec3(samples.R[i], samples.G[i], samples.B[i]) * samples.Weight[i];
+        for (int k = 0; k < 9; k++)
+            sh.Coefficients[k] += radiance * basis[k];
+    }
+}
+
+static void Accumulate(const SHSamples &samples, SH9 &sh)
+{
+    const size_t count = samples.X.size();
+    size_t i = 0;
+
+#ifdef ENGINE_SH_SSE
+    __m128 sum[27];
+    for (auto &lane : sum)
+        lane = _mm_setzero_ps();
+
+    const __m128 k0 = _mm_set1_ps(0.282095f), k1 = _mm_set1_ps(0.488603f), k2 = _mm_set1_ps(1.092548f);
+    const __m128 k3 = _mm_set1_ps(0.315392f), k4 = _mm_set1_ps(0.546274f), three = _mm_set1_ps(3.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128 x = _mm_loadu_ps(&samples.X[i]), y = _mm_loadu_ps(&samples.Y[i]);
+        const __m128 z = _mm_loadu_ps(&samples.Z[i]), w = _mm_loadu_ps(&samples.Weight[i]);
+        const __m128 r = _mm_mul_ps(_mm_loadu_ps(&samples.R[i]), w);
+        const __m128 g = _mm_mul_ps(_mm_loadu_ps(&samples.G[i]), w);
+        const __m128 b = _mm_mul_ps(_mm_loadu_ps(&samples.B[i]), w);
+
+        const __m128 basis[9] = {
+            k0,
+            _mm_mul_ps(k1, y),
+            _mm_mul_ps(k1, z),
+            _mm_mul_ps(k1, x),
+            _mm_mul_ps(k2, _mm_mul_ps(x, y)),
+            _mm_mul_ps(k2, _mm_mul_ps(y, z)),
+            _mm_mul_ps(k3, _mm_sub_ps(_mm_mul_ps(three, _mm_mul_ps(z, z)), one)),
+            _mm_mul_ps(k2, _mm_mul_ps(x, z)),
+            _mm_mul_ps(k4, _mm_sub_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))),
+        };
+
+        for (int k = 0; k < 9; k++)
+        {
+            sum[k * 3 + 0] = _mm_add_ps(sum[k * 3 + 0], _mm_mul_ps(basis[k], r));
+            sum[k * 3 + 1] = _mm_add_ps(sum[k * 3 + 1], _mm_mul_ps(basis[k], g));
+            sum[k * 3 + 2] = _mm_add_ps(sum[k * 3 + 2], _mm_mul_ps(basis[k], b));
+        }
+    }
+
+    alignas(16) float lanes[4];
+    for (int k = 0; k < 27; k++)
+    {
+        _mm_store_ps(lanes, sum[k]);
+        sh.Coefficients[k / 3][k % 3] += lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+
+    AccumulateScalar(samples, i, count, sh);
+}
+
+// runs job(0..jobCount-1) on the job system, the calling thread helps
+static void RunParallel(uint32_t jobCount, const std::function<void(uint32_t)> &job)
+{
+    JobSystem::ParallelFor(jobCount, 1,
+                           [&job](size_t begin, size_t end)
+                           {
+                               for (size_t i = begin; i < end; i++)
+                                   job((uint32_t)i);
+                           });
+}
+
+static uint32_t GetJobCount(uint32_t sampleCount)
+{
+    // below a few hundred samples per job the scheduling costs more than it saves
+    const uint32_t maxJobs = std::max(1u, sampleCount / 256);
+    return std::clamp(JobSystem::GetWorkerCount() + 1, 1u, maxJobs);
+}
+
+static SH9 Sum(const std::vector<SH9> &partials, float scale)
+{
+    SH9 result;
+    for (const auto &partial : partials)
+        for (int k = 0; k < 9; k++)
+            result.Coefficients[k] += partial.Coefficients[k];
+
+    for (auto &coefficient : result.Coefficients)
+        coefficient *= scale;
+    return result;
+}
+} // namespace Utils
+
+SH9 SphericalHarmonics::ProjectSphere(const RadianceFunc &radiance, uint32_t sampleCount)
+{
+    const uint32_t jobCount = Utils::GetJobCount(sampleCount);
+    std::vector<SH9> partials(jobCount);
+
+    // Fibonacci sphere: evenly spread directions, each standing for the same solid angle
+    const float goldenAngle = glm::pi<float>() * (3.0f - std::sqrt(5.0f));
+    Utils::RunParallel(jobCount,
+                       [&](uint32_t job)
+                       {
+                           const uint32_t begin = (uint64_t)sampleCount * job / jobCount;
+                           const uint32_t end = (uint64_t)sampleCount * (job + 1) / jobCount;
+
+                           Utils::SHSamples samples;
+                           samples.Resize(end - begin);
+                           for (uint32_t i = begin; i < end; i++)
+                           {
+                               const float z = 1.0f - (2.0f * i + 1.0f) / sampleCount;
+                               const float r = std::sqrt(std::max(0.0f, 1.0f - z * z));
+                               const float phi = goldenAngle * i;
+                               const glm::vec3 direction(r * std::cos(phi), r * std::sin(phi), z);
+                               const glm::vec3 color = radiance(direction);
+
+                               const uint32_t s = i - begin;
+                               samples.X[s] = direction.x;
+                               samples.Y[s] = direction.y;
+                               samples.Z[s] = direction.z;
+                               samples.Weight[s] = 1.0f;
+                               samples.R[s] = color.r;
+                               samples.G[s] = color.g;
+                               samples.B[s] = color.b;
+                           }
+                           Utils::Accumulate(samples, partials[job]);
+                       });
+
+    return Utils::Sum(partials, 4.0f * glm::pi<float>() / sampleCount);
+}
+
+SH9 SphericalHarmonics::ProjectCubemap(const std::array<std::vector<glm::vec3>, 6> &faces, uint32_t size)
+{
+    std::vector<SH9> partials(6);
+    float weights[6] = {};
+
+    Utils::RunParallel(6,
+                       [&](uint32_t face)
+                       {
+                           Utils::SHSamples samples;
+                           samples.Resize((size_t)size * size);
+                           if (faces[face].size() < (size_t)size * size) return;
+
+                           for (uint32_t t = 0; t < size; t++)
+                           {
+                               for (uint32_t s = 0; s < size; s++)
+                               {
+                                   const float u = 2.0f * (s + 0.5f) / size - 1.0f;
+                                   const float v = 2.0f * (t + 0.5f) / size - 1.0f;
+
+                                   glm::vec3 direction;
+                                   switch (face)
+                                   {
+                                       case 0: direction = glm::vec3(1.0f, -v, -u); break;
+                                       case 1: direction = glm::vec3(-1.0f, -v, u); break;
+                                       case 2: direction = glm::vec3(u, 1.0f, v); break;
+                                       case 3: direction = glm::vec3(u, -1.0f, -v); break;
+                                       case 4: direction = glm::vec3(u, -v, 1.0f); break;
+                                       default: direction = glm::vec3(-u, -v, -1.0f); break;
+                                   }
+
+                                   // solid angle of the texel, up to the (2 / size)^2 every texel shares
+                                   const float lengthSq = glm::dot(direction, direction);
+                                   const float weight = 1.0f / (lengthSq * std::sqrt(lengthSq));
+                                   direction *= 1.0f / std::sqrt(lengthSq);
+
+                                   const size_t i = (size_t)t * size + s;
+                                   const glm::vec3 &color = faces[face][i];
+                                   samples.X[i] = direction.x;
+                                   samples.Y[i] = direction.y;
+                                   samples.Z[i] = direction.z;
+                                   samples.Weight[i] = weight;
+                                   samples.R[i] = color.r;
+                                   samples.G[i] = color.g;
+                                   samples.B[i] = color.b;
+                                   weights[face] += weight;
+                               }
+                           }
+                           Utils::Accumulate(samples, partials[face]);
+                       });
+
+    // normalise the summed weights to the full sphere instead of trusting the texel approximation
+    float totalWeight = 0.0f;
+    for (float weight : weights)
+        totalWeight += weight;
+
+    return Utils::Sum(partials, totalWeight > 0.0f ? 4.0f * glm::pi<float>() / totalWeight : 0.0f);
+}
+
+SH9 SphericalHarmonics::ConvolveCosine(const SH9 &radiance)
+{
+    // clamped cosine lobe per band (pi, 2pi/3, pi/4), divided by pi
+    constexpr float bands[9] = {1.0f, 2.0f / 3.0f, 2.0f / 3.0f, 2.0f / 3.0f, 0.25f, 0.25f, 0.25f, 0.25f, 0.25f};
+
+    SH9 irradiance;
+    for (int k = 0; k < 9; k++)
+        irradiance.Coefficients[k] = radiance.Coefficients[k] * bands[k];
+    return irradiance;
+}
+
+SH9 SphericalHarmonics::Constant(const glm::vec3 &radiance)
+{
+    SH9 sh;
+    sh.Coefficients[0] = radiance / 0.282095f;
+    return sh;
+}
+
+glm::vec3 SphericalHarmonics::Evaluate(const SH9 &sh, const glm::vec3 &direction)
+{
+    float basis[9];
+    Utils::EvaluateBasis(direction.x, direction.y, direction.z, basis);
+
+    glm::vec3 result(0.0f);
+    for (int k = 0; k < 9; k++)
+        result += sh.Coefficients[k] * basis[k];
+    return result;
+}
+} // namespace Engine
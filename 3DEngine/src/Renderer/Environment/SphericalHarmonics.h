@@ -0,0 +1,36 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <functional>
+#include <vector>
+
+namespace Engine
+{
+// Order 2 (9 coefficient) spherical harmonics of an RGB signal over the sphere
+struct SH9
+{
+    std::array<glm::vec3, 9> Coefficients{};
+};
+
+// Projects sky radiance into SH9 on the CPU. Samples are split over a few threads and each thread accumulates
+// four samples at a time with SSE. The results of ProjectSphere/ProjectCubemap are radiance; ConvolveCosine turns
+// them into irradiance, pre-divided by pi so that Evaluate gives what the convolved irradiance cubemap stores.
+class SphericalHarmonics
+{
+  public:
+    using RadianceFunc = std::function<glm::vec3(const glm::vec3 &direction)>;
+
+    // radiance is called once per sample direction, from several threads at once
+    static SH9 ProjectSphere(const RadianceFunc &radiance, uint32_t sampleCount = 2048);
+    // faces in GL order (+X, -X, +Y, -Y, +Z, -Z), each size * size RGB texels with row 0 at t = 0
+    static SH9 ProjectCubemap(const std::array<std::vector<glm::vec3>, 6> &faces, uint32_t size);
+
+    static SH9 ConvolveCosine(const SH9 &radiance);
+    // irradiance SH of a constant radiance
+    static SH9 Constant(const glm::vec3 &radiance);
+
+    static glm::vec3 Evaluate(const SH9 &sh, const glm::vec3 &direction);
+};
+} // namespace Engine
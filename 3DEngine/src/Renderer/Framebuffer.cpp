@@ -1,7 +1,7 @@
 #include "Framebuffer.h"
 
-#include <glad/glad.h>
 #include "Log.h"
+#include "RenderCommand.h"
 
 namespace Engine
 {
@@ -11,22 +11,19 @@ Framebuffer::Framebuffer(bool hasRenderBuffer, glm::vec2 size)
     m_Size = size;
     m_HasRenderBuffer = hasRenderBuffer;
 
-    glGenFramebuffers(1, &m_FramebufferID);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+    m_FramebufferID = RenderCommand::CreateFramebuffer();
+    RenderCommand::BindFramebuffer(m_FramebufferID);
 
     // Create render buffer and attach to frame buffer.
     if (m_HasRenderBuffer)
     {
-        glGenRenderbuffers(1, &m_RenderBuffer);
-        glBindRenderbuffer(GL_RENDERBUFFER, m_RenderBuffer);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Size.x, m_Size.y);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_RenderBuffer);
+        m_RenderBuffer = RenderCommand::CreateDepthRenderbuffer(m_Size.x, m_Size.y);
     }
     else
         m_RenderBuffer = -1;
 
     // Unbind
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    RenderCommand::BindFramebuffer(0);
 }
 
 Framebuffer::~Framebuffer() {}
@@ -55,29 +52,29 @@ void Framebuffer::SetTexture(Texture2DRef texture, unsigned int attachment)
         size += 1;
     }
 
-    if (size > 0) glDrawBuffers(size, &keys[0]);
+    if (size > 0) RenderCommand::SetDrawBuffers(&keys[0], size);
 
     Unbind();
 }
 
-void Framebuffer::Clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+void Framebuffer::Clear() { RenderCommand::Clear(); }
 
 void Framebuffer::ClearAttachment(uint32_t index, int value)
 {
     //!
-    glClearTexImage(m_Textures[index]->GetRendererID(), 0, GL_RED_INTEGER, GL_INT, &value);
+    RenderCommand::ClearTexture(m_Textures[index]->GetRendererID(), value);
 }
 
 void Framebuffer::Bind()
 {
     if (ResizeQueued) UpdateSize(m_Size);
 
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
-    glViewport(0, 0, m_Size.x, m_Size.y);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    RenderCommand::BindFramebuffer(m_FramebufferID);
+    RenderCommand::SetViewport(0, 0, m_Size.x, m_Size.y);
+    RenderCommand::Clear();
 }
 
-void Framebuffer::Unbind() { glBindFramebuffer(GL_FRAMEBUFFER, 0); }
+void Framebuffer::Unbind() { RenderCommand::BindFramebuffer(0); }
 
 void Framebuffer::QueueResize(glm::vec2 size)
 {
@@ -93,12 +90,12 @@ void Framebuffer::UpdateSize(glm::vec2 size)
     ResizeQueued = false;
 
     // Delete frame buffer and render buffer.
-    glDeleteFramebuffers(1, &m_FramebufferID);
-    if (m_HasRenderBuffer) glDeleteRenderbuffers(1, &m_RenderBuffer);
+    RenderCommand::DeleteFramebuffer(m_FramebufferID);
+    if (m_HasRenderBuffer) RenderCommand::DeleteRenderbuffer(m_RenderBuffer);
 
     // New FBO and RBO.
-    glGenFramebuffers(1, &m_FramebufferID);
-    glBindFramebuffer(GL_FRAMEBUFFER, m_FramebufferID);
+    m_FramebufferID = RenderCommand::CreateFramebuffer();
+    RenderCommand::BindFramebuffer(m_FramebufferID);
 
     // Recreate resized texture.
     for (auto &t : m_Textures)
@@ -111,22 +108,16 @@ void Framebuffer::UpdateSize(glm::vec2 size)
     // TODO: move out render buffer.
     if (m_HasRenderBuffer)
     {
-        glGenRenderbuffers(1, &m_RenderBuffer);
-        glBindRenderbuffer(GL_RENDERBUFFER, m_RenderBuffer);
-        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, m_Size.x, m_Size.y);
-        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_RenderBuffer);
+        m_RenderBuffer = RenderCommand::CreateDepthRenderbuffer(m_Size.x, m_Size.y);
     }
 
     // Unbind.
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    RenderCommand::BindFramebuffer(0);
 }
 
 int Framebuffer::ReadPixel(uint32_t attachment, const glm::vec2 coords)
 {
-    glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment);
-    int pixelData;
-    glReadPixels((int)coords.x, (int)coords.y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
-    return pixelData;
+    return RenderCommand::ReadPixel(attachment, (int)coords.x, (int)coords.y);
 }
 
 void Framebuffer::SetDrawBuffer(unsigned int draw)
@@ -0,0 +1,50 @@
+#include "GPUTimer.h"
+
+#include "RenderCommand.h"
+
+namespace Engine
+{
+GPUTimer::~GPUTimer()
+{
+    if (m_Queries[0] == 0 || RenderCommand::GetRendererAPI() == nullptr) return;
+
+    for (auto query : m_Queries)
+        RenderCommand::DeleteQuery(query);
+}
+
+void GPUTimer::Begin()
+{
+    if (m_Queries[0] == 0)
+        for (auto &query : m_Queries)
+            query = RenderCommand::CreateQuery();
+
+    CollectResults();
+
+    // the GPU is more than QueryCount frames behind, skip this measurement rather than wait
+    m_Active = !m_Pending[m_Current];
+    if (m_Active) RenderCommand::BeginTimerQuery(m_Queries[m_Current]);
+}
+
+void GPUTimer::End()
+{
+    if (!m_Active) return;
+
+    RenderCommand::EndTimerQuery();
+    m_Pending[m_Current] = true;
+    m_Current = (m_Current + 1) % QueryCount;
+    m_Active = false;
+}
+
+void GPUTimer::CollectResults()
+{
+    // oldest first, so the newest finished result is the one that sticks
+    for (uint32_t i = 0; i < QueryCount; i++)
+    {
+        uint32_t index = (m_Current + i) % QueryCount;
+        if (!m_Pending[index] || !RenderCommand::IsQueryResultAvailable(m_Queries[index])) continue;
+
+        m_Time = RenderCommand::GetQueryResult(m_Queries[index]) / 1000000.0f;
+        m_Pending[index] = false;
+    }
+}
+} // namespace Engine
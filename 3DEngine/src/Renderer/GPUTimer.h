@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <stdint.h>
+
+namespace Engine
+{
+// Measures the GPU time of the commands issued between Begin() and End(). Results are read back a few frames
+// later from a small ring of queries so the CPU never stalls waiting on the GPU.
+class GPUTimer
+{
+  public:
+    GPUTimer() = default;
+    ~GPUTimer();
+
+    GPUTimer(const GPUTimer &) = delete;
+    GPUTimer &operator=(const GPUTimer &) = delete;
+
+    void Begin();
+    void End();
+
+    // milliseconds, from the most recent query that has finished
+    float GetTime() const { return m_Time; }
+
+  private:
+    void CollectResults();
+
+  private:
+    static constexpr uint32_t QueryCount = 4;
+
+    std::array<uint32_t, QueryCount> m_Queries{};
+    std::array<bool, QueryCount> m_Pending{};
+    uint32_t m_Current = 0;
+    bool m_Active = false;
+    float m_Time = 0.0f;
+};
+} // namespace Engine
@@ -1,7 +1,5 @@
 #include "InfiniteGrid.h"
 
-#include <glad/glad.h>
-
 #include "ShaderManager.h"
 #include "RenderCommand.h"
 #include "Renderer.h"
@@ -17,7 +15,7 @@ void InfiniteGrid::Init()
 void InfiniteGrid::Draw(glm::mat4 projection, glm::mat4 view, glm::vec3 cameraPos) 
 {
     RenderCommand::Enable(RendererEnum::BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    RenderCommand::SetBlendFunc(RendererEnum::SRC_ALPHA, RendererEnum::ONE_MINUS_SRC_ALPHA);
 
 	Shader *skyShader = ShaderManager::GetShader("Resources/shaders/infiniteGrid");
 	skyShader->Bind();
@@ -9,9 +9,11 @@ void Light::SetLightUniforms(Shader &shader)
     // directional
     if (m_DirectionalLightProps)
     {
-        shader.SetUniform3f("gDirectionalLight.Color",
-                            m_DirectionalLightProps->Color * m_DirectionalLightProps->Intensity);
-        shader.SetUniform3f("gDirectionalLight.Direction", m_DirectionalLightProps->Direction);
+        const bool followSky = m_DirectionalLightProps->FollowSky && m_HasSkySun;
+        const glm::vec3 color = followSky ? m_SkySunColor : m_DirectionalLightProps->Color;
+        shader.SetUniform3f("gDirectionalLight.Color", color * m_DirectionalLightProps->Intensity);
+        shader.SetUniform3f("gDirectionalLight.Direction",
+                            followSky ? m_SkySunDirection : m_DirectionalLightProps->Direction);
     }
     else
     {
@@ -99,6 +101,34 @@ void Light::SetSpotLight(SpotLight *spotlight, int index) { m_SpotLightPropsMap[
 
 void Light::RemoveDirectionalLight() { m_DirectionalLightProps = nullptr; }
 
+LightValues Light::CopyValues() const
+{
+    LightValues values;
+    if (m_DirectionalLightProps) values.Directional = *m_DirectionalLightProps;
+    for (const auto &[index, light] : m_PointLightPropsMap)
+        values.PointLights[index] = light ? std::optional<PointLight>(*light) : std::nullopt;
+    for (const auto &[index, light] : m_SpotLightPropsMap)
+        values.SpotLights[index] = light ? std::optional<SpotLight>(*light) : std::nullopt;
+    return values;
+}
+
+void Light::SetValues(LightValues &values)
+{
+    Reset();
+    m_DirectionalLightProps = values.Directional ? &*values.Directional : nullptr;
+    for (auto &[index, light] : values.PointLights)
+        m_PointLightPropsMap[index] = light ? &*light : nullptr;
+    for (auto &[index, light] : values.SpotLights)
+        m_SpotLightPropsMap[index] = light ? &*light : nullptr;
+}
+
+void Light::SetSkySun(const glm::vec3 &direction, const glm::vec3 &color)
+{
+    m_HasSkySun = true;
+    m_SkySunDirection = direction;
+    m_SkySunColor = color;
+}
+
 void Light::RemovePointLight(int index) { m_PointLightPropsMap[index] = nullptr; }
 
 void Light::RemoveSpotLight(int index) { m_SpotLightPropsMap[index] = nullptr; }
@@ -8,6 +8,7 @@
 #include <memory>
 #include <stdio.h>
 #include <map>
+#include <optional>
 
 #define MAX_POINT_LIGHTS 10
 #define MAX_SPOT_LIGHTS 10
@@ -21,6 +22,8 @@ struct DirectionalLight
     glm::vec3 Direction = {1.0f, 0.0f, 0.0f};
     glm::vec3 Color = {0.0f, 0.0f, 0.0f};
     float Intensity = 1.0f;
+    // take direction and colour from the procedural sky's sun instead
+    bool FollowSky = false;
 };
 
 struct PointLight
@@ -40,6 +43,14 @@ struct SpotLight
     float Intensity = 1.0f;
 };
 
+// copies of the lights a Light points to, e.g. for a RenderSnapshot; disabled lights keep their slot empty
+struct LightValues
+{
+    std::optional<DirectionalLight> Directional;
+    std::map<int, std::optional<PointLight>> PointLights;
+    std::map<int, std::optional<SpotLight>> SpotLights;
+};
+
 class Light
 {
   public:
@@ -54,6 +65,14 @@ class Light
     void SetSpotLight(SpotLight *spotlight, int index);
 
     void RemoveDirectionalLight();
+
+    LightValues CopyValues() const;
+    // points at the given copies, which have to outlive the use of this Light
+    void SetValues(LightValues &values);
+
+    // the sun of the current sky, used by a directional light with FollowSky set
+    void SetSkySun(const glm::vec3 &direction, const glm::vec3 &color);
+    void ClearSkySun() { m_HasSkySun = false; }
     void RemovePointLight(int index);
     void RemoveSpotLight(int index);
 
@@ -64,6 +83,10 @@ class Light
     DirectionalLight *m_DirectionalLightProps = nullptr;
     std::map<int, PointLight *> m_PointLightPropsMap;
     std::map<int, SpotLight *> m_SpotLightPropsMap;
+
+  private:
+    bool m_HasSkySun = false;
+    glm::vec3 m_SkySunDirection = glm::vec3(0.0f), m_SkySunColor = glm::vec3(0.0f);
 };
 
 using LightRef = std::shared_ptr<Light>;
@@ -3,6 +3,7 @@
 #include <fstream>
 
 #include "Log.h"
+#include "VirtualFileSystem.h"
 
 #include <yaml-cpp/yaml.h>
 
@@ -60,7 +61,9 @@ bool MaterialSerializer::Deserialize(const std::filesystem::path &filepath)
     YAML::Node data;
     try
     {
-        data = YAML::LoadFile(filepath.string());
+        FileMapping file = VirtualFileSystem::Open(filepath);
+        MemoryStream stream(file);
+        data = YAML::Load(stream);
     }
     catch (YAML::ParserException e)
     {
@@ -1,6 +1,5 @@
 #include "Mesh.h"
 
-#include <glad/glad.h>
 #include "RenderCommand.h"
 
 namespace Engine
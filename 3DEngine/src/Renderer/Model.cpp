@@ -2,6 +2,8 @@
 
 #include <assimp/scene.h>
 #include <assimp/Importer.hpp>
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
 #include <assimp/postprocess.h>
 
 #include <glm/gtx/quaternion.hpp>
@@ -11,12 +13,78 @@
 #include "Project.h"
 
 #include "Log.h"
+#include "MemoryTracker.h"
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace Engine
 {
+namespace Utils
+{
+// Assimp reads model files, and whatever they reference like .mtl or .bin, through these, so all of it comes from
+// the VirtualFileSystem instead of stdio
+class MappedIOStream : public Assimp::IOStream
+{
+  public:
+    explicit MappedIOStream(FileMapping file) : m_File(std::move(file)) {}
+
+    size_t Read(void *buffer, size_t size, size_t count) override
+    {
+        if (size == 0) return 0;
+        count = std::min<size_t>(count, (m_File.GetSize() - m_Position) / size);
+        memcpy(buffer, m_File.GetData() + m_Position, size * count);
+        m_Position += size * count;
+        return count;
+    }
+
+    size_t Write(const void *, size_t, size_t) override { return 0; }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override
+    {
+        const uint64_t base = origin == aiOrigin_SET ? 0 : origin == aiOrigin_CUR ? m_Position : m_File.GetSize();
+        if (base + offset > m_File.GetSize()) return aiReturn_FAILURE;
+        m_Position = base + offset;
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override { return (size_t)m_Position; }
+    size_t FileSize() const override { return (size_t)m_File.GetSize(); }
+    void Flush() override {}
+
+  private:
+    FileMapping m_File;
+    uint64_t m_Position = 0;
+};
+
+class MappedIOSystem : public Assimp::IOSystem
+{
+  public:
+    bool Exists(const char *path) const override
+    {
+        return VirtualFileSystem::Exists(path);
+    }
+
+    char getOsSeparator() const override { return '/'; }
+
+    Assimp::IOStream *Open(const char *path, const char *mode) override
+    {
+        // read only
+        if (strchr(mode, 'w') || strchr(mode, 'a')) return nullptr;
+
+        FileMapping file = VirtualFileSystem::Open(path);
+        return file ? new MappedIOStream(std::move(file)) : nullptr;
+    }
+
+    void Close(Assimp::IOStream *stream) override { delete stream; }
+};
+} // namespace Utils
+
 Model::Model(const std::filesystem::path &path, const bool flipWindingOrder, const bool loadMaterial)
     : m_Path(path.string())
 {
+    MEMORY_TAG(Assets);
     // auto fullPath = Utils::Path::GetAbsolute(std::string(path));
     if (!LoadModel(path, flipWindingOrder, loadMaterial)) LOG_CORE_ERROR("Failed to load model: {0}", path.string());
 }
@@ -43,6 +111,8 @@ void Model::SetMeshHandle(int id, AssetHandle handle)
 bool Model::LoadModel(const std::filesystem::path &path, const bool flipWindingOrder, const bool loadMaterial)
 {
     Assimp::Importer importer;
+    // the importer owns and deletes it
+    importer.SetIOHandler(new Utils::MappedIOSystem());
     const aiScene *scene = nullptr;
 
     if (flipWindingOrder)
@@ -199,7 +269,13 @@ Mesh Model::ProcessMesh(aiMesh *mesh, const aiScene *scene, const bool loadMater
 std::filesystem::path Model::GetRelativeTexturePath(const aiString &path) const
 {
     if (path.C_Str()[0] != '\0')
-        return std::filesystem::relative(m_Path + path.C_Str(), Project::GetAssetDirectory());
+    {
+        // models imported as assets have virtual paths
+        const std::filesystem::path texturePath = std::filesystem::path(m_Path + path.C_Str()).lexically_normal();
+        if (*texturePath.begin() == Project::AssetMountPoint)
+            return texturePath.lexically_relative(Project::AssetMountPoint);
+        return std::filesystem::relative(texturePath, Project::GetAssetDirectory());
+    }
     else
         return std::filesystem::path();
 }
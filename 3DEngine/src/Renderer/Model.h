@@ -30,7 +30,7 @@ class Model : public Asset
     // destroy all opengl handles for sub-meshes
     void Delete();
 
-    std::vector<Mesh> GetMeshes() { return m_Meshes; }
+    std::vector<Mesh> &GetMeshes() { return m_Meshes; }
 
     virtual AssetType GetType() const override { return AssetType::Mesh; }
 
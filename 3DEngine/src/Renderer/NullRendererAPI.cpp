@@ -0,0 +1,278 @@
+#include "NullRendererAPI.h"
+
+namespace Engine
+{
+void NullRendererAPI::Init()
+{
+    // a frame of a mid-sized scene records a few thousand commands
+    m_Commands.reserve(4096);
+}
+
+void NullRendererAPI::EndFrame() { m_Commands.clear(); }
+
+void NullRendererAPI::ClearCommands()
+{
+    m_Commands.clear();
+    std::fill(std::begin(m_CommandCounts), std::end(m_CommandCounts), 0);
+}
+
+void NullRendererAPI::Record(RecordedCommandType type, uint32_t a, uint32_t b, uint32_t c)
+{
+    m_Commands.push_back({type, {a, b, c}});
+    m_CommandCounts[(size_t)type]++;
+}
+
+void NullRendererAPI::SetViewport(uint32_t, uint32_t, uint32_t width, uint32_t height)
+{
+    Record(RecordedCommandType::SetViewport, width, height);
+}
+
+void NullRendererAPI::SetClearColor(const glm::vec4 &) { Record(RecordedCommandType::SetClearColor); }
+
+void NullRendererAPI::Clear() { Record(RecordedCommandType::Clear); }
+
+void NullRendererAPI::Enable(RendererEnum state) { Record(RecordedCommandType::Enable, (uint32_t)state); }
+
+void NullRendererAPI::Disable(RendererEnum state) { Record(RecordedCommandType::Disable, (uint32_t)state); }
+
+void NullRendererAPI::SetDepthMask(bool write) { Record(RecordedCommandType::SetDepthMask, write); }
+
+void NullRendererAPI::SetColorMask(bool write) { Record(RecordedCommandType::SetColorMask, write); }
+
+void NullRendererAPI::SetDepthFunc(RendererEnum func) { Record(RecordedCommandType::SetDepthFunc, (uint32_t)func); }
+
+void NullRendererAPI::SetBlendFunc(RendererEnum src, RendererEnum dst)
+{
+    Record(RecordedCommandType::SetBlendFunc, (uint32_t)src, (uint32_t)dst);
+}
+
+void NullRendererAPI::DrawElements(RendererEnum mode, int count, RendererEnum, const void *)
+{
+    Record(RecordedCommandType::DrawElements, (uint32_t)mode, count);
+}
+
+void NullRendererAPI::DrawMultiElements(RendererEnum mode, const int *count, RendererEnum, const void *const *,
+                                        unsigned int drawCount)
+{
+    Record(RecordedCommandType::DrawMultiElements, (uint32_t)mode, *count, drawCount);
+}
+
+void NullRendererAPI::DrawArrays(RendererEnum mode, int first, int count)
+{
+    Record(RecordedCommandType::DrawArrays, (uint32_t)mode, first, count);
+}
+
+uint32_t NullRendererAPI::CreateVertexArray()
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateVertexArray, id);
+    return id;
+}
+
+void NullRendererAPI::DeleteVertexArray(uint32_t vao) { Record(RecordedCommandType::DeleteVertexArray, vao); }
+
+void NullRendererAPI::BindVertexArray(uint32_t vao) { Record(RecordedCommandType::BindVertexArray, vao); }
+
+uint32_t NullRendererAPI::CreateBuffer(RendererEnum, int size, const void *, RendererEnum)
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateBuffer, id, size);
+    return id;
+}
+
+void NullRendererAPI::SetBufferSubData(RendererEnum, uint32_t buffer, uint32_t offset, uint32_t size, const void *)
+{
+    Record(RecordedCommandType::SetBufferSubData, buffer, offset, size);
+}
+
+void NullRendererAPI::DeleteBuffer(uint32_t buffer) { Record(RecordedCommandType::DeleteBuffer, buffer); }
+
+void NullRendererAPI::GetBufferData(RendererEnum, uint32_t buffer, uint32_t offset, uint32_t size, void *)
+{
+    Record(RecordedCommandType::GetBufferData, buffer, offset, size);
+}
+
+void NullRendererAPI::SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *)
+{
+    Record(RecordedCommandType::SetVertexAttribute, index, size, stride);
+}
+
+uint32_t NullRendererAPI::CreateTexture2D(ImageFormat, uint32_t width, uint32_t height, RendererEnum, const void *)
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateTexture, id, width, height);
+    return id;
+}
+
+void NullRendererAPI::SetTextureData(uint32_t texture, ImageFormat, uint32_t width, uint32_t height, const void *)
+{
+    Record(RecordedCommandType::SetTextureData, texture, width, height);
+}
+
+void NullRendererAPI::DeleteTexture(uint32_t texture) { Record(RecordedCommandType::DeleteTexture, texture); }
+
+void NullRendererAPI::BindTexture(uint32_t slot, uint32_t texture, RendererEnum target)
+{
+    Record(RecordedCommandType::BindTexture, slot, texture, (uint32_t)target);
+}
+
+void NullRendererAPI::ClearTexture(uint32_t texture, int value)
+{
+    Record(RecordedCommandType::ClearTexture, texture, value);
+}
+
+void NullRendererAPI::ReadTextureData(uint32_t texture, ImageFormat, uint32_t size, void *)
+{
+    Record(RecordedCommandType::ReadTextureData, texture, size);
+}
+
+void NullRendererAPI::ReadTextureDataToBuffer(uint32_t texture, ImageFormat, uint32_t size, uint32_t buffer)
+{
+    Record(RecordedCommandType::ReadTextureData, texture, size, buffer);
+}
+
+uint32_t NullRendererAPI::CreateFramebuffer()
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateFramebuffer, id);
+    return id;
+}
+
+void NullRendererAPI::DeleteFramebuffer(uint32_t framebuffer)
+{
+    Record(RecordedCommandType::DeleteFramebuffer, framebuffer);
+}
+
+void NullRendererAPI::BindFramebuffer(uint32_t framebuffer)
+{
+    Record(RecordedCommandType::BindFramebuffer, framebuffer);
+}
+
+void NullRendererAPI::AttachTexture(uint32_t attachment, uint32_t texture, int mip)
+{
+    Record(RecordedCommandType::AttachTexture, attachment, texture, mip);
+}
+
+void NullRendererAPI::SetDrawBuffers(const uint32_t *, int count)
+{
+    Record(RecordedCommandType::SetDrawBuffers, count);
+}
+
+uint32_t NullRendererAPI::CreateDepthRenderbuffer(uint32_t width, uint32_t height)
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateRenderbuffer, id, width, height);
+    return id;
+}
+
+void NullRendererAPI::DeleteRenderbuffer(uint32_t renderbuffer)
+{
+    Record(RecordedCommandType::DeleteRenderbuffer, renderbuffer);
+}
+
+int NullRendererAPI::ReadPixel(uint32_t attachmentIndex, int x, int y)
+{
+    Record(RecordedCommandType::ReadPixel, attachmentIndex, x, y);
+
+    // entity ids are stored off by one, so 0 reads back as "no entity"
+    return 0;
+}
+
+uint32_t NullRendererAPI::CreateProgram(const std::string &, const std::string &)
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateProgram, id);
+    return id;
+}
+
+void NullRendererAPI::DeleteProgram(uint32_t program) { Record(RecordedCommandType::DeleteProgram, program); }
+
+void NullRendererAPI::UseProgram(uint32_t program) { Record(RecordedCommandType::UseProgram, program); }
+
+int NullRendererAPI::GetUniformLocation(uint32_t, const std::string &name)
+{
+    // Locations only need to be stable and distinct per name, the same way a driver would hand them out.
+    auto it = m_UniformLocations.find(name);
+    if (it != m_UniformLocations.end()) return it->second;
+
+    int location = (int)m_UniformLocations.size();
+    m_UniformLocations[name] = location;
+    return location;
+}
+
+void NullRendererAPI::SetUniform(int location, int) { Record(RecordedCommandType::SetUniform, location); }
+
+void NullRendererAPI::SetUniform(int location, float) { Record(RecordedCommandType::SetUniform, location); }
+
+void NullRendererAPI::SetUniform(int location, const glm::vec2 &)
+{
+    Record(RecordedCommandType::SetUniform, location);
+}
+
+void NullRendererAPI::SetUniform(int location, const glm::vec3 &)
+{
+    Record(RecordedCommandType::SetUniform, location);
+}
+
+void NullRendererAPI::SetUniform(int location, const glm::vec4 &)
+{
+    Record(RecordedCommandType::SetUniform, location);
+}
+
+void NullRendererAPI::SetUniform(int location, const glm::mat3 &)
+{
+    Record(RecordedCommandType::SetUniform, location);
+}
+
+void NullRendererAPI::SetUniform(int location, const glm::mat4 &)
+{
+    Record(RecordedCommandType::SetUniform, location);
+}
+
+uint32_t NullRendererAPI::CreateComputeProgram(const std::string &)
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::CreateComputeProgram, id);
+    return id;
+}
+
+void NullRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    Record(RecordedCommandType::DispatchCompute, groupsX, groupsY, groupsZ);
+}
+
+void NullRendererAPI::BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat, RendererEnum access)
+{
+    Record(RecordedCommandType::BindImageTexture, unit, texture, (uint32_t)access);
+}
+
+void NullRendererAPI::BindBufferBase(RendererEnum target, uint32_t index, uint32_t buffer)
+{
+    Record(RecordedCommandType::BindBufferBase, (uint32_t)target, index, buffer);
+}
+
+void NullRendererAPI::InsertMemoryBarrier() { Record(RecordedCommandType::MemoryBarrier); }
+
+uint32_t NullRendererAPI::CreateQuery() { return NextId(); }
+
+void NullRendererAPI::DeleteQuery(uint32_t) {}
+
+void NullRendererAPI::BeginTimerQuery(uint32_t query) { Record(RecordedCommandType::TimerQuery, query); }
+
+void NullRendererAPI::EndTimerQuery() { Record(RecordedCommandType::TimerQuery); }
+
+bool NullRendererAPI::IsQueryResultAvailable(uint32_t) { return true; }
+
+uint64_t NullRendererAPI::GetQueryResult(uint32_t) { return 0; }
+
+uint32_t NullRendererAPI::CreateFence()
+{
+    uint32_t id = NextId();
+    Record(RecordedCommandType::Fence, id);
+    return id;
+}
+
+void NullRendererAPI::DeleteFence(uint32_t) {}
+
+bool NullRendererAPI::IsFenceSignaled(uint32_t) { return true; }
+} // namespace Engine
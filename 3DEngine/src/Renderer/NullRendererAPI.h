@@ -0,0 +1,172 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine
+{
+enum class RecordedCommandType : uint8_t
+{
+    SetViewport,
+    SetClearColor,
+    Clear,
+    Enable,
+    Disable,
+    SetDepthMask,
+    SetColorMask,
+    SetDepthFunc,
+    SetBlendFunc,
+    DrawElements,
+    DrawMultiElements,
+    DrawArrays,
+    CreateVertexArray,
+    DeleteVertexArray,
+    BindVertexArray,
+    CreateBuffer,
+    SetBufferSubData,
+    DeleteBuffer,
+    GetBufferData,
+    SetVertexAttribute,
+    CreateTexture,
+    SetTextureData,
+    DeleteTexture,
+    BindTexture,
+    ClearTexture,
+    ReadTextureData,
+    CreateFramebuffer,
+    DeleteFramebuffer,
+    BindFramebuffer,
+    AttachTexture,
+    SetDrawBuffers,
+    CreateRenderbuffer,
+    DeleteRenderbuffer,
+    ReadPixel,
+    CreateProgram,
+    DeleteProgram,
+    UseProgram,
+    SetUniform,
+    CreateComputeProgram,
+    DispatchCompute,
+    BindImageTexture,
+    BindBufferBase,
+    MemoryBarrier,
+    TimerQuery,
+    Fence,
+
+    Count
+};
+
+struct RecordedCommand
+{
+    RecordedCommandType Type;
+    uint32_t Args[3] = {0, 0, 0};
+};
+
+// Backend that touches no GPU at all: every call is appended to a command buffer and object creation hands out
+// increasing fake ids. Used to measure the CPU side of the renderer headless, so the buffer only ever holds one
+// frame and a long run only keeps the counts.
+class NullRendererAPI : public RendererAPI
+{
+  public:
+    virtual void Init() override;
+
+    virtual void EndFrame() override;
+
+    // the current frame's commands, EndFrame drops them
+    const std::vector<RecordedCommand> &GetCommands() const { return m_Commands; }
+    // since the last ClearCommands
+    uint32_t GetCommandCount(RecordedCommandType type) const { return m_CommandCounts[(size_t)type]; }
+    void ClearCommands();
+
+  public:
+    virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+    virtual void SetClearColor(const glm::vec4 &color) override;
+    virtual void Clear() override;
+    virtual void Enable(RendererEnum state) override;
+    virtual void Disable(RendererEnum state) override;
+    virtual void SetDepthMask(bool write) override;
+    virtual void SetColorMask(bool write) override;
+    virtual void SetDepthFunc(RendererEnum func) override;
+    virtual void SetBlendFunc(RendererEnum src, RendererEnum dst) override;
+
+    virtual void DrawElements(RendererEnum mode, int count, RendererEnum type, const void *indices) override;
+    virtual void DrawMultiElements(RendererEnum mode, const int *count, RendererEnum type, const void *const *indices,
+                                   unsigned int drawCount) override;
+    virtual void DrawArrays(RendererEnum mode, int first, int count) override;
+
+    virtual uint32_t CreateVertexArray() override;
+    virtual void DeleteVertexArray(uint32_t vao) override;
+    virtual void BindVertexArray(uint32_t vao) override;
+    virtual uint32_t CreateBuffer(RendererEnum target, int size, const void *data, RendererEnum usage) override;
+    virtual void SetBufferSubData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                  const void *data) override;
+    virtual void DeleteBuffer(uint32_t buffer) override;
+    virtual void GetBufferData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                               void *data) override;
+    virtual void SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset) override;
+
+    virtual uint32_t CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height, RendererEnum wrap,
+                                     const void *data = nullptr) override;
+    virtual void SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                                const void *data) override;
+    virtual void DeleteTexture(uint32_t texture) override;
+    virtual void BindTexture(uint32_t slot, uint32_t texture, RendererEnum target) override;
+    virtual void ClearTexture(uint32_t texture, int value) override;
+    virtual void ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data) override;
+    virtual void ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size,
+                                         uint32_t buffer) override;
+
+    virtual uint32_t CreateFramebuffer() override;
+    virtual void DeleteFramebuffer(uint32_t framebuffer) override;
+    virtual void BindFramebuffer(uint32_t framebuffer) override;
+    virtual void AttachTexture(uint32_t attachment, uint32_t texture, int mip = 0) override;
+    virtual void SetDrawBuffers(const uint32_t *attachments, int count) override;
+    virtual uint32_t CreateDepthRenderbuffer(uint32_t width, uint32_t height) override;
+    virtual void DeleteRenderbuffer(uint32_t renderbuffer) override;
+    virtual bool IsFramebufferComplete() override { return true; }
+    virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+    virtual uint32_t CreateProgram(const std::string &vertexSource, const std::string &fragmentSource) override;
+    virtual void DeleteProgram(uint32_t program) override;
+    virtual void UseProgram(uint32_t program) override;
+    virtual int GetUniformLocation(uint32_t program, const std::string &name) override;
+    virtual void SetUniform(int location, int value) override;
+    virtual void SetUniform(int location, float value) override;
+    virtual void SetUniform(int location, const glm::vec2 &value) override;
+    virtual void SetUniform(int location, const glm::vec3 &value) override;
+    virtual void SetUniform(int location, const glm::vec4 &value) override;
+    virtual void SetUniform(int location, const glm::mat3 &value) override;
+    virtual void SetUniform(int location, const glm::mat4 &value) override;
+
+    virtual uint32_t CreateComputeProgram(const std::string &computeSource) override;
+    virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+    virtual void BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format, RendererEnum access) override;
+    virtual void BindBufferBase(RendererEnum target, uint32_t index, uint32_t buffer) override;
+    virtual void InsertMemoryBarrier() override;
+
+    virtual uint32_t CreateQuery() override;
+    virtual void DeleteQuery(uint32_t query) override;
+    virtual void BeginTimerQuery(uint32_t query) override;
+    virtual void EndTimerQuery() override;
+    virtual bool IsQueryResultAvailable(uint32_t query) override;
+    virtual uint64_t GetQueryResult(uint32_t query) override;
+
+    virtual uint32_t CreateFence() override;
+    virtual void DeleteFence(uint32_t fence) override;
+    virtual bool IsFenceSignaled(uint32_t fence) override;
+
+  private:
+    void Record(RecordedCommandType type, uint32_t a = 0, uint32_t b = 0, uint32_t c = 0);
+    uint32_t NextId() { return ++m_LastId; }
+
+  private:
+    std::vector<RecordedCommand> m_Commands;
+    uint32_t m_CommandCounts[(size_t)RecordedCommandType::Count] = {};
+
+    uint32_t m_LastId = 0;
+    std::unordered_map<std::string, int> m_UniformLocations;
+};
+} // namespace Engine
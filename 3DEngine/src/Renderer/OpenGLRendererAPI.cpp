@@ -0,0 +1,523 @@
+#include "OpenGLRendererAPI.h"
+
+#include <glad/glad.h>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "Log.h"
+#include "MemoryTracker.h"
+
+namespace Engine
+{
+static GLenum GetType(const RendererEnum &bufferType)
+{
+    switch (bufferType)
+    {
+        case RendererEnum::ARRAY_BUFFER: return GL_ARRAY_BUFFER;
+        case RendererEnum::ELEMENT_ARRAY_BUFFER: return GL_ELEMENT_ARRAY_BUFFER;
+        case RendererEnum::FLOAT: return GL_FLOAT;
+        case RendererEnum::UFLOAT: return GL_BYTE;
+        case RendererEnum::BYTE: return GL_BYTE;
+        case RendererEnum::UBYTE: return GL_UNSIGNED_BYTE;
+        case RendererEnum::INT: return GL_INT;
+        case RendererEnum::UINT: return GL_UNSIGNED_INT;
+        case RendererEnum::TRIANGLES: return GL_TRIANGLES;
+        case RendererEnum::TRIANGLE_STRIP: return GL_TRIANGLE_STRIP;
+        case RendererEnum::LINES: return GL_LINES;
+        case RendererEnum::DEPTH_ATTACHMENT: return GL_DEPTH_ATTACHMENT;
+        case RendererEnum::COLOR_ATTACHMENT0: return GL_COLOR_ATTACHMENT0;
+        case RendererEnum::COLOR_ATTACHMENT1: return GL_COLOR_ATTACHMENT1;
+        case RendererEnum::DEPTH_TEST: return GL_DEPTH_TEST;
+        case RendererEnum::FACE_CULL: return GL_CULL_FACE;
+        case RendererEnum::STATIC_DRAW: return GL_STATIC_DRAW;
+        case RendererEnum::DYNAMIC_DRAW: return GL_DYNAMIC_DRAW;
+        case RendererEnum::STREAM_DRAW: return GL_STREAM_DRAW;
+        case RendererEnum::STREAM_READ: return GL_STREAM_READ;
+		case RendererEnum::BLEND: return GL_BLEND;
+        case RendererEnum::MULTISAMPLE: return GL_MULTISAMPLE;
+        case RendererEnum::DEBUG_OUTPUT: return GL_DEBUG_OUTPUT;
+        case RendererEnum::DEBUG_OUTPUT_SYNCHRONOUS: return GL_DEBUG_OUTPUT_SYNCHRONOUS;
+        case RendererEnum::TEXTURE_CUBE_MAP_SEAMLESS: return GL_TEXTURE_CUBE_MAP_SEAMLESS;
+        case RendererEnum::TEXTURE_2D: return GL_TEXTURE_2D;
+        case RendererEnum::TEXTURE_CUBE_MAP: return GL_TEXTURE_CUBE_MAP;
+        case RendererEnum::REPEAT: return GL_REPEAT;
+        case RendererEnum::CLAMP_TO_EDGE: return GL_CLAMP_TO_EDGE;
+        case RendererEnum::CLAMP_TO_BORDER: return GL_CLAMP_TO_BORDER;
+        case RendererEnum::LESS: return GL_LESS;
+        case RendererEnum::LEQUAL: return GL_LEQUAL;
+        case RendererEnum::EQUAL: return GL_EQUAL;
+        case RendererEnum::ZERO: return GL_ZERO;
+        case RendererEnum::ONE: return GL_ONE;
+        case RendererEnum::SRC_ALPHA: return GL_SRC_ALPHA;
+        case RendererEnum::ONE_MINUS_SRC_ALPHA: return GL_ONE_MINUS_SRC_ALPHA;
+        case RendererEnum::SHADER_STORAGE_BUFFER: return GL_SHADER_STORAGE_BUFFER;
+        case RendererEnum::UNIFORM_BUFFER: return GL_UNIFORM_BUFFER;
+        case RendererEnum::PIXEL_PACK_BUFFER: return GL_PIXEL_PACK_BUFFER;
+        case RendererEnum::READ_ONLY: return GL_READ_ONLY;
+        case RendererEnum::WRITE_ONLY: return GL_WRITE_ONLY;
+        case RendererEnum::READ_WRITE: return GL_READ_WRITE;
+    }
+
+    return 0;
+}
+
+namespace Utils
+{
+static GLenum ImageFormatToGLDataFormat(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R8: return GL_RED;
+        case ImageFormat::RGB8: return GL_RGB;
+        case ImageFormat::RGBA8: return GL_RGBA;
+        case ImageFormat::RGB16: return GL_RGBA;
+        case ImageFormat::RGBA32F: return GL_RGBA;
+        case ImageFormat::R11G11B10F: return GL_RGB;
+        case ImageFormat::RG16F: return GL_RG;
+        case ImageFormat::RED_INTEGER: return GL_RED_INTEGER;
+        case ImageFormat::Depth: return GL_DEPTH_COMPONENT;
+        default: break;
+    }
+    return 0;
+}
+
+static GLenum ImageFormatToGLInternalFormat(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R8: return GL_RED;
+        case ImageFormat::RGB8: return GL_RGB8;
+        case ImageFormat::RGBA8: return GL_RGBA8;
+        case ImageFormat::RGB16: return GL_RGB16F;
+        case ImageFormat::RGBA32F: return GL_RGBA32F;
+        case ImageFormat::R11G11B10F: return GL_R11F_G11F_B10F;
+        case ImageFormat::RG16F: return GL_RG16F;
+        case ImageFormat::RED_INTEGER: return GL_R32I;
+        case ImageFormat::Depth: return GL_DEPTH_COMPONENT;
+        default: break;
+    }
+    return 0;
+}
+
+static GLenum ImageFormatToGLDataType(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R8: return GL_UNSIGNED_BYTE;
+        case ImageFormat::RGB8: return GL_UNSIGNED_BYTE;
+        case ImageFormat::RGBA8: return GL_UNSIGNED_BYTE;
+        case ImageFormat::RGB16: return GL_FLOAT;
+        case ImageFormat::RGBA32F: return GL_FLOAT;
+        case ImageFormat::R11G11B10F: return GL_FLOAT;
+        case ImageFormat::RG16F: return GL_FLOAT;
+        case ImageFormat::RED_INTEGER: return GL_INT;
+        case ImageFormat::Depth: return GL_FLOAT;
+        default: break;
+    }
+    return 0;
+}
+
+// what the driver most likely stores per texel, three component formats are padded to four
+static size_t ImageFormatToBytesPerPixel(ImageFormat format)
+{
+    switch (format)
+    {
+        case ImageFormat::R8: return 1;
+        case ImageFormat::RGB8: return 4;
+        case ImageFormat::RGBA8: return 4;
+        case ImageFormat::RGB16: return 8;
+        case ImageFormat::RGBA32F: return 16;
+        case ImageFormat::R11G11B10F: return 4;
+        case ImageFormat::RG16F: return 4;
+        case ImageFormat::RED_INTEGER: return 4;
+        case ImageFormat::Depth: return 4;
+        default: break;
+    }
+    return 0;
+}
+} // namespace Utils
+
+void OpenGLRendererAPI::Init() {}
+
+void OpenGLRendererAPI::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    glViewport(x, y, width, height);
+}
+
+void OpenGLRendererAPI::SetClearColor(const glm::vec4 &color) { glClearColor(color.r, color.g, color.b, color.a); }
+
+void OpenGLRendererAPI::Clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+
+void OpenGLRendererAPI::Enable(RendererEnum state) { glEnable(GetType(state)); }
+
+void OpenGLRendererAPI::Disable(RendererEnum state) { glDisable(GetType(state)); }
+
+void OpenGLRendererAPI::SetDepthMask(bool write) { glDepthMask(write ? GL_TRUE : GL_FALSE); }
+
+void OpenGLRendererAPI::SetColorMask(bool write)
+{
+    GLboolean mask = write ? GL_TRUE : GL_FALSE;
+    glColorMask(mask, mask, mask, mask);
+}
+
+void OpenGLRendererAPI::SetDepthFunc(RendererEnum func) { glDepthFunc(GetType(func)); }
+
+void OpenGLRendererAPI::SetBlendFunc(RendererEnum src, RendererEnum dst) { glBlendFunc(GetType(src), GetType(dst)); }
+
+void OpenGLRendererAPI::DrawElements(RendererEnum mode, int count, RendererEnum type, const void *indices)
+{
+    glDrawElements(GetType(mode), count, GetType(type), indices);
+}
+
+void OpenGLRendererAPI::DrawMultiElements(RendererEnum mode, const int *count, RendererEnum type,
+                                          const void *const *indices, unsigned int drawCount)
+{
+    glMultiDrawElements(GetType(mode), count, GetType(type), indices, drawCount);
+}
+
+void OpenGLRendererAPI::DrawArrays(RendererEnum mode, int first, int count) { glDrawArrays(GetType(mode), first, count); }
+
+uint32_t OpenGLRendererAPI::CreateVertexArray()
+{
+    uint32_t vao;
+    glGenVertexArrays(1, &vao);
+    return vao;
+}
+
+void OpenGLRendererAPI::DeleteVertexArray(uint32_t vao) { glDeleteVertexArrays(1, &vao); }
+
+void OpenGLRendererAPI::BindVertexArray(uint32_t vao) { glBindVertexArray(vao); }
+
+uint32_t OpenGLRendererAPI::CreateBuffer(RendererEnum target, int size, const void *data, RendererEnum usage)
+{
+    uint32_t buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GetType(target), buffer);
+    glBufferData(GetType(target), size, data, GetType(usage));
+    // a bound pack buffer would take every later pixel read
+    if (target == RendererEnum::PIXEL_PACK_BUFFER) glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    MemoryTracker::TrackGPU(GPUMemoryType::Buffers, buffer, size);
+    return buffer;
+}
+
+void OpenGLRendererAPI::SetBufferSubData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                         const void *data)
+{
+    glBindBuffer(GetType(target), buffer);
+    glBufferSubData(GetType(target), offset, size, data);
+}
+
+void OpenGLRendererAPI::DeleteBuffer(uint32_t buffer)
+{
+    MemoryTracker::UntrackGPU(GPUMemoryType::Buffers, buffer);
+    glDeleteBuffers(1, &buffer);
+}
+
+void OpenGLRendererAPI::GetBufferData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size, void *data)
+{
+    glBindBuffer(GetType(target), buffer);
+    glGetBufferSubData(GetType(target), offset, size, data);
+    glBindBuffer(GetType(target), 0);
+}
+
+void OpenGLRendererAPI::SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset)
+{
+    glEnableVertexAttribArray(index);
+    glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, stride, offset);
+}
+
+uint32_t OpenGLRendererAPI::CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height, RendererEnum wrap,
+                                            const void *data)
+{
+    uint32_t texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, Utils::ImageFormatToGLInternalFormat(format), width, height, 0,
+                 Utils::ImageFormatToGLDataFormat(format), Utils::ImageFormatToGLDataType(format), data);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GetType(wrap));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GetType(wrap));
+
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, texture,
+                            (size_t)width * height * Utils::ImageFormatToBytesPerPixel(format));
+    return texture;
+}
+
+void OpenGLRendererAPI::SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                                       const void *data)
+{
+    glTextureSubImage2D(texture, 0, 0, 0, width, height, Utils::ImageFormatToGLDataFormat(format),
+                        Utils::ImageFormatToGLDataType(format), data);
+}
+
+void OpenGLRendererAPI::DeleteTexture(uint32_t texture)
+{
+    MemoryTracker::UntrackGPU(GPUMemoryType::Textures, texture);
+    glDeleteTextures(1, &texture);
+}
+
+void OpenGLRendererAPI::BindTexture(uint32_t slot, uint32_t texture, RendererEnum target)
+{
+    glActiveTexture(GL_TEXTURE0 + slot);
+    glBindTexture(GetType(target), texture);
+}
+
+void OpenGLRendererAPI::ClearTexture(uint32_t texture, int value)
+{
+    glClearTexImage(texture, 0, GL_RED_INTEGER, GL_INT, &value);
+}
+
+void OpenGLRendererAPI::ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data)
+{
+    glGetTextureImage(texture, 0, Utils::ImageFormatToGLDataFormat(format), Utils::ImageFormatToGLDataType(format),
+                      size, data);
+}
+
+void OpenGLRendererAPI::ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size, uint32_t buffer)
+{
+    // with a pack buffer bound the pointer is an offset into it; unbound again so ReadPixel reads to memory
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glGetTextureImage(texture, 0, Utils::ImageFormatToGLDataFormat(format), Utils::ImageFormatToGLDataType(format),
+                      size, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+uint32_t OpenGLRendererAPI::CreateFramebuffer()
+{
+    uint32_t framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    return framebuffer;
+}
+
+void OpenGLRendererAPI::DeleteFramebuffer(uint32_t framebuffer) { glDeleteFramebuffers(1, &framebuffer); }
+
+void OpenGLRendererAPI::BindFramebuffer(uint32_t framebuffer) { glBindFramebuffer(GL_FRAMEBUFFER, framebuffer); }
+
+void OpenGLRendererAPI::AttachTexture(uint32_t attachment, uint32_t texture, int mip)
+{
+    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, texture, mip);
+}
+
+void OpenGLRendererAPI::SetDrawBuffers(const uint32_t *attachments, int count) { glDrawBuffers(count, attachments); }
+
+uint32_t OpenGLRendererAPI::CreateDepthRenderbuffer(uint32_t width, uint32_t height)
+{
+    uint32_t renderbuffer;
+    glGenRenderbuffers(1, &renderbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, renderbuffer);
+    MemoryTracker::TrackGPU(GPUMemoryType::Renderbuffers, renderbuffer, (size_t)width * height * 4);
+    return renderbuffer;
+}
+
+void OpenGLRendererAPI::DeleteRenderbuffer(uint32_t renderbuffer)
+{
+    MemoryTracker::UntrackGPU(GPUMemoryType::Renderbuffers, renderbuffer);
+    glDeleteRenderbuffers(1, &renderbuffer);
+}
+
+bool OpenGLRendererAPI::IsFramebufferComplete()
+{
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+int OpenGLRendererAPI::ReadPixel(uint32_t attachmentIndex, int x, int y)
+{
+    glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+    int pixelData;
+    glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+    return pixelData;
+}
+
+uint32_t OpenGLRendererAPI::CreateProgram(const std::string &vertexSource, const std::string &fragmentSource)
+{
+    const GLchar *vs = vertexSource.c_str();
+    const GLchar *fs = fragmentSource.c_str();
+
+    // compile shaders
+    int vertex, fragment;
+    int success;
+    char infoLog[512];
+
+    vertex = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertex, 1, &vs, nullptr);
+    glCompileShader(vertex);
+    // check for compile errors
+    glGetShaderiv(vertex, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(vertex, 512, NULL, infoLog);
+        LOG_CORE_ERROR("SHADER::VERTEX::COMPILATION_FAILED: {0}", infoLog);
+    }
+
+    fragment = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragment, 1, &fs, nullptr);
+    glCompileShader(fragment);
+    glGetShaderiv(fragment, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(fragment, 512, NULL, infoLog);
+        LOG_CORE_ERROR("SHADER::FRAGMENT::COMPILATION_FAILED: {0}", infoLog);
+    }
+
+    uint32_t program = glCreateProgram();
+    glAttachShader(program, vertex);
+    glAttachShader(program, fragment);
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        LOG_CORE_ERROR("SHADER::PROGRAM::LINKING_FAILED: {0}", infoLog);
+    }
+
+    // can be deleted because they are already linked to program
+    glDeleteShader(vertex);
+    glDeleteShader(fragment);
+
+    return program;
+}
+
+void OpenGLRendererAPI::DeleteProgram(uint32_t program) { glDeleteProgram(program); }
+
+void OpenGLRendererAPI::UseProgram(uint32_t program) { glUseProgram(program); }
+
+int OpenGLRendererAPI::GetUniformLocation(uint32_t program, const std::string &name)
+{
+    return glGetUniformLocation(program, name.c_str());
+}
+
+void OpenGLRendererAPI::SetUniform(int location, int value) { glUniform1i(location, value); }
+
+void OpenGLRendererAPI::SetUniform(int location, float value) { glUniform1f(location, value); }
+
+void OpenGLRendererAPI::SetUniform(int location, const glm::vec2 &value) { glUniform2f(location, value.x, value.y); }
+
+void OpenGLRendererAPI::SetUniform(int location, const glm::vec3 &value)
+{
+    glUniform3f(location, value.x, value.y, value.z);
+}
+
+void OpenGLRendererAPI::SetUniform(int location, const glm::vec4 &value)
+{
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void OpenGLRendererAPI::SetUniform(int location, const glm::mat3 &value)
+{
+    glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+void OpenGLRendererAPI::SetUniform(int location, const glm::mat4 &value)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
+uint32_t OpenGLRendererAPI::CreateComputeProgram(const std::string &computeSource)
+{
+    const GLchar *cs = computeSource.c_str();
+
+    int success;
+    char infoLog[512];
+
+    uint32_t compute = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(compute, 1, &cs, nullptr);
+    glCompileShader(compute);
+    glGetShaderiv(compute, GL_COMPILE_STATUS, &success);
+    if (!success)
+    {
+        glGetShaderInfoLog(compute, 512, NULL, infoLog);
+        LOG_CORE_ERROR("SHADER::COMPUTE::COMPILATION_FAILED: {0}", infoLog);
+    }
+
+    uint32_t program = glCreateProgram();
+    glAttachShader(program, compute);
+    glLinkProgram(program);
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        LOG_CORE_ERROR("SHADER::PROGRAM::LINKING_FAILED: {0}", infoLog);
+    }
+
+    glDeleteShader(compute);
+
+    return program;
+}
+
+void OpenGLRendererAPI::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    glDispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void OpenGLRendererAPI::BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format, RendererEnum access)
+{
+    glBindImageTexture(unit, texture, 0, GL_FALSE, 0, GetType(access), Utils::ImageFormatToGLInternalFormat(format));
+}
+
+void OpenGLRendererAPI::BindBufferBase(RendererEnum target, uint32_t index, uint32_t buffer)
+{
+    glBindBufferBase(GetType(target), index, buffer);
+}
+
+void OpenGLRendererAPI::InsertMemoryBarrier()
+{
+    // texture update covers reading image stores back with ReadTextureData
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT | GL_TEXTURE_FETCH_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT |
+                    GL_TEXTURE_UPDATE_BARRIER_BIT);
+}
+
+uint32_t OpenGLRendererAPI::CreateQuery()
+{
+    uint32_t query;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void OpenGLRendererAPI::DeleteQuery(uint32_t query) { glDeleteQueries(1, &query); }
+
+void OpenGLRendererAPI::BeginTimerQuery(uint32_t query) { glBeginQuery(GL_TIME_ELAPSED, query); }
+
+void OpenGLRendererAPI::EndTimerQuery() { glEndQuery(GL_TIME_ELAPSED); }
+
+bool OpenGLRendererAPI::IsQueryResultAvailable(uint32_t query)
+{
+    int available = 0;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    return available;
+}
+
+uint64_t OpenGLRendererAPI::GetQueryResult(uint32_t query)
+{
+    uint64_t result = 0;
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+    return result;
+}
+
+uint32_t OpenGLRendererAPI::CreateFence()
+{
+    m_Fences[++m_LastFence] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    return m_LastFence;
+}
+
+void OpenGLRendererAPI::DeleteFence(uint32_t fence)
+{
+    auto it = m_Fences.find(fence);
+    if (it == m_Fences.end()) return;
+
+    glDeleteSync((GLsync)it->second);
+    m_Fences.erase(it);
+}
+
+bool OpenGLRendererAPI::IsFenceSignaled(uint32_t fence)
+{
+    auto it = m_Fences.find(fence);
+    if (it == m_Fences.end()) return false;
+
+    // no timeout, the swap at the end of the frame flushes the fence
+    const GLenum status = glClientWaitSync((GLsync)it->second, 0, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+} // namespace Engine
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "RendererAPI.h"
+
+#include <unordered_map>
+
+namespace Engine
+{
+class OpenGLRendererAPI : public RendererAPI
+{
+  public:
+    virtual void Init() override;
+
+    virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+    virtual void SetClearColor(const glm::vec4 &color) override;
+    virtual void Clear() override;
+    virtual void Enable(RendererEnum state) override;
+    virtual void Disable(RendererEnum state) override;
+    virtual void SetDepthMask(bool write) override;
+    virtual void SetColorMask(bool write) override;
+    virtual void SetDepthFunc(RendererEnum func) override;
+    virtual void SetBlendFunc(RendererEnum src, RendererEnum dst) override;
+
+    virtual void DrawElements(RendererEnum mode, int count, RendererEnum type, const void *indices) override;
+    virtual void DrawMultiElements(RendererEnum mode, const int *count, RendererEnum type, const void *const *indices,
+                                   unsigned int drawCount) override;
+    virtual void DrawArrays(RendererEnum mode, int first, int count) override;
+
+    virtual uint32_t CreateVertexArray() override;
+    virtual void DeleteVertexArray(uint32_t vao) override;
+    virtual void BindVertexArray(uint32_t vao) override;
+    virtual uint32_t CreateBuffer(RendererEnum target, int size, const void *data, RendererEnum usage) override;
+    virtual void SetBufferSubData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                  const void *data) override;
+    virtual void DeleteBuffer(uint32_t buffer) override;
+    virtual void GetBufferData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                               void *data) override;
+    virtual void SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset) override;
+
+    virtual uint32_t CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height, RendererEnum wrap,
+                                     const void *data = nullptr) override;
+    virtual void SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                                const void *data) override;
+    virtual void DeleteTexture(uint32_t texture) override;
+    virtual void BindTexture(uint32_t slot, uint32_t texture, RendererEnum target) override;
+    virtual void ClearTexture(uint32_t texture, int value) override;
+    virtual void ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data) override;
+    virtual void ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size,
+                                         uint32_t buffer) override;
+
+    virtual uint32_t CreateFramebuffer() override;
+    virtual void DeleteFramebuffer(uint32_t framebuffer) override;
+    virtual void BindFramebuffer(uint32_t framebuffer) override;
+    virtual void AttachTexture(uint32_t attachment, uint32_t texture, int mip = 0) override;
+    virtual void SetDrawBuffers(const uint32_t *attachments, int count) override;
+    virtual uint32_t CreateDepthRenderbuffer(uint32_t width, uint32_t height) override;
+    virtual void DeleteRenderbuffer(uint32_t renderbuffer) override;
+    virtual bool IsFramebufferComplete() override;
+    virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
+
+    virtual uint32_t CreateProgram(const std::string &vertexSource, const std::string &fragmentSource) override;
+    virtual void DeleteProgram(uint32_t program) override;
+    virtual void UseProgram(uint32_t program) override;
+    virtual int GetUniformLocation(uint32_t program, const std::string &name) override;
+    virtual void SetUniform(int location, int value) override;
+    virtual void SetUniform(int location, float value) override;
+    virtual void SetUniform(int location, const glm::vec2 &value) override;
+    virtual void SetUniform(int location, const glm::vec3 &value) override;
+    virtual void SetUniform(int location, const glm::vec4 &value) override;
+    virtual void SetUniform(int location, const glm::mat3 &value) override;
+    virtual void SetUniform(int location, const glm::mat4 &value) override;
+
+    virtual uint32_t CreateComputeProgram(const std::string &computeSource) override;
+    virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) override;
+    virtual void BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format, RendererEnum access) override;
+    virtual void BindBufferBase(RendererEnum target, uint32_t index, uint32_t buffer) override;
+    virtual void InsertMemoryBarrier() override;
+
+    virtual uint32_t CreateQuery() override;
+    virtual void DeleteQuery(uint32_t query) override;
+    virtual void BeginTimerQuery(uint32_t query) override;
+    virtual void EndTimerQuery() override;
+    virtual bool IsQueryResultAvailable(uint32_t query) override;
+    virtual uint64_t GetQueryResult(uint32_t query) override;
+
+    virtual uint32_t CreateFence() override;
+    virtual void DeleteFence(uint32_t fence) override;
+    virtual bool IsFenceSignaled(uint32_t fence) override;
+
+  private:
+    // GLsync objects by the ids handed out for them
+    std::unordered_map<uint32_t, void *> m_Fences;
+    uint32_t m_LastFence = 0;
+};
+} // namespace Engine
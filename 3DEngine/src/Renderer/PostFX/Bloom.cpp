@@ -1,26 +1,34 @@
 #include "Bloom.h"
 
 #include "Renderer.h"
+#include "RenderCommand.h"
+#include "Framebuffer.h"
 #include "Log.h"
 
-#include <glad/glad.h>
+#include <algorithm>
+#include <cmath>
 
 namespace Engine
 {
-bool BloomRenderer::Init(unsigned int windowWidth, unsigned int windowHeight)
+static constexpr unsigned int s_MaxBloomMips = 10; // Experiment with this value
+// bloomDownsample.comp binds every mip as an image, GL only guarantees 8 image units for compute
+static constexpr unsigned int s_MaxComputeBloomMips = 8;
+// side of the block of the first mip that each bloomDownsample.comp workgroup reduces
+static constexpr unsigned int s_DownsampleTileSize = 32;
+static constexpr unsigned int s_UpsampleGroupSize = 8;
+
+static unsigned int GetMipCount(const glm::vec2 &size, unsigned int maxMips)
 {
-    if (mInit) return true;
-    mSrcViewportSize = glm::ivec2(windowWidth, windowHeight);
-    mSrcViewportSizeFloat = glm::vec2((float)windowWidth, (float)windowHeight);
+    // stop before a mip would collapse below one pixel
+    const float smallestSide = std::max(1.0f, std::min(size.x, size.y));
+    return std::clamp((unsigned int)std::log2(smallestSide), 1u, maxMips);
+}
 
-    // Framebuffer
-    const unsigned int num_bloom_mips = 10; // Experiment with this value
-    bool status = mFBO.Init(windowWidth, windowHeight, num_bloom_mips);
-    if (!status)
-    {
-		LOG_CORE_ERROR("Failed to initialize bloom FBO - cannot create bloom renderer!");
-        return false;
-    }
+static unsigned int DivideRoundUp(unsigned int value, unsigned int divisor) { return (value + divisor - 1) / divisor; }
+
+bool BloomRenderer::Init()
+{
+    if (mInit) return true;
 
     // Shaders
     mDownsampleShader = ShaderManager::GetShader("Resources/shaders/downsample");
@@ -36,6 +44,15 @@ bool BloomRenderer::Init(unsigned int windowWidth, unsigned int windowHeight)
     mUpsampleShader->SetUniform1i("srcTexture", 0);
     mUpsampleShader->Unbind();
 
+    mComputeDownsampleShader = ShaderManager::GetComputeShader("Resources/shaders/bloomDownsample");
+    mComputeUpsampleShader = ShaderManager::GetComputeShader("Resources/shaders/bloomUpsample");
+    mComputeUpsampleShader->Unbind();
+
+    // workgroups count themselves in here so the last one knows it can finish the small mips
+    const uint32_t zero = 0;
+    mDownsampleCounter =
+        RenderCommand::CreateBuffer(RendererEnum::SHADER_STORAGE_BUFFER, sizeof(zero), &zero, RendererEnum::DYNAMIC_DRAW);
+
     mInit = true;
     return true;
 }
@@ -46,89 +63,186 @@ BloomRenderer::~BloomRenderer() {}
 
 void BloomRenderer::Destroy()
 {
-    mFBO.Destroy();
     delete mDownsampleShader;
     delete mUpsampleShader;
+    if (mDownsampleCounter != 0) RenderCommand::DeleteBuffer(mDownsampleCounter);
+    mDownsampleCounter = 0;
     mInit = false;
 }
 
-void BloomRenderer::RenderBloomTexture(unsigned int srcTexture, float filterRadius)
+RenderGraphResource BloomRenderer::AddPass(RenderGraph &graph, RenderGraphResource srcTexture, float filterRadius)
 {
-    mFBO.BindForWriting();
-
-    this->RenderDownsamples(srcTexture);
-    this->RenderUpsamples(filterRadius);
-
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    // Restore viewport
-    glViewport(0, 0, mSrcViewportSize.x, mSrcViewportSize.y);
+    if (!mInit) Init();
+
+    mSrcViewportSizeFloat = graph.GetSize();
+    const unsigned int mipCount = GetMipCount(mSrcViewportSizeFloat, s_MaxBloomMips);
+
+    graph.AddPass(
+        "Bloom",
+        [&](RenderGraphBuilder &builder)
+        {
+            builder.Read(srcTexture);
+            CreateMipResources(builder, mipCount);
+            builder.Write(mMips[0]);
+        },
+        [this, srcTexture, filterRadius](const RenderGraphResources &resources)
+        {
+            std::vector<Texture2DRef> mipChain;
+            mipChain.reserve(mMips.size());
+            for (auto mip : mMips)
+                mipChain.push_back(resources.GetTexture(mip));
+
+            RenderDownsamples(resources.GetTexture(srcTexture)->GetRendererID(), mipChain);
+            RenderUpsamples(filterRadius, mipChain);
+
+            // leave the result attached where the graph put it
+            RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT0, mipChain[0]->GetRendererID());
+        });
+
+    return mMips[0];
 }
 
-GLuint BloomRenderer::BloomTexture() { return mFBO.MipChain()[0].texture; }
+RenderGraphResource BloomRenderer::AddComputePass(RenderGraph &graph, RenderGraphResource srcTexture,
+                                                  float filterRadius)
+{
+    if (!mInit) Init();
+
+    mSrcViewportSizeFloat = graph.GetSize();
+    const unsigned int mipCount = GetMipCount(mSrcViewportSizeFloat, s_MaxComputeBloomMips);
+
+    graph.AddPass(
+        "BloomCompute",
+        [&](RenderGraphBuilder &builder)
+        {
+            builder.Read(srcTexture);
+            CreateMipResources(builder, mipCount);
+            builder.WriteImage(mMips[0]);
+        },
+        [this, srcTexture, filterRadius](const RenderGraphResources &resources)
+        {
+            std::vector<Texture2DRef> mipChain;
+            mipChain.reserve(mMips.size());
+            for (auto mip : mMips)
+                mipChain.push_back(resources.GetTexture(mip));
+
+            DispatchDownsamples(resources.GetTexture(srcTexture)->GetRendererID(), mipChain);
+            DispatchUpsamples(filterRadius, mipChain);
+        });
+
+    return mMips[0];
+}
 
-void BloomRenderer::RenderDownsamples(unsigned int srcTexture)
+void BloomRenderer::CreateMipResources(RenderGraphBuilder &builder, unsigned int mipCount)
 {
-    const std::vector<BloomMip> &mipChain = mFBO.MipChain();
+    mMips.resize(mipCount);
 
+    glm::vec2 mipSize = mSrcViewportSizeFloat;
+    for (unsigned int i = 0; i < mipCount; i++)
+    {
+        // we are downscaling an HDR color buffer, so we need a float texture format
+        mipSize = glm::max(glm::floor(mipSize * 0.5f), glm::vec2(1.0f));
+        mMips[i] = builder.CreateTexture("BloomMip", {ImageFormat::R11G11B10F, mipSize});
+    }
+}
+
+void BloomRenderer::RenderDownsamples(unsigned int srcTexture, const std::vector<Texture2DRef> &mipChain)
+{
     mDownsampleShader->Bind();
     mDownsampleShader->SetUniform2f("srcResolution", mSrcViewportSizeFloat);
 
     // Bind srcTexture (HDR color buffer) as initial texture input
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, srcTexture);
+    RenderCommand::BindTexture(0, srcTexture);
 
     // Progressively downsample through the mip chain
-    for (int i = 0; i < mipChain.size(); i++)
+    for (const auto &mip : mipChain)
     {
-        const BloomMip &mip = mipChain[i];
-        glViewport(0, 0, mip.size.x, mip.size.y);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, mip.texture, 0);
+        RenderCommand::SetViewport(0, 0, mip->GetWidth(), mip->GetHeight());
+        RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT0, mip->GetRendererID());
 
         // Render screen-filled quad of resolution of current mip
         Renderer::DrawQuad();
 
         // Set current mip resolution as srcResolution for next iteration
-        mDownsampleShader->SetUniform2f("srcResolution", mip.size);
+        mDownsampleShader->SetUniform2f("srcResolution", mip->GetSize());
         // Set current mip as texture input for next iteration
-        glBindTexture(GL_TEXTURE_2D, mip.texture);
+        RenderCommand::BindTexture(0, mip->GetRendererID());
     }
 
     mDownsampleShader->Unbind();
 }
 
-void BloomRenderer::RenderUpsamples(float filterRadius)
+void BloomRenderer::RenderUpsamples(float filterRadius, const std::vector<Texture2DRef> &mipChain)
 {
-    const std::vector<BloomMip> &mipChain = mFBO.MipChain();
-
     mUpsampleShader->Bind();
     mUpsampleShader->SetUniform1f("filterRadius", filterRadius);
 
     // Enable additive blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_ONE, GL_ONE);
-    glBlendEquation(GL_FUNC_ADD);
+    RenderCommand::Enable(RendererEnum::BLEND);
+    RenderCommand::SetBlendFunc(RendererEnum::ONE, RendererEnum::ONE);
 
     for (int i = mipChain.size() - 1; i > 0; i--)
     {
-        const BloomMip &mip = mipChain[i];
-        const BloomMip &nextMip = mipChain[i - 1];
+        const auto &mip = mipChain[i];
+        const auto &nextMip = mipChain[i - 1];
 
         // Bind viewport and texture from where to read
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, mip.texture);
+        RenderCommand::BindTexture(0, mip->GetRendererID());
 
         // Set framebuffer render target (we write to this texture)
-        glViewport(0, 0, nextMip.size.x, nextMip.size.y);
-        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, nextMip.texture, 0);
+        RenderCommand::SetViewport(0, 0, nextMip->GetWidth(), nextMip->GetHeight());
+        RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT0, nextMip->GetRendererID());
 
         // Render screen-filled quad of resolution of current mip
         Renderer::DrawQuad();
     }
 
     // Disable additive blending
-    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA); // Restore if this was default
-    glDisable(GL_BLEND);
+    RenderCommand::SetBlendFunc(RendererEnum::ONE, RendererEnum::ONE_MINUS_SRC_ALPHA); // Restore if this was default
+    RenderCommand::Disable(RendererEnum::BLEND);
 
     mUpsampleShader->Unbind();
 }
+
+void BloomRenderer::DispatchDownsamples(unsigned int srcTexture, const std::vector<Texture2DRef> &mipChain)
+{
+    const unsigned int groupsX = DivideRoundUp(mipChain[0]->GetWidth(), s_DownsampleTileSize);
+    const unsigned int groupsY = DivideRoundUp(mipChain[0]->GetHeight(), s_DownsampleTileSize);
+
+    mComputeDownsampleShader->Bind();
+    mComputeDownsampleShader->SetUniform2f("srcResolution", mSrcViewportSizeFloat);
+    mComputeDownsampleShader->SetUniform1i("mipCount", mipChain.size());
+    mComputeDownsampleShader->SetUniform1i("groupCount", groupsX * groupsY);
+
+    RenderCommand::BindTexture(0, srcTexture);
+    for (unsigned int i = 0; i < mipChain.size(); i++)
+        RenderCommand::BindImageTexture(i, mipChain[i]->GetRendererID(), ImageFormat::R11G11B10F);
+    RenderCommand::BindBufferBase(RendererEnum::SHADER_STORAGE_BUFFER, 0, mDownsampleCounter);
+
+    RenderCommand::DispatchCompute(groupsX, groupsY);
+    RenderCommand::InsertMemoryBarrier();
+
+    mComputeDownsampleShader->Unbind();
+}
+
+void BloomRenderer::DispatchUpsamples(float filterRadius, const std::vector<Texture2DRef> &mipChain)
+{
+    mComputeUpsampleShader->Bind();
+    mComputeUpsampleShader->SetUniform1f("filterRadius", filterRadius);
+
+    // each level needs the finished level below it, so this part can't collapse into one dispatch
+    for (int i = mipChain.size() - 1; i > 0; i--)
+    {
+        const auto &mip = mipChain[i];
+        const auto &nextMip = mipChain[i - 1];
+
+        RenderCommand::BindTexture(0, mip->GetRendererID());
+        RenderCommand::BindImageTexture(0, nextMip->GetRendererID(), ImageFormat::R11G11B10F);
+
+        RenderCommand::DispatchCompute(DivideRoundUp(nextMip->GetWidth(), s_UpsampleGroupSize),
+                                       DivideRoundUp(nextMip->GetHeight(), s_UpsampleGroupSize));
+        RenderCommand::InsertMemoryBarrier();
+    }
+
+    mComputeUpsampleShader->Unbind();
+}
 } // namespace Engine
@@ -1,13 +1,11 @@
 #pragma once
 
 #include "ShaderManager.h"
-//#include "Texture2D.h"
-#include "BloomFBO.h"
-#include "Framebuffer.h"
+#include "RenderGraph.h"
 
-#include <vector>
 #include <glm/glm.hpp>
 #include <memory>
+#include <vector>
 
 namespace Engine
 {
@@ -16,21 +14,31 @@ class BloomRenderer
   public:
     BloomRenderer();
     ~BloomRenderer();
-    bool Init(unsigned int windowWidth, unsigned int windowHeight);
+    bool Init();
     void Destroy();
-    void RenderBloomTexture(unsigned int srcTexture, float filterRadius);
-    unsigned int BloomTexture();
+
+    // Adds the downsample/upsample chain reading srcTexture; the mips are transient graph textures.
+    // Returns the resource holding the blurred result.
+    RenderGraphResource AddPass(RenderGraph &graph, RenderGraphResource srcTexture, float filterRadius);
+    // Same result from compute: the whole downsample chain in a single dispatch, then one dispatch per upsample
+    // level that filters and accumulates in place.
+    RenderGraphResource AddComputePass(RenderGraph &graph, RenderGraphResource srcTexture, float filterRadius);
 
   private:
-    void RenderDownsamples(unsigned int srcTexture);
-    void RenderUpsamples(float filterRadius);
+    void RenderDownsamples(unsigned int srcTexture, const std::vector<Texture2DRef> &mipChain);
+    void RenderUpsamples(float filterRadius, const std::vector<Texture2DRef> &mipChain);
+    void DispatchDownsamples(unsigned int srcTexture, const std::vector<Texture2DRef> &mipChain);
+    void DispatchUpsamples(float filterRadius, const std::vector<Texture2DRef> &mipChain);
+    void CreateMipResources(RenderGraphBuilder &builder, unsigned int mipCount);
 
     bool mInit;
-    BloomFBO mFBO;
-    glm::ivec2 mSrcViewportSize;
     glm::vec2 mSrcViewportSizeFloat;
+    std::vector<RenderGraphResource> mMips;
     Shader *mDownsampleShader;
     Shader *mUpsampleShader;
+    Shader *mComputeDownsampleShader;
+    Shader *mComputeUpsampleShader;
+    uint32_t mDownsampleCounter = 0;
 };
 
 using BloomRendererRef = std::shared_ptr<BloomRenderer>;
@@ -1,54 +1,295 @@
 #include "RenderCommand.h"
 
-#include <glad/glad.h>
+#include "Log.h"
 
 namespace Engine
 {
-static GLenum GetType(const RendererEnum &bufferType)
+std::unique_ptr<RendererAPI> RenderCommand::s_RendererAPI = nullptr;
+RenderStats RenderCommand::s_Stats;
+RenderStats RenderCommand::s_PublishedStats;
+std::mutex RenderCommand::s_PublishedStatsMutex;
+
+uint32_t RenderCommand::s_BoundProgram = 0;
+uint32_t RenderCommand::s_BoundVertexArray = 0;
+uint32_t RenderCommand::s_BoundFramebuffer = 0;
+std::array<uint32_t, 32> RenderCommand::s_BoundTextures{};
+std::array<uint32_t, 8> RenderCommand::s_BoundImageTextures{};
+std::unordered_map<uint32_t, uint32_t> RenderCommand::s_BoundBufferBases;
+std::unordered_map<uint32_t, uint32_t> RenderCommand::s_Capabilities;
+uint32_t RenderCommand::s_DepthMask = RenderCommand::UnknownState;
+uint32_t RenderCommand::s_ColorMask = RenderCommand::UnknownState;
+uint32_t RenderCommand::s_DepthFunc = RenderCommand::UnknownState;
+uint32_t RenderCommand::s_BlendFunc = RenderCommand::UnknownState;
+
+void RenderCommand::Init()
 {
-    switch (bufferType)
-    {
-        case RendererEnum::ARRAY_BUFFER: return GL_ARRAY_BUFFER;
-        case RendererEnum::ELEMENT_ARRAY_BUFFER: return GL_ELEMENT_ARRAY_BUFFER;
-        case RendererEnum::FLOAT: return GL_FLOAT;
-        case RendererEnum::UFLOAT: return GL_BYTE;
-        case RendererEnum::BYTE: return GL_BYTE;
-        case RendererEnum::UBYTE: return GL_UNSIGNED_BYTE;
-        case RendererEnum::INT: return GL_INT;
-        case RendererEnum::UINT: return GL_UNSIGNED_INT;
-        case RendererEnum::TRIANGLES: return GL_TRIANGLES;
-        case RendererEnum::LINES: return GL_LINES;
-        case RendererEnum::DEPTH_TEST: return GL_DEPTH_TEST;
-        case RendererEnum::FACE_CULL: return GL_CULL_FACE;
-        case RendererEnum::STATIC_DRAW: return GL_STATIC_DRAW;
-        case RendererEnum::DYNAMIC_DRAW: return GL_DYNAMIC_DRAW;
-        case RendererEnum::STREAM_DRAW: return GL_STREAM_DRAW;
-		case RendererEnum::BLEND: return GL_BLEND;
-    }
+    s_RendererAPI = RendererAPI::Create();
+    s_RendererAPI->Init();
+
+    LOG_CORE_INFO("Render backend: {}", RendererAPIToString(RendererAPI::GetAPI()));
+}
+
+void RenderCommand::PublishStats()
+{
+    std::scoped_lock<std::mutex> lock(s_PublishedStatsMutex);
+    s_PublishedStats = s_Stats;
+}
+
+RenderStats RenderCommand::GetFrameStats()
+{
+    std::scoped_lock<std::mutex> lock(s_PublishedStatsMutex);
+    return s_PublishedStats;
+}
+
+void RenderCommand::EndFrame() { s_RendererAPI->EndFrame(); }
+
+void RenderCommand::TrackStateChange(uint32_t &current, uint32_t value)
+{
+    if (current == value)
+        s_Stats.RedundantStateChanges++;
+    else
+        s_Stats.StateChanges++;
+
+    current = value;
+}
+
+void RenderCommand::Clear() { s_RendererAPI->Clear(); }
+
+void RenderCommand::SetClearColor(const glm::vec3 &color) { s_RendererAPI->SetClearColor(glm::vec4(color, 1.0f)); }
+
+void RenderCommand::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+    s_RendererAPI->SetViewport(x, y, width, height);
+}
 
-    return 0;
+void RenderCommand::Enable(const RendererEnum enumType)
+{
+    TrackStateChange(s_Capabilities.try_emplace((uint32_t)enumType, UnknownState).first->second, 1);
+    s_RendererAPI->Enable(enumType);
 }
 
-void RenderCommand::Clear() { glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); }
+void RenderCommand::Disable(const RendererEnum enumType)
+{
+    TrackStateChange(s_Capabilities.try_emplace((uint32_t)enumType, UnknownState).first->second, 0);
+    s_RendererAPI->Disable(enumType);
+}
 
-void RenderCommand::SetClearColor(const glm::vec3 &color) { glClearColor(color.r, color.g, color.b, 1.0f); }
+void RenderCommand::SetDepthMask(bool write)
+{
+    TrackStateChange(s_DepthMask, write);
+    s_RendererAPI->SetDepthMask(write);
+}
 
-void RenderCommand::Enable(const RendererEnum enumType) { glEnable(GetType(enumType)); }
+void RenderCommand::SetColorMask(bool write)
+{
+    TrackStateChange(s_ColorMask, write);
+    s_RendererAPI->SetColorMask(write);
+}
 
-void RenderCommand::Disable(const RendererEnum enumType) { glDisable(GetType(enumType)); }
+void RenderCommand::SetDepthFunc(const RendererEnum func)
+{
+    TrackStateChange(s_DepthFunc, (uint32_t)func);
+    s_RendererAPI->SetDepthFunc(func);
+}
+
+void RenderCommand::SetBlendFunc(const RendererEnum src, const RendererEnum dst)
+{
+    TrackStateChange(s_BlendFunc, (uint32_t)src << 16 | (uint32_t)dst);
+    s_RendererAPI->SetBlendFunc(src, dst);
+}
 
 void RenderCommand::DrawMultiElements(const RendererEnum mode, const int count, const RendererEnum type,
                                       const void *const *indices, unsigned int drawCount)
 {
-    glMultiDrawElements(GetType(mode), &count, GetType(type), indices, drawCount);
+    s_Stats.DrawCalls++;
+    s_RendererAPI->DrawMultiElements(mode, &count, type, indices, drawCount);
 }
 
 void RenderCommand::DrawElements(const RendererEnum mode, const int count, const RendererEnum type, const void *indices)
 {
-    glDrawElements(GetType(mode), count, GetType(type), indices);
+    s_Stats.DrawCalls++;
+    if (mode == RendererEnum::TRIANGLES) s_Stats.Triangles += count / 3;
+    s_RendererAPI->DrawElements(mode, count, type, indices);
+}
+
+void RenderCommand::DrawArrays(int from, int count) { DrawArrays(RendererEnum::TRIANGLES, from, count); }
+
+void RenderCommand::DrawArrays(const RendererEnum mode, int from, int count)
+{
+    s_Stats.DrawCalls++;
+    if (mode == RendererEnum::TRIANGLES) s_Stats.Triangles += count / 3;
+    s_RendererAPI->DrawArrays(mode, from, count);
+}
+
+void RenderCommand::DrawLines(int from, int count) { DrawArrays(RendererEnum::LINES, from, count); }
+
+uint32_t RenderCommand::CreateVertexArray() { return s_RendererAPI->CreateVertexArray(); }
+
+void RenderCommand::DeleteVertexArray(uint32_t vao) { s_RendererAPI->DeleteVertexArray(vao); }
+
+void RenderCommand::BindVertexArray(uint32_t vao)
+{
+    TrackStateChange(s_BoundVertexArray, vao);
+    s_RendererAPI->BindVertexArray(vao);
 }
 
-void RenderCommand::DrawArrays(int from, int count) { glDrawArrays(GL_TRIANGLES, from, count); }
+uint32_t RenderCommand::CreateBuffer(const RendererEnum target, int size, const void *data, const RendererEnum usage)
+{
+    if (data)
+    {
+        s_Stats.Uploads++;
+        s_Stats.UploadBytes += size;
+    }
+    return s_RendererAPI->CreateBuffer(target, size, data, usage);
+}
+
+void RenderCommand::SetBufferSubData(const RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                     const void *data)
+{
+    s_Stats.Uploads++;
+    s_Stats.UploadBytes += size;
+    s_RendererAPI->SetBufferSubData(target, buffer, offset, size, data);
+}
+
+void RenderCommand::DeleteBuffer(uint32_t buffer) { s_RendererAPI->DeleteBuffer(buffer); }
+
+void RenderCommand::GetBufferData(const RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                  void *data)
+{
+    s_RendererAPI->GetBufferData(target, buffer, offset, size, data);
+}
+
+void RenderCommand::SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset)
+{
+    s_RendererAPI->SetVertexAttribute(index, size, stride, offset);
+}
+
+uint32_t RenderCommand::CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height, const RendererEnum wrap,
+                                        const void *data)
+{
+    if (data) s_Stats.Uploads++;
+    return s_RendererAPI->CreateTexture2D(format, width, height, wrap, data);
+}
+
+void RenderCommand::SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                                   const void *data)
+{
+    s_Stats.Uploads++;
+    s_RendererAPI->SetTextureData(texture, format, width, height, data);
+}
+
+void RenderCommand::DeleteTexture(uint32_t texture) { s_RendererAPI->DeleteTexture(texture); }
+
+void RenderCommand::BindTexture(uint32_t slot, uint32_t texture, const RendererEnum target)
+{
+    TrackStateChange(s_BoundTextures[slot % s_BoundTextures.size()], texture);
+    s_RendererAPI->BindTexture(slot, texture, target);
+}
+
+void RenderCommand::ClearTexture(uint32_t texture, int value) { s_RendererAPI->ClearTexture(texture, value); }
+
+void RenderCommand::ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data)
+{
+    s_RendererAPI->ReadTextureData(texture, format, size, data);
+}
+
+void RenderCommand::ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size, uint32_t buffer)
+{
+    s_RendererAPI->ReadTextureDataToBuffer(texture, format, size, buffer);
+}
+
+uint32_t RenderCommand::CreateFramebuffer() { return s_RendererAPI->CreateFramebuffer(); }
+
+void RenderCommand::DeleteFramebuffer(uint32_t framebuffer) { s_RendererAPI->DeleteFramebuffer(framebuffer); }
+
+void RenderCommand::BindFramebuffer(uint32_t framebuffer)
+{
+    TrackStateChange(s_BoundFramebuffer, framebuffer);
+    s_RendererAPI->BindFramebuffer(framebuffer);
+}
+
+void RenderCommand::AttachTexture(uint32_t attachment, uint32_t texture, int mip)
+{
+    s_RendererAPI->AttachTexture(attachment, texture, mip);
+}
+
+void RenderCommand::SetDrawBuffers(const uint32_t *attachments, int count)
+{
+    s_RendererAPI->SetDrawBuffers(attachments, count);
+}
+
+uint32_t RenderCommand::CreateDepthRenderbuffer(uint32_t width, uint32_t height)
+{
+    return s_RendererAPI->CreateDepthRenderbuffer(width, height);
+}
+
+void RenderCommand::DeleteRenderbuffer(uint32_t renderbuffer) { s_RendererAPI->DeleteRenderbuffer(renderbuffer); }
+
+bool RenderCommand::IsFramebufferComplete() { return s_RendererAPI->IsFramebufferComplete(); }
+
+int RenderCommand::ReadPixel(uint32_t attachmentIndex, int x, int y)
+{
+    return s_RendererAPI->ReadPixel(attachmentIndex, x, y);
+}
+
+uint32_t RenderCommand::CreateProgram(const std::string &vertexSource, const std::string &fragmentSource)
+{
+    return s_RendererAPI->CreateProgram(vertexSource, fragmentSource);
+}
+
+void RenderCommand::DeleteProgram(uint32_t program) { s_RendererAPI->DeleteProgram(program); }
+
+void RenderCommand::UseProgram(uint32_t program)
+{
+    TrackStateChange(s_BoundProgram, program);
+    s_RendererAPI->UseProgram(program);
+}
+
+int RenderCommand::GetUniformLocation(uint32_t program, const std::string &name)
+{
+    return s_RendererAPI->GetUniformLocation(program, name);
+}
+
+uint32_t RenderCommand::CreateComputeProgram(const std::string &computeSource)
+{
+    return s_RendererAPI->CreateComputeProgram(computeSource);
+}
+
+void RenderCommand::DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ)
+{
+    s_Stats.Dispatches++;
+    s_RendererAPI->DispatchCompute(groupsX, groupsY, groupsZ);
+}
+
+void RenderCommand::BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format, const RendererEnum access)
+{
+    TrackStateChange(s_BoundImageTextures[unit % s_BoundImageTextures.size()], texture);
+    s_RendererAPI->BindImageTexture(unit, texture, format, access);
+}
+
+void RenderCommand::BindBufferBase(const RendererEnum target, uint32_t index, uint32_t buffer)
+{
+    TrackStateChange(s_BoundBufferBases[(uint32_t)target << 16 | index], buffer);
+    s_RendererAPI->BindBufferBase(target, index, buffer);
+}
+
+void RenderCommand::InsertMemoryBarrier() { s_RendererAPI->InsertMemoryBarrier(); }
+
+uint32_t RenderCommand::CreateQuery() { return s_RendererAPI->CreateQuery(); }
+
+void RenderCommand::DeleteQuery(uint32_t query) { s_RendererAPI->DeleteQuery(query); }
+
+void RenderCommand::BeginTimerQuery(uint32_t query) { s_RendererAPI->BeginTimerQuery(query); }
+
+void RenderCommand::EndTimerQuery() { s_RendererAPI->EndTimerQuery(); }
+
+bool RenderCommand::IsQueryResultAvailable(uint32_t query) { return s_RendererAPI->IsQueryResultAvailable(query); }
+
+uint64_t RenderCommand::GetQueryResult(uint32_t query) { return s_RendererAPI->GetQueryResult(query); }
+
+uint32_t RenderCommand::CreateFence() { return s_RendererAPI->CreateFence(); }
+
+void RenderCommand::DeleteFence(uint32_t fence) { s_RendererAPI->DeleteFence(fence); }
 
-void RenderCommand::DrawLines(int from, int count) { glDrawArrays(GL_LINES, from, count); }
+bool RenderCommand::IsFenceSignaled(uint32_t fence) { return s_RendererAPI->IsFenceSignaled(fence); }
 } // namespace Engine
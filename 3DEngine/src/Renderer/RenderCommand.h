@@ -2,45 +2,158 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "RendererAPI.h"
+
 namespace Engine
 {
-enum class RendererEnum
+// Per-frame counters, filled by RenderCommand (draws, state changes) and the renderer front-end (submits,
+// batches, culls). Reset with RenderCommand::ResetStats() at the start of a frame and published with PublishStats()
+// at its end; other threads only read the published copy.
+struct RenderStats
 {
-    INT,
-    UINT,
-    BYTE,
-    UBYTE,
-    FLOAT,
-    UFLOAT,
-    ARRAY_BUFFER,
-    ELEMENT_ARRAY_BUFFER,
-    TRIANGLES,
-    LINES,
-    DEPTH_ATTACHMENT,
-    COLOR_ATTACHMENT0,
-    COLOR_ATTACHMENT1,
-    DEPTH_TEST,
-    FACE_CULL,
-    STATIC_DRAW,
-    DYNAMIC_DRAW,
-    STREAM_DRAW,
-	BLEND,
+    uint32_t Submits = 0;
+    uint32_t Batches = 0; // material buckets the render list was sorted into
+    uint32_t Culled = 0;
+    uint32_t DrawCalls = 0;
+    uint32_t Dispatches = 0;
+    uint32_t Triangles = 0;
+    uint32_t StateChanges = 0;
+    uint32_t RedundantStateChanges = 0;
+    uint32_t RenderPasses = 0;
+    uint32_t CulledPasses = 0;
+    uint32_t Uploads = 0;     // buffer and texture data sent to the GPU
+    uint64_t UploadBytes = 0; // buffers only, texture sizes depend on the format
 };
 
 class RenderCommand
 {
   public:
+    // Creates the backend selected through RendererAPI::SetAPI.
+    static void Init();
+    static RendererAPI *GetRendererAPI() { return s_RendererAPI.get(); }
+
+    // the frame being rendered, only for the thread that renders
+    static RenderStats &GetStats() { return s_Stats; }
+    static void ResetStats() { s_Stats = RenderStats(); }
+    static void PublishStats();
+    // the last published frame, from any thread; trails the update by the frame latency when pipelined
+    static RenderStats GetFrameStats();
+    // lets the backend drop what it kept of the frame, on the thread that renders once the frame is drawn
+    static void EndFrame();
+
     static void Clear();
     static void SetClearColor(const glm::vec3 &color);
+    static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 
     static void Enable(const RendererEnum enumType);
     static void Disable(const RendererEnum enumType);
+    static void SetDepthMask(bool write);
+    static void SetColorMask(bool write);
+    static void SetDepthFunc(const RendererEnum func);
+    static void SetBlendFunc(const RendererEnum src, const RendererEnum dst);
 
     static void DrawMultiElements(const RendererEnum mode, const int count, const RendererEnum type,
                                   const void *const *indices, unsigned int drawCount);
     static void DrawElements(const RendererEnum mode, const int count, const RendererEnum type, const void *indices);
     static void DrawArrays(int first, int count);
+    static void DrawArrays(const RendererEnum mode, int first, int count);
 
     static void DrawLines(int first, int count);
+
+    // vertex arrays and buffers
+    static uint32_t CreateVertexArray();
+    static void DeleteVertexArray(uint32_t vao);
+    static void BindVertexArray(uint32_t vao);
+    static uint32_t CreateBuffer(const RendererEnum target, int size, const void *data, const RendererEnum usage);
+    static void SetBufferSubData(const RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                 const void *data);
+    static void DeleteBuffer(uint32_t buffer);
+    static void GetBufferData(const RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size, void *data);
+    static void SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset);
+
+    // textures
+    static uint32_t CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height,
+                                    const RendererEnum wrap = RendererEnum::CLAMP_TO_BORDER,
+                                    const void *data = nullptr);
+    static void SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                               const void *data);
+    static void DeleteTexture(uint32_t texture);
+    static void BindTexture(uint32_t slot, uint32_t texture, const RendererEnum target = RendererEnum::TEXTURE_2D);
+    static void ClearTexture(uint32_t texture, int value);
+    static void ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data);
+    static void ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size, uint32_t buffer);
+
+    // framebuffers
+    static uint32_t CreateFramebuffer();
+    static void DeleteFramebuffer(uint32_t framebuffer);
+    static void BindFramebuffer(uint32_t framebuffer);
+    static void AttachTexture(uint32_t attachment, uint32_t texture, int mip = 0);
+    static void SetDrawBuffers(const uint32_t *attachments, int count);
+    static uint32_t CreateDepthRenderbuffer(uint32_t width, uint32_t height);
+    static void DeleteRenderbuffer(uint32_t renderbuffer);
+    static bool IsFramebufferComplete();
+    static int ReadPixel(uint32_t attachmentIndex, int x, int y);
+
+    // shaders
+    static uint32_t CreateProgram(const std::string &vertexSource, const std::string &fragmentSource);
+    static void DeleteProgram(uint32_t program);
+    static void UseProgram(uint32_t program);
+    static int GetUniformLocation(uint32_t program, const std::string &name);
+    template <typename T> static void SetUniform(int location, const T &value)
+    {
+        if (location == -1) return;
+        s_RendererAPI->SetUniform(location, value);
+    }
+
+    // compute
+    static uint32_t CreateComputeProgram(const std::string &computeSource);
+    static void DispatchCompute(uint32_t groupsX, uint32_t groupsY = 1, uint32_t groupsZ = 1);
+    static void BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format,
+                                 const RendererEnum access = RendererEnum::READ_WRITE);
+    static void BindBufferBase(const RendererEnum target, uint32_t index, uint32_t buffer);
+    static void InsertMemoryBarrier();
+
+    // timer queries
+    static uint32_t CreateQuery();
+    static void DeleteQuery(uint32_t query);
+    static void BeginTimerQuery(uint32_t query);
+    static void EndTimerQuery();
+    static bool IsQueryResultAvailable(uint32_t query);
+    static uint64_t GetQueryResult(uint32_t query);
+
+    // fences
+    static uint32_t CreateFence();
+    static void DeleteFence(uint32_t fence);
+    static bool IsFenceSignaled(uint32_t fence);
+
+  private:
+    static void TrackStateChange(uint32_t &current, uint32_t value);
+
+  private:
+    static std::unique_ptr<RendererAPI> s_RendererAPI;
+    static RenderStats s_Stats;
+    static RenderStats s_PublishedStats;
+    static std::mutex s_PublishedStatsMutex;
+
+    // last bound objects and set state, only used to tell real state changes from redundant ones; state that was
+    // never set starts as UnknownState so its first change counts
+    static constexpr uint32_t UnknownState = UINT32_MAX;
+    static uint32_t s_BoundProgram;
+    static uint32_t s_BoundVertexArray;
+    static uint32_t s_BoundFramebuffer;
+    static std::array<uint32_t, 32> s_BoundTextures;
+    static std::array<uint32_t, 8> s_BoundImageTextures;
+    static std::unordered_map<uint32_t, uint32_t> s_BoundBufferBases; // target << 16 | index
+    static std::unordered_map<uint32_t, uint32_t> s_Capabilities;     // 1 enabled, 0 disabled
+    static uint32_t s_DepthMask;
+    static uint32_t s_ColorMask;
+    static uint32_t s_DepthFunc;
+    static uint32_t s_BlendFunc; // src << 16 | dst
 };
 } // namespace Engine
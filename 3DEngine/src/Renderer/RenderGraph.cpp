@@ -0,0 +1,274 @@
+#include "RenderGraph.h"
+
+#include "Framebuffer.h"
+#include "RenderCommand.h"
+#include "Log.h"
+#include "Profiler.h"
+
+#include <algorithm>
+
+namespace Engine
+{
+// frames a pooled target may stay unused before it is freed, long enough to ride out a viewport drag
+constexpr uint64_t MaxUnusedFrames = 3;
+
+Texture2DRef RenderTargetPool::Acquire(ImageFormat format, uint32_t width, uint32_t height)
+{
+    for (auto &entry : m_Entries)
+    {
+        const auto &spec = entry.Texture->GetSpecification();
+        if (entry.InUse || spec.Format != format || spec.Width != width || spec.Height != height) continue;
+
+        entry.InUse = true;
+        entry.LastUsedFrame = m_FrameIndex;
+        return entry.Texture;
+    }
+
+    TextureSpecification spec;
+    spec.Width = width;
+    spec.Height = height;
+    spec.Format = format;
+    spec.GenerateMips = false;
+
+    m_Entries.push_back({std::make_shared<Texture2D>(spec), m_FrameIndex, true});
+    return m_Entries.back().Texture;
+}
+
+void RenderTargetPool::Release(const Texture2DRef &texture)
+{
+    for (auto &entry : m_Entries)
+    {
+        if (entry.Texture != texture) continue;
+
+        entry.InUse = false;
+        return;
+    }
+}
+
+void RenderTargetPool::NextFrame()
+{
+    m_FrameIndex++;
+    std::erase_if(m_Entries, [this](const Entry &entry)
+                  { return !entry.InUse && m_FrameIndex - entry.LastUsedFrame > MaxUnusedFrames; });
+}
+
+RenderGraphResource RenderGraphBuilder::CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc)
+{
+    RenderGraphResource resource = m_Graph.m_Resources.size();
+    RenderGraph::ResourceNode &node = m_Graph.m_Resources.emplace_back();
+    node.Name = name;
+    node.Desc = desc;
+    m_Graph.m_Passes[m_PassIndex].Creates.push_back(resource);
+    return resource;
+}
+
+RenderGraphResource RenderGraphBuilder::Read(RenderGraphResource resource)
+{
+    if (resource == InvalidRenderGraphResource) return resource;
+
+    m_Graph.m_Passes[m_PassIndex].Reads.push_back(resource);
+    return resource;
+}
+
+RenderGraphResource RenderGraphBuilder::Write(RenderGraphResource resource, uint32_t attachment)
+{
+    auto &node = m_Graph.m_Resources[resource];
+    if (node.Producer != UINT32_MAX)
+        LOG_CORE_WARN("RenderGraph: '{}' is written by more than one pass", node.Name);
+
+    node.Producer = m_PassIndex;
+    m_Graph.m_Passes[m_PassIndex].Writes.push_back({attachment, resource});
+    return resource;
+}
+
+RenderGraphResource RenderGraphBuilder::WriteImage(RenderGraphResource resource)
+{
+    auto &node = m_Graph.m_Resources[resource];
+    if (node.Producer != UINT32_MAX)
+        LOG_CORE_WARN("RenderGraph: '{}' is written by more than one pass", node.Name);
+
+    node.Producer = m_PassIndex;
+    m_Graph.m_Passes[m_PassIndex].ImageWrites.push_back(resource);
+    return resource;
+}
+
+Texture2DRef RenderGraphResources::GetTexture(RenderGraphResource resource) const
+{
+    if (resource == InvalidRenderGraphResource) return nullptr;
+    return m_Graph.m_Resources[resource].Texture;
+}
+
+RenderGraph::~RenderGraph()
+{
+    for (auto &framebuffer : m_Framebuffers)
+        RenderCommand::DeleteFramebuffer(framebuffer.ID);
+}
+
+RenderGraphResource RenderGraph::ImportTexture(const std::string &name, Texture2DRef texture)
+{
+    RenderGraphResource resource = m_Resources.size();
+    ResourceNode &node = m_Resources.emplace_back();
+    node.Name = name;
+    node.Texture = std::move(texture);
+    node.Imported = true;
+    return resource;
+}
+
+void RenderGraph::AddPass(const std::string &name, const SetupFunc &setup, ExecuteFunc execute)
+{
+    uint32_t passIndex = m_Passes.size();
+    PassNode &pass = m_Passes.emplace_back();
+    pass.Name = name;
+    pass.Execute = std::move(execute);
+
+    RenderGraphBuilder builder(*this, passIndex);
+    setup(builder);
+    m_Passes[passIndex].SideEffects = builder.m_SideEffects;
+}
+
+void RenderGraph::Compile()
+{
+    PROFILE_FUNCTION();
+    // cull: start from resources nobody reads and walk back through their producers
+    for (auto &pass : m_Passes)
+    {
+        pass.RefCount = pass.Writes.size() + pass.ImageWrites.size() + (pass.SideEffects ? 1 : 0);
+        for (auto resource : pass.Reads)
+            m_Resources[resource].RefCount++;
+    }
+
+    std::vector<RenderGraphResource> unreferenced;
+    for (RenderGraphResource i = 0; i < m_Resources.size(); i++)
+        if (m_Resources[i].RefCount == 0 && !m_Resources[i].Imported) unreferenced.push_back(i);
+
+    while (!unreferenced.empty())
+    {
+        auto &resource = m_Resources[unreferenced.back()];
+        unreferenced.pop_back();
+        if (resource.Producer == UINT32_MAX) continue;
+
+        auto &producer = m_Passes[resource.Producer];
+        if (producer.RefCount == 0 || --producer.RefCount > 0) continue;
+
+        producer.Culled = true;
+        m_CulledPassCount++;
+        for (auto read : producer.Reads)
+            if (--m_Resources[read].RefCount == 0 && !m_Resources[read].Imported) unreferenced.push_back(read);
+    }
+
+    // lifetimes of what is left, in pass order
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        auto &pass = m_Passes[i];
+        if (pass.Culled) continue;
+
+        auto touch = [&](RenderGraphResource resource)
+        {
+            auto &node = m_Resources[resource];
+            node.FirstUse = std::min(node.FirstUse, i);
+            node.LastUse = std::max(node.LastUse, i);
+        };
+        for (auto resource : pass.Creates)
+            touch(resource);
+        for (auto resource : pass.Reads)
+            touch(resource);
+        for (auto &[attachment, resource] : pass.Writes)
+            touch(resource);
+        for (auto resource : pass.ImageWrites)
+            touch(resource);
+    }
+}
+
+void RenderGraph::BindPassTargets(uint32_t passIndex)
+{
+    const auto &pass = m_Passes[passIndex];
+    if (pass.Writes.empty()) return;
+
+    if (m_Framebuffers.size() <= passIndex) m_Framebuffers.resize(passIndex + 1);
+    auto &framebuffer = m_Framebuffers[passIndex];
+    if (framebuffer.ID == 0) framebuffer.ID = RenderCommand::CreateFramebuffer();
+
+    RenderCommand::BindFramebuffer(framebuffer.ID);
+
+    // detach whatever this slot had last frame so stale targets don't linger
+    for (auto attachment : framebuffer.Attachments)
+        RenderCommand::AttachTexture(attachment, 0);
+    framebuffer.Attachments.clear();
+
+    std::vector<uint32_t> drawBuffers;
+    glm::vec2 size = m_Size;
+    for (auto &[attachment, resource] : pass.Writes)
+    {
+        const auto &texture = m_Resources[resource].Texture;
+        RenderCommand::AttachTexture(attachment, texture->GetRendererID());
+        framebuffer.Attachments.push_back(attachment);
+
+        if (attachment != GL_DEPTH_ATTACHMENT) drawBuffers.push_back(attachment);
+        size = texture->GetSize();
+    }
+
+    if (!drawBuffers.empty()) RenderCommand::SetDrawBuffers(drawBuffers.data(), drawBuffers.size());
+
+    RenderCommand::SetViewport(0, 0, size.x, size.y);
+    RenderCommand::Clear();
+}
+
+void RenderGraph::Execute()
+{
+    RenderGraphResources resources(*this);
+    m_GPUTime = 0.0f;
+
+    for (uint32_t i = 0; i < m_Passes.size(); i++)
+    {
+        auto &pass = m_Passes[i];
+        if (pass.Culled) continue;
+
+        // transient targets come out of the pool right before their first use
+        for (auto &node : m_Resources)
+        {
+            if (node.Imported || node.FirstUse != i) continue;
+
+            glm::vec2 size = node.Desc.Size == glm::vec2(0.0f) ? m_Size : node.Desc.Size;
+            node.Texture = m_Pool.Acquire(node.Desc.Format, std::max(1u, (uint32_t)size.x),
+                                          std::max(1u, (uint32_t)size.y));
+        }
+
+#ifdef ENGINE_PROFILE
+        const char *passName = Profiler::InternName(pass.Name);
+        const double passStart = Profiler::Now();
+#endif
+        auto &timer = m_PassTimers[pass.Name];
+        {
+            PROFILE_SCOPE(passName);
+            timer.Begin();
+            BindPassTargets(i);
+            pass.Execute(resources);
+            timer.End();
+        }
+        m_GPUTime += timer.GetTime();
+#ifdef ENGINE_PROFILE
+        Profiler::RecordGPU(passName, passStart, timer.GetTime());
+#endif
+
+        // ...and go back after their last, so a later pass can alias them
+        for (auto &node : m_Resources)
+            if (!node.Imported && node.Texture && node.LastUse == i) m_Pool.Release(node.Texture);
+    }
+
+    RenderCommand::BindFramebuffer(0);
+
+    auto &stats = RenderCommand::GetStats();
+    stats.RenderPasses += m_Passes.size() - m_CulledPassCount;
+    stats.CulledPasses += m_CulledPassCount;
+
+    Reset();
+}
+
+void RenderGraph::Reset()
+{
+    m_Resources.clear();
+    m_Passes.clear();
+    m_CulledPassCount = 0;
+    m_Pool.NextFrame();
+}
+} // namespace Engine
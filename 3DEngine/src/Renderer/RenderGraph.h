@@ -0,0 +1,167 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "GPUTimer.h"
+#include "Texture2D.h"
+
+namespace Engine
+{
+using RenderGraphResource = uint32_t;
+constexpr RenderGraphResource InvalidRenderGraphResource = UINT32_MAX;
+
+struct RenderGraphTextureDesc
+{
+    ImageFormat Format = ImageFormat::RGBA8;
+    glm::vec2 Size = glm::vec2(0.0f); // zero means the size of the frame
+};
+
+// Keeps render targets alive across frames so that passes with disjoint lifetimes, and following frames, can
+// share them. Targets that have not been asked for in a few frames (e.g. after a resize) are released.
+class RenderTargetPool
+{
+  public:
+    Texture2DRef Acquire(ImageFormat format, uint32_t width, uint32_t height);
+    void Release(const Texture2DRef &texture);
+
+    void NextFrame();
+    void Clear() { m_Entries.clear(); }
+
+    uint32_t GetTextureCount() const { return m_Entries.size(); }
+
+  private:
+    struct Entry
+    {
+        Texture2DRef Texture;
+        uint64_t LastUsedFrame = 0;
+        bool InUse = false;
+    };
+
+    std::vector<Entry> m_Entries;
+    uint64_t m_FrameIndex = 0;
+};
+
+class RenderGraph;
+
+class RenderGraphBuilder
+{
+  public:
+    RenderGraphResource CreateTexture(const std::string &name, const RenderGraphTextureDesc &desc = {});
+    RenderGraphResource Read(RenderGraphResource resource);
+    // attachment is the framebuffer attachment point (GL_COLOR_ATTACHMENT0.., GL_DEPTH_ATTACHMENT)
+    RenderGraphResource Write(RenderGraphResource resource, uint32_t attachment = 0x8CE0);
+    // written through image stores (compute) rather than as a framebuffer attachment
+    RenderGraphResource WriteImage(RenderGraphResource resource);
+
+    // the pass renders to something outside the graph and can never be culled
+    void SetSideEffects() { m_SideEffects = true; }
+
+  private:
+    RenderGraphBuilder(RenderGraph &graph, uint32_t passIndex) : m_Graph(graph), m_PassIndex(passIndex) {}
+
+    RenderGraph &m_Graph;
+    uint32_t m_PassIndex;
+    bool m_SideEffects = false;
+
+    friend class RenderGraph;
+};
+
+class RenderGraphResources
+{
+  public:
+    Texture2DRef GetTexture(RenderGraphResource resource) const;
+
+  private:
+    RenderGraphResources(const RenderGraph &graph) : m_Graph(graph) {}
+
+    const RenderGraph &m_Graph;
+
+    friend class RenderGraph;
+};
+
+// Rebuilt every frame: passes are added with a setup function declaring what they read and write, then
+// Compile() culls the passes whose outputs nobody reads and works out resource lifetimes, and Execute() runs
+// the rest in order. Transient textures come from the pool at their first use and go back after their last.
+class RenderGraph
+{
+  public:
+    using SetupFunc = std::function<void(RenderGraphBuilder &)>;
+    using ExecuteFunc = std::function<void(const RenderGraphResources &)>;
+
+  public:
+    ~RenderGraph();
+
+    void SetSize(const glm::vec2 &size) { m_Size = size; }
+    glm::vec2 GetSize() const { return m_Size; }
+
+    RenderGraphResource ImportTexture(const std::string &name, Texture2DRef texture);
+    void AddPass(const std::string &name, const SetupFunc &setup, ExecuteFunc execute);
+
+    void Compile();
+    void Execute();
+
+    uint32_t GetPassCount() const { return m_Passes.size(); }
+    uint32_t GetCulledPassCount() const { return m_CulledPassCount; }
+    const RenderTargetPool &GetPool() const { return m_Pool; }
+    // GPU time of every pass that has run, by name; a few frames behind
+    const std::map<std::string, GPUTimer> &GetPassTimers() const { return m_PassTimers; }
+    // summed over the passes of the last executed frame, in milliseconds
+    float GetGPUTime() const { return m_GPUTime; }
+
+  private:
+    struct ResourceNode
+    {
+        std::string Name;
+        RenderGraphTextureDesc Desc;
+        Texture2DRef Texture;
+        bool Imported = false;
+
+        uint32_t Producer = UINT32_MAX;
+        uint32_t RefCount = 0;
+        uint32_t FirstUse = UINT32_MAX, LastUse = 0;
+    };
+
+    struct PassNode
+    {
+        std::string Name;
+        ExecuteFunc Execute;
+        std::vector<RenderGraphResource> Creates;
+        std::vector<RenderGraphResource> Reads;
+        std::vector<std::pair<uint32_t, RenderGraphResource>> Writes;
+        std::vector<RenderGraphResource> ImageWrites;
+        bool SideEffects = false;
+
+        uint32_t RefCount = 0;
+        bool Culled = false;
+    };
+
+    void BindPassTargets(uint32_t passIndex);
+    void Reset();
+
+  private:
+    glm::vec2 m_Size = glm::vec2(1280.0f, 720.0f);
+
+    std::vector<ResourceNode> m_Resources;
+    std::vector<PassNode> m_Passes;
+    uint32_t m_CulledPassCount = 0;
+
+    // one framebuffer object per pass slot, reattached every frame instead of recreated
+    struct PassFramebuffer
+    {
+        uint32_t ID = 0;
+        std::vector<uint32_t> Attachments;
+    };
+    std::vector<PassFramebuffer> m_Framebuffers;
+    RenderTargetPool m_Pool;
+    std::map<std::string, GPUTimer> m_PassTimers;
+    float m_GPUTime = 0.0f;
+
+    friend class RenderGraphBuilder;
+    friend class RenderGraphResources;
+};
+} // namespace Engine
@@ -1,46 +1,49 @@
 #pragma once
 
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 #include <glm/glm.hpp>
 
+#include "Allocators.h"
 #include "Mesh.h"
 #include "Shaders/ShaderManager.h"
 #include "Material.h"
+#include "RenderSnapshot.h"
 #include "Light.h"
-#include "AssetManager.h"
 #include "Log.h"
+#include "RenderCommand.h"
 
 namespace Engine
 {
+// the mesh and its materials belong to a snapshot the submitter keeps alive until the list is flushed
 struct RenderMesh
 {
-    MeshRef Mesh;
+    Engine::Mesh *Mesh;
+    const Material *Maps;
     glm::mat4 Transform;
     int32_t EntityId;
 };
 
-using RenderListMap = std::unordered_map<MaterialRef, std::vector<RenderMesh>>;
+// map nodes come from the list's pool, the per material lists from the rendering thread's frame arena
+using RenderListMap =
+    std::unordered_map<MaterialRef, FrameVector<RenderMesh>, std::hash<MaterialRef>, std::equal_to<MaterialRef>,
+                       PoolAllocator<std::pair<const MaterialRef, FrameVector<RenderMesh>>>>;
 
 class RenderList
 {
   public:
-    RenderList()
-    {
-        //
-        m_RenderList = RenderListMap();
-    }
+    RenderList() : m_RenderList(RenderListMap::allocator_type(m_Pool)) {}
 
-    void AddToRenderList(MeshRef mesh, glm::mat4 &transform, const int32_t entityId = -1)
+    // materials come resolved, the asset manager isn't safe to use on the rendering thread
+    void AddToRenderList(Mesh *mesh, const MeshMaterials &materials, const glm::mat4 &transform,
+                         const int32_t entityId = -1)
     {
-        MaterialRef material = AssetManager::GetAsset<Material>(mesh->MaterialHandle > 0 ? 
-			mesh->MaterialHandle : mesh->DefaultMaterialHandle);
-        if (m_RenderList.find(material) == m_RenderList.end())
-        {
-            m_RenderList[material] = std::vector<RenderMesh>();
-        }
+        if (materials.Material == nullptr) return;
 
-        m_RenderList[material].push_back({std::move(mesh), std::move(transform), entityId});
+        const Material *maps = materials.Default ? materials.Default.get() : materials.Material.get();
+        RenderCommand::GetStats().Submits++;
+        m_RenderList.try_emplace(materials.Material).first->second.push_back({mesh, maps, transform, entityId});
     }
 
     void Flush(Shader *shader, bool depthOnly = false)
@@ -48,6 +51,7 @@ class RenderList
         shader->Bind();
         const uint32_t entityIdUniformLocation = shader->FindUniformLocation("entityId");
         const uint32_t modelMatrixUniformLocation = shader->FindUniformLocation("model");
+        RenderCommand::GetStats().Batches += m_RenderList.size();
         for (auto &i : m_RenderList)
         {
             if (!depthOnly) i.first->Bind(shader);
@@ -57,12 +61,11 @@ class RenderList
                 shader->SetUniform1i(entityIdUniformLocation, m.EntityId + 1);
                 //shader->SetUniformMatrix3fv("normalMatrix", glm::transpose(glm::inverse(glm::mat3(m.Transform))));
 
-				MaterialRef mat = AssetManager::GetAsset<Material>(m.Mesh->DefaultMaterialHandle);
-				shader->SetUniform1i("hasAlbedoMap", mat->HasMaterialMap(ParameterType::ALBEDO));
-                shader->SetUniform1i("hasNormalMap", mat->HasMaterialMap(ParameterType::NORMAL));
-                shader->SetUniform1i("hasMetallicMap", mat->HasMaterialMap(ParameterType::METALLIC));
-                shader->SetUniform1i("hasRoughnessMap", mat->HasMaterialMap(ParameterType::ROUGHNESS));
-                shader->SetUniform1i("hasAoMap", mat->HasMaterialMap(ParameterType::AO));
+                shader->SetUniform1i("hasAlbedoMap", m.Maps->HasMaterialMap(ParameterType::ALBEDO));
+                shader->SetUniform1i("hasNormalMap", m.Maps->HasMaterialMap(ParameterType::NORMAL));
+                shader->SetUniform1i("hasMetallicMap", m.Maps->HasMaterialMap(ParameterType::METALLIC));
+                shader->SetUniform1i("hasRoughnessMap", m.Maps->HasMaterialMap(ParameterType::ROUGHNESS));
+                shader->SetUniform1i("hasAoMap", m.Maps->HasMaterialMap(ParameterType::AO));
 
                 m.Mesh->Draw(shader, true);
             }
@@ -70,8 +73,35 @@ class RenderList
         shader->Unbind();
         m_RenderList.clear();
     }
+
+    // Depth only, nearest first so the meshes behind fail early. The list is kept for the shading flush after it.
+    void FlushDepth(Shader *shader, const glm::vec3 &cameraPosition)
+    {
+        m_DepthOrder.clear();
+        for (auto &i : m_RenderList)
+        {
+            for (auto &m : i.second)
+            {
+                glm::vec3 offset = glm::vec3(m.Transform[3]) - cameraPosition;
+                m_DepthOrder.push_back({glm::dot(offset, offset), &m});
+            }
+        }
+        std::sort(m_DepthOrder.begin(), m_DepthOrder.end(),
+                  [](const auto &a, const auto &b) { return a.first < b.first; });
+
+        shader->Bind();
+        const uint32_t modelMatrixUniformLocation = shader->FindUniformLocation("model");
+        for (auto &[distance, m] : m_DepthOrder)
+        {
+            shader->SetUniformMatrix4fv(modelMatrixUniformLocation, m->Transform);
+            m->Mesh->Draw(shader, false);
+        }
+        shader->Unbind();
+    }
 	 
   private:
+    SmallObjectPool m_Pool;
     RenderListMap m_RenderList;
+    std::vector<std::pair<float, const RenderMesh *>> m_DepthOrder;
 };
 } // namespace Engine
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Allocators.h"
+#include "Environment.h"
+#include "Framebuffer.h"
+#include "Light.h"
+#include "Material.h"
+#include "Model.h"
+
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+// a mesh's materials, resolved where the asset manager may be used
+struct MeshMaterials
+{
+    MaterialRef Material; // the override or the default, what the mesh is drawn with
+    MaterialRef Default;  // which maps the shaders sample
+};
+
+// a mesh entity the way the renderer sees it
+struct MeshProxy
+{
+    ModelRef Model;
+    glm::mat4 Transform;
+    int EntityId;
+    // the model's meshes' materials start here in RenderSnapshot::Materials
+    uint32_t FirstMaterial = 0;
+};
+
+// Everything SceneRenderer reads of a scene for one frame, copied out at the end of the update so a render thread
+// can draw it while the scene already simulates the next one. GPU resources (models, sky maps, the framebuffer)
+// are shared rather than copied.
+struct RenderSnapshot
+{
+    glm::mat4 Projection, View;
+    glm::vec3 CameraPosition;
+
+    // culling results live in the capturing thread's frame arena, a snapshot must not outlive its frame's render
+    FrameVector<MeshProxy> Meshes;   // visible ones
+    FrameVector<MeshProxy> Selected; // outlined, whether visible or not
+    uint32_t CulledMeshes = 0;
+    FrameVector<MeshMaterials> Materials;
+
+    LightValues Lights;
+    // parameters by value, the sky and bloom objects are shared
+    Engine::Environment Environment;
+
+    FramebufferRef Target;
+    glm::vec2 ViewportMousePos = glm::vec2(0.0f);
+    bool IsPlaying = false;
+    bool HasSelection = false;
+};
+
+using RenderSnapshotRef = std::shared_ptr<const RenderSnapshot>;
+} // namespace Engine
@@ -0,0 +1,161 @@
+#include "RenderThread.h"
+
+#include "Allocators.h"
+#include "Log.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+namespace Utils
+{
+struct RenderFrame
+{
+    std::vector<RenderThreadCommand> Commands;
+    bool Present = true;
+};
+
+static std::thread s_RenderThread;
+static GLFWwindow *s_Window = nullptr;
+static uint32_t s_FrameLatency = 1;
+static std::atomic<bool> s_Running = false;
+
+static std::mutex s_Mutex;
+static std::condition_variable s_FrameQueued, s_FrameRendered;
+static std::deque<RenderFrame> s_Frames;
+static uint32_t s_FramesInFlight = 0;
+static bool s_Quit = false;
+
+// only touched by the main thread
+static RenderFrame s_Recording;
+
+static thread_local bool t_IsRenderThread = false;
+} // namespace Utils
+
+void RenderThread::Start(GLFWwindow *window, uint32_t frameLatency)
+{
+    if (Utils::s_Running) return;
+
+    Utils::s_Window = window;
+    Utils::s_FrameLatency = std::clamp(frameLatency, 1u, 2u);
+    Utils::s_Quit = false;
+
+    // a context can only be current on one thread
+    if (window) glfwMakeContextCurrent(nullptr);
+    Utils::s_Running = true;
+    Utils::s_RenderThread = std::thread(RenderMain);
+
+    LOG_CORE_INFO("RenderThread: started, {} frame latency", Utils::s_FrameLatency);
+}
+
+void RenderThread::Stop()
+{
+    if (!Utils::s_Running) return;
+
+    if (!Utils::s_Recording.Commands.empty()) EndFrame(false);
+    {
+        std::scoped_lock<std::mutex> lock(Utils::s_Mutex);
+        Utils::s_Quit = true;
+    }
+    Utils::s_FrameQueued.notify_one();
+    Utils::s_RenderThread.join();
+
+    Utils::s_Running = false;
+    if (Utils::s_Window) glfwMakeContextCurrent(Utils::s_Window);
+}
+
+bool RenderThread::IsRunning() { return Utils::s_Running; }
+
+bool RenderThread::IsRenderThread() { return Utils::t_IsRenderThread; }
+
+uint32_t RenderThread::GetFrameLatency() { return Utils::s_Running ? Utils::s_FrameLatency : 0; }
+
+void RenderThread::Submit(RenderThreadCommand command)
+{
+    if (!Utils::s_Running || Utils::t_IsRenderThread)
+    {
+        command();
+        return;
+    }
+    Utils::s_Recording.Commands.push_back(std::move(command));
+}
+
+void RenderThread::EndFrame(bool present)
+{
+    if (!Utils::s_Running) return;
+
+    PROFILE_FUNCTION();
+    Utils::s_Recording.Present = present;
+    {
+        std::unique_lock<std::mutex> lock(Utils::s_Mutex);
+        Utils::s_Frames.push_back(std::move(Utils::s_Recording));
+        Utils::s_FramesInFlight++;
+        Utils::s_FrameQueued.notify_one();
+
+        // with a latency of one the next frame is simulated while this one renders, never further ahead
+        Utils::s_FrameRendered.wait(lock, [] { return Utils::s_FramesInFlight <= Utils::s_FrameLatency; });
+    }
+    Utils::s_Recording = Utils::RenderFrame();
+}
+
+void RenderThread::WaitIdle()
+{
+    if (!Utils::s_Running) return;
+
+    std::unique_lock<std::mutex> lock(Utils::s_Mutex);
+    Utils::s_FrameRendered.wait(lock, [] { return Utils::s_FramesInFlight == 0; });
+}
+
+void RenderThread::RenderMain()
+{
+    Utils::t_IsRenderThread = true;
+    Profiler::SetThreadName("Render");
+    MemoryTracker::SetThreadTag(MemoryTag::Renderer);
+    if (Utils::s_Window) glfwMakeContextCurrent(Utils::s_Window);
+
+    for (;;)
+    {
+        Utils::RenderFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(Utils::s_Mutex);
+            Utils::s_FrameQueued.wait(lock, [] { return Utils::s_Quit || !Utils::s_Frames.empty(); });
+            if (Utils::s_Frames.empty()) break;
+
+            frame = std::move(Utils::s_Frames.front());
+            Utils::s_Frames.pop_front();
+        }
+
+        {
+            PROFILE_SCOPE("RenderThread::Frame");
+            for (auto &command : frame.Commands)
+                command();
+        }
+        if (frame.Present && Utils::s_Window)
+        {
+            PROFILE_SCOPE("SwapBuffers");
+            glfwSwapBuffers(Utils::s_Window);
+        }
+        // the commands hold the main thread's frame data, which is only valid until the frame counts as rendered
+        frame.Commands.clear();
+        FrameArena::EndFrame();
+
+        {
+            std::scoped_lock<std::mutex> lock(Utils::s_Mutex);
+            Utils::s_FramesInFlight--;
+        }
+        Utils::s_FrameRendered.notify_all();
+    }
+
+    if (Utils::s_Window) glfwMakeContextCurrent(nullptr);
+}
+} // namespace Engine
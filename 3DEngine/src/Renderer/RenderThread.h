@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+struct GLFWwindow;
+
+namespace Engine
+{
+using RenderThreadCommand = std::function<void()>;
+
+// Optional thread that owns the GL context and renders frame N while the main thread simulates frame N+1. The
+// main thread records the GL work of a frame with Submit, mostly closures over a RenderSnapshot and the ImGui draw
+// data, and hands it over with EndFrame, which blocks while frameLatency frames are already in flight.
+//
+// Without Start(), Submit runs the command right away on the caller, so code written against it works either way.
+// While it runs, the main thread must not touch GL outside of Submit.
+class RenderThread
+{
+  public:
+    // window's context moves to the render thread until Stop(), null for a backend without one; latency is 1 or 2
+    static void Start(GLFWwindow *window, uint32_t frameLatency = 1);
+    // renders what was submitted and gives the context back to the caller
+    static void Stop();
+
+    static bool IsRunning();
+    static bool IsRenderThread();
+    static uint32_t GetFrameLatency();
+
+    static void Submit(RenderThreadCommand command);
+    // presenting swaps the window's buffers after the frame's commands
+    static void EndFrame(bool present = true);
+    // returns once every frame handed over so far was rendered
+    static void WaitIdle();
+
+  private:
+    static void RenderMain();
+};
+} // namespace Engine
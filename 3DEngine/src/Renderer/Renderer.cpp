@@ -1,6 +1,7 @@
 #include "Renderer.h"
 
 #include "RenderCommand.h"
+#include "MemoryTracker.h"
 
 namespace Engine
 {
@@ -29,7 +30,7 @@ std::vector<RVertex> QuadVertices
 
 void Renderer::Init()
 {
-    //
+    MEMORY_TAG(Renderer);
     QuadVAO = new VertexArray();
     QuadVAO->Init();
 
@@ -47,13 +48,19 @@ void Renderer::Init()
     QuadVAO->Unbind();
 }
 
-void Renderer::SubmitMesh(MeshRef mesh, glm::mat4 &transform, const int32_t entityId)
+void Renderer::SubmitMesh(Mesh *mesh, const MeshMaterials &materials, const glm::mat4 &transform,
+                          const int32_t entityId)
 {
-    m_RenderList.AddToRenderList(mesh, transform, entityId);
+    m_RenderList.AddToRenderList(mesh, materials, transform, entityId);
 }
 
 void Renderer::Flush(Shader *shader, bool depthOnly) { m_RenderList.Flush(shader, depthOnly); }
 
+void Renderer::FlushDepth(Shader *shader, const glm::vec3 &cameraPosition)
+{
+    m_RenderList.FlushDepth(shader, cameraPosition);
+}
+
 void Renderer::BeginDraw(CameraRef camera) {}
 
 void Renderer::EndDraw() {}
@@ -15,8 +15,10 @@ class Renderer
   public:
     static void Init();
 
-    static void SubmitMesh(MeshRef mesh, glm::mat4 &transform, const int32_t entityId = -1);
+    static void SubmitMesh(Mesh *mesh, const MeshMaterials &materials, const glm::mat4 &transform,
+                           const int32_t entityId = -1);
     static void Flush(Shader *shader, bool depthOnly = false);
+    static void FlushDepth(Shader *shader, const glm::vec3 &cameraPosition);
 
     // drawing states
     static void BeginDraw(CameraRef camera);
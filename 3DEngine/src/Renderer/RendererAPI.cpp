@@ -0,0 +1,20 @@
+#include "RendererAPI.h"
+
+#include "OpenGLRendererAPI.h"
+#include "NullRendererAPI.h"
+
+namespace Engine
+{
+RendererAPI::API RendererAPI::s_API = RendererAPI::API::OpenGL;
+
+std::unique_ptr<RendererAPI> RendererAPI::Create()
+{
+    switch (s_API)
+    {
+        case API::Null: return std::make_unique<NullRendererAPI>();
+        case API::OpenGL: return std::make_unique<OpenGLRendererAPI>();
+    }
+
+    return nullptr;
+}
+} // namespace Engine
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <string>
+
+#include "Texture.h"
+
+namespace Engine
+{
+enum class RendererEnum
+{
+    INT,
+    UINT,
+    BYTE,
+    UBYTE,
+    FLOAT,
+    UFLOAT,
+    ARRAY_BUFFER,
+    ELEMENT_ARRAY_BUFFER,
+    TRIANGLES,
+    TRIANGLE_STRIP,
+    LINES,
+    DEPTH_ATTACHMENT,
+    COLOR_ATTACHMENT0,
+    COLOR_ATTACHMENT1,
+    DEPTH_TEST,
+    FACE_CULL,
+    STATIC_DRAW,
+    DYNAMIC_DRAW,
+    STREAM_DRAW,
+    STREAM_READ,
+	BLEND,
+    MULTISAMPLE,
+    DEBUG_OUTPUT,
+    DEBUG_OUTPUT_SYNCHRONOUS,
+    TEXTURE_CUBE_MAP_SEAMLESS,
+
+    // texture targets
+    TEXTURE_2D,
+    TEXTURE_CUBE_MAP,
+
+    // texture wrapping
+    REPEAT,
+    CLAMP_TO_EDGE,
+    CLAMP_TO_BORDER,
+
+    // depth functions
+    LESS,
+    LEQUAL,
+    EQUAL,
+
+    // blend factors
+    ZERO,
+    ONE,
+    SRC_ALPHA,
+    ONE_MINUS_SRC_ALPHA,
+
+    // shader-accessible buffers
+    SHADER_STORAGE_BUFFER,
+    UNIFORM_BUFFER,
+    // texture readbacks
+    PIXEL_PACK_BUFFER,
+
+    // image access
+    READ_ONLY,
+    WRITE_ONLY,
+    READ_WRITE,
+};
+
+// Backend interface behind RenderCommand. Every GL object the renderer creates or binds goes through here so
+// the whole scene rendering path can run against a recording backend without a window or context.
+class RendererAPI
+{
+  public:
+    enum class API
+    {
+        Null = 0,
+        OpenGL = 1,
+    };
+
+  public:
+    virtual ~RendererAPI() = default;
+
+    virtual void Init() = 0;
+    // every command of a frame has been issued
+    virtual void EndFrame() {}
+
+    // state
+    virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+    virtual void SetClearColor(const glm::vec4 &color) = 0;
+    virtual void Clear() = 0;
+    virtual void Enable(RendererEnum state) = 0;
+    virtual void Disable(RendererEnum state) = 0;
+    virtual void SetDepthMask(bool write) = 0;
+    virtual void SetColorMask(bool write) = 0;
+    virtual void SetDepthFunc(RendererEnum func) = 0;
+    virtual void SetBlendFunc(RendererEnum src, RendererEnum dst) = 0;
+
+    // draws
+    virtual void DrawElements(RendererEnum mode, int count, RendererEnum type, const void *indices) = 0;
+    virtual void DrawMultiElements(RendererEnum mode, const int *count, RendererEnum type, const void *const *indices,
+                                   unsigned int drawCount) = 0;
+    virtual void DrawArrays(RendererEnum mode, int first, int count) = 0;
+
+    // vertex arrays and buffers
+    virtual uint32_t CreateVertexArray() = 0;
+    virtual void DeleteVertexArray(uint32_t vao) = 0;
+    virtual void BindVertexArray(uint32_t vao) = 0;
+    virtual uint32_t CreateBuffer(RendererEnum target, int size, const void *data, RendererEnum usage) = 0;
+    virtual void SetBufferSubData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size,
+                                  const void *data) = 0;
+    virtual void DeleteBuffer(uint32_t buffer) = 0;
+    virtual void GetBufferData(RendererEnum target, uint32_t buffer, uint32_t offset, uint32_t size, void *data) = 0;
+    virtual void SetVertexAttribute(uint32_t index, int size, uint32_t stride, const void *offset) = 0;
+
+    // textures
+    virtual uint32_t CreateTexture2D(ImageFormat format, uint32_t width, uint32_t height, RendererEnum wrap,
+                                     const void *data = nullptr) = 0;
+    virtual void SetTextureData(uint32_t texture, ImageFormat format, uint32_t width, uint32_t height,
+                                const void *data) = 0;
+    virtual void DeleteTexture(uint32_t texture) = 0;
+    virtual void BindTexture(uint32_t slot, uint32_t texture, RendererEnum target = RendererEnum::TEXTURE_2D) = 0;
+    virtual void ClearTexture(uint32_t texture, int value) = 0;
+    // copies mip 0 back to the CPU, size is the byte size of data; stalls until the GPU is done with the texture
+    virtual void ReadTextureData(uint32_t texture, ImageFormat format, uint32_t size, void *data) = 0;
+    // the same copy into a PIXEL_PACK_BUFFER without waiting, fetch it with GetBufferData once a later fence passed
+    virtual void ReadTextureDataToBuffer(uint32_t texture, ImageFormat format, uint32_t size, uint32_t buffer) = 0;
+
+    // framebuffers
+    virtual uint32_t CreateFramebuffer() = 0;
+    virtual void DeleteFramebuffer(uint32_t framebuffer) = 0;
+    virtual void BindFramebuffer(uint32_t framebuffer) = 0;
+    virtual void AttachTexture(uint32_t attachment, uint32_t texture, int mip = 0) = 0;
+    virtual void SetDrawBuffers(const uint32_t *attachments, int count) = 0;
+    virtual uint32_t CreateDepthRenderbuffer(uint32_t width, uint32_t height) = 0;
+    virtual void DeleteRenderbuffer(uint32_t renderbuffer) = 0;
+    virtual bool IsFramebufferComplete() = 0;
+    virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
+
+    // shaders
+    virtual uint32_t CreateProgram(const std::string &vertexSource, const std::string &fragmentSource) = 0;
+    virtual void DeleteProgram(uint32_t program) = 0;
+    virtual void UseProgram(uint32_t program) = 0;
+    virtual int GetUniformLocation(uint32_t program, const std::string &name) = 0;
+    virtual void SetUniform(int location, int value) = 0;
+    virtual void SetUniform(int location, float value) = 0;
+    virtual void SetUniform(int location, const glm::vec2 &value) = 0;
+    virtual void SetUniform(int location, const glm::vec3 &value) = 0;
+    virtual void SetUniform(int location, const glm::vec4 &value) = 0;
+    virtual void SetUniform(int location, const glm::mat3 &value) = 0;
+    virtual void SetUniform(int location, const glm::mat4 &value) = 0;
+
+    // compute
+    virtual uint32_t CreateComputeProgram(const std::string &computeSource) = 0;
+    virtual void DispatchCompute(uint32_t groupsX, uint32_t groupsY, uint32_t groupsZ) = 0;
+    virtual void BindImageTexture(uint32_t unit, uint32_t texture, ImageFormat format, RendererEnum access) = 0;
+    virtual void BindBufferBase(RendererEnum target, uint32_t index, uint32_t buffer) = 0;
+    // makes image/buffer writes of earlier dispatches visible to later image loads and texture fetches
+    virtual void InsertMemoryBarrier() = 0;
+
+    // timer queries, results in nanoseconds
+    virtual uint32_t CreateQuery() = 0;
+    virtual void DeleteQuery(uint32_t query) = 0;
+    virtual void BeginTimerQuery(uint32_t query) = 0;
+    virtual void EndTimerQuery() = 0;
+    virtual bool IsQueryResultAvailable(uint32_t query) = 0;
+    virtual uint64_t GetQueryResult(uint32_t query) = 0;
+
+    // fences, signaled once the GPU has finished every command issued before them
+    virtual uint32_t CreateFence() = 0;
+    virtual void DeleteFence(uint32_t fence) = 0;
+    virtual bool IsFenceSignaled(uint32_t fence) = 0;
+
+  public:
+    // Must be called before RenderCommand::Init, i.e. before the first renderer object is created.
+    static void SetAPI(API api) { s_API = api; }
+    static API GetAPI() { return s_API; }
+
+    static std::unique_ptr<RendererAPI> Create();
+
+  private:
+    static API s_API;
+};
+
+inline std::string RendererAPIToString(RendererAPI::API api)
+{
+    switch (api)
+    {
+        case RendererAPI::API::Null: return "Null";
+        case RendererAPI::API::OpenGL: return "OpenGL";
+        default: return "Unknown";
+    }
+}
+} // namespace Engine
@@ -1,48 +1,34 @@
 #include "SceneRenderer.h"
 
-#include <glad/glad.h>
-
 #include "RenderCommand.h"
 #include "Components.h"
 #include "InfiniteGrid.h"
 #include "Renderer.h"
 #include "PostFX/Bloom.h"
-#include "PostFX/Bloom2.h"
+#include "Profiler.h"
+#include "MemoryTracker.h"
 
 namespace Engine
 {
-std::unique_ptr<Bloom> bloom = std::make_unique<Bloom>(5);
-
 void SceneRenderer::Init()
 {
-    glEnable(GL_DEBUG_OUTPUT);
-    glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
-    glEnable(GL_MULTISAMPLE);
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LEQUAL);
-    //glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    MEMORY_TAG(Renderer);
+    RenderCommand::Enable(RendererEnum::DEBUG_OUTPUT);
+    RenderCommand::Enable(RendererEnum::DEBUG_OUTPUT_SYNCHRONOUS);
+    RenderCommand::Enable(RendererEnum::MULTISAMPLE);
+    RenderCommand::Enable(RendererEnum::DEPTH_TEST);
+    RenderCommand::SetDepthMask(true);
+    RenderCommand::SetDepthFunc(RendererEnum::LEQUAL);
+    RenderCommand::SetBlendFunc(RendererEnum::SRC_ALPHA, RendererEnum::ONE_MINUS_SRC_ALPHA);
 
     auto pbrShader = ShaderManager::GetShader("Resources/shaders/PBR");
     pbrShader->SetUniform1i("irradianceMap", 0);
     pbrShader->SetUniform1i("prefilterMap", 1); 
     pbrShader->SetUniform1i("brdfLUT", 2);
 
-	// hdr buffer
-	m_ShadingBuffer = std::make_shared<Framebuffer>(false, glm::vec2(1280, 720));
-    m_ShadingBuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::Depth), GL_DEPTH_ATTACHMENT);
-	m_ShadingBuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::RGB16), GL_COLOR_ATTACHMENT0);
-	m_ShadingBuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::RED_INTEGER), GL_COLOR_ATTACHMENT1);
-
-	// outline
-    m_OutlineBuffer = std::make_shared<Framebuffer>(false, glm::vec2(1280, 720));
-	m_OutlineBuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::Depth), GL_DEPTH_ATTACHMENT);
-    m_OutlineBuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::RGBA8), GL_COLOR_ATTACHMENT0);
-	
-	m_Edge = std::make_shared<Framebuffer>(false, glm::vec2(1280, 720));
-    m_Edge->SetTexture(std::make_shared<Texture2D>(ImageFormat::Depth), GL_DEPTH_ATTACHMENT);
-    m_Edge->SetTexture(std::make_shared<Texture2D>(ImageFormat::RGBA8), GL_COLOR_ATTACHMENT0);
+    // bound in place of passes that were culled this frame
+    uint32_t black = 0;
+    m_BlackTexture = std::make_shared<Texture2D>(TextureSpecification{.Format = ImageFormat::RGBA8}, Buffer(&black, 4));
 
 	InfiniteGrid::Init();
     Renderer::Init();
@@ -50,132 +36,462 @@ void SceneRenderer::Init()
 
 void SceneRenderer::Cleanup() {}
 
-void SceneRenderer::BeginRenderScene(const glm::mat4 &projection, const glm::mat4 &view,
-                                     const glm::vec3 &cameraPosition)
+void SceneRenderer::RenderScene(const RenderSnapshot &snapshot)
 {
-    m_Projection = projection;
-    m_View = view;
-    m_CameraPosition = cameraPosition;
-
+    PROFILE_FUNCTION();
+    MEMORY_TAG(Renderer);
+    m_Projection = snapshot.Projection;
+    m_View = snapshot.View;
+    m_CameraPosition = snapshot.CameraPosition;
+    m_LightValues = snapshot.Lights;
+    m_Lights.SetValues(m_LightValues);
+
+    RenderCommand::ResetStats();
     RenderCommand::SetClearColor({0.0f, 0.0f, 0.0f});
     RenderCommand::Clear();
+
+    const Environment *environment = &snapshot.Environment;
+    Framebuffer &framebuffer = *snapshot.Target;
+
+    // the scene renders at a scaled internal resolution picked from the GPU time of previous frames, the
+    // selection outline and the composite into the viewport stay at native resolution
+    const glm::vec2 outputSize = framebuffer.GetSize();
+    m_DynamicResolution.Update(m_RenderGraph.GetGPUTime());
+    m_RenderGraph.SetSize(m_DynamicResolution.GetRenderSize(outputSize));
+    const float sharpness = m_DynamicResolution.GetScale() < 1.0f ? m_DynamicResolution.GetSettings().Sharpness : 0.0f;
+
+    UpdateSkyLighting(snapshot);
+
+    struct
+    {
+        RenderGraphResource Color, EntityId, Depth;
+        RenderGraphResource Albedo, Normal, Material;
+    } shading;
+    const bool deferred = environment->DeferredShading;
+    // named per mode so the GPU timings of each stay side by side in the stats
+    m_RenderGraph.AddPass(
+        deferred ? "Shading (Deferred)" : environment->DepthPrepass ? "Shading (Depth Prepass)" : "Shading",
+        [&](RenderGraphBuilder &builder)
+        {
+            shading.Depth = builder.Write(builder.CreateTexture("SceneDepth", {ImageFormat::Depth}), GL_DEPTH_ATTACHMENT);
+            shading.Color = builder.Write(builder.CreateTexture("SceneColor", {ImageFormat::RGB16}), GL_COLOR_ATTACHMENT0);
+            shading.EntityId =
+                builder.Write(builder.CreateTexture("EntityId", {ImageFormat::RED_INTEGER}), GL_COLOR_ATTACHMENT1);
+            if (deferred)
+            {
+                // only live inside the pass, attached by DeferredShadingPass itself
+                shading.Albedo = builder.CreateTexture("GBufferAlbedo", {ImageFormat::RGBA8});
+                shading.Normal = builder.CreateTexture("GBufferNormal", {ImageFormat::RG16F});
+                shading.Material = builder.CreateTexture("GBufferMaterial", {ImageFormat::RGBA8});
+            }
+            // hovered entity is read back from the id buffer
+            builder.SetSideEffects();
+        },
+        [&](const RenderGraphResources &resources)
+        {
+            if (!deferred)
+            {
+                ShadingPass(snapshot);
+                return;
+            }
+
+            DeferredShadingPass(snapshot, {resources.GetTexture(shading.Depth), resources.GetTexture(shading.Albedo),
+                                        resources.GetTexture(shading.Normal), resources.GetTexture(shading.Material)});
+        });
+
+    // outline of the selected entity, culled by the graph when nothing is selected
+    RenderGraphResource outlineMask = InvalidRenderGraphResource;
+    m_RenderGraph.AddPass(
+        "OutlineMask",
+        [&](RenderGraphBuilder &builder)
+        {
+            builder.Write(builder.CreateTexture("OutlineDepth", {ImageFormat::Depth, outputSize}), GL_DEPTH_ATTACHMENT);
+            outlineMask = builder.Write(builder.CreateTexture("OutlineMask", {ImageFormat::RGBA8, outputSize}));
+        },
+        [&](const RenderGraphResources &) { OutlinePass(snapshot); });
+
+    // declared out here, the execute callbacks only run in Execute() below
+    RenderGraphResource bloom = InvalidRenderGraphResource, edge = InvalidRenderGraphResource;
+    const bool hasSelection = snapshot.HasSelection;
+    if (environment->ComputePostFX)
+    {
+        bloom = environment->Bloom->AddComputePass(m_RenderGraph, shading.Color, 0.005);
+
+        // outline edges, bloom, exposure and tonemap in a single full screen pass
+        m_RenderGraph.AddPass(
+            "FusedComposite",
+            [&](RenderGraphBuilder &builder)
+            {
+                builder.Read(shading.Color);
+                if (environment->BloomEnabled) builder.Read(bloom);
+                if (hasSelection) builder.Read(outlineMask);
+                builder.SetSideEffects();
+            },
+            [&](const RenderGraphResources &resources)
+            {
+                framebuffer.Bind();
+
+                auto compositeShader = ShaderManager::GetShader("Resources/shaders/composite");
+                compositeShader->Bind();
+                compositeShader->SetUniform1i("scene", 0);
+                compositeShader->SetUniform1i("bloomBlur", 1);
+                compositeShader->SetUniform1i("outlineMask", 2);
+
+                compositeShader->SetUniform1f("bloomStrength", environment->BloomIntensity);
+                compositeShader->SetUniform1f("exposure", environment->Exposure);
+                compositeShader->SetUniform1i("bloomEnabled", environment->BloomEnabled);
+                compositeShader->SetUniform1i("outlineEnabled", hasSelection);
+                compositeShader->SetUniform1f("sharpness", sharpness);
+
+                resources.GetTexture(shading.Color)->Bind(0);
+                (environment->BloomEnabled ? resources.GetTexture(bloom) : m_BlackTexture)->Bind(1);
+                (hasSelection ? resources.GetTexture(outlineMask) : m_BlackTexture)->Bind(2);
+
+                Renderer::DrawQuad();
+
+                framebuffer.Unbind();
+            });
+    }
+    else
+    {
+        m_RenderGraph.AddPass(
+            "EdgeDetection",
+            [&](RenderGraphBuilder &builder)
+            {
+                builder.Read(outlineMask);
+                edge = builder.Write(builder.CreateTexture("Edge", {ImageFormat::RGBA8, outputSize}));
+            },
+            [&](const RenderGraphResources &resources)
+            {
+                auto edgeShader = ShaderManager::GetShader("Resources/shaders/edgeDetection");
+                edgeShader->Bind();
+                edgeShader->SetUniform1i("mask", 0);
+                // dimensions
+                edgeShader->SetUniform1f("width", outputSize.x);
+                edgeShader->SetUniform1f("height", outputSize.y);
+
+                resources.GetTexture(outlineMask)->Bind(0);
+
+                Renderer::DrawQuad();
+            });
+
+        bloom = environment->Bloom->AddPass(m_RenderGraph, shading.Color, 0.005);
+
+        m_RenderGraph.AddPass(
+            "Composite",
+            [&](RenderGraphBuilder &builder)
+            {
+                builder.Read(shading.Color);
+                if (environment->BloomEnabled) builder.Read(bloom);
+                if (hasSelection) builder.Read(edge);
+                builder.SetSideEffects();
+            },
+            [&](const RenderGraphResources &resources)
+            {
+                framebuffer.Bind();
+
+                auto quadShader = ShaderManager::GetShader("Resources/shaders/quad");
+                quadShader->Bind();
+                quadShader->SetUniform1i("scene", 0);
+                quadShader->SetUniform1i("bloomBlur", 1);
+                quadShader->SetUniform1i("outlineTexture", 2);
+
+                quadShader->SetUniform1f("bloomStrength", environment->BloomIntensity);
+                quadShader->SetUniform1f("exposure", environment->Exposure);
+                quadShader->SetUniform1i("bloomEnabled", environment->BloomEnabled);
+                quadShader->SetUniform1f("sharpness", sharpness);
+
+                resources.GetTexture(shading.Color)->Bind(0);
+                (environment->BloomEnabled ? resources.GetTexture(bloom) : m_BlackTexture)->Bind(1);
+                (hasSelection ? resources.GetTexture(edge) : m_BlackTexture)->Bind(2);
+
+                Renderer::DrawQuad();
+
+                framebuffer.Unbind();
+            });
+    }
+
+    m_RenderGraph.Compile();
+    m_RenderGraph.Execute();
+    RenderCommand::PublishStats();
 }
 
-void SceneRenderer::RenderScene(Scene &scene, Framebuffer &framebuffer)
+void SceneRenderer::ShadingPass(const RenderSnapshot &snapshot)
 {
-    auto environment = scene.GetEnvironment();
+    const Environment *environment = &snapshot.Environment;
 
-	m_ShadingBuffer->Bind();
-	
-	EnvironmentPass(scene);
+    EnvironmentPass(snapshot);
 
     auto pbrShader = ShaderManager::GetShader("Resources/shaders/PBR");
     pbrShader->Bind();
     pbrShader->SetUniformMatrix4fv("projectionViewMatrix", m_Projection * m_View);
     pbrShader->SetUniform3f("cameraPosition", m_CameraPosition);
-    scene.GetLights()->SetLightUniforms(*pbrShader);
+    m_Lights.SetLightUniforms(*pbrShader);
+
+    SubmitMeshes(snapshot);
 
-	auto view = scene.GetRegistry().view<MeshComponent, TransformComponent, VisibilityComponent>();
-    for (auto &e : view)
+    if (environment->DepthPrepass)
     {
-        auto [model, transform, visibility] = view.get<MeshComponent, TransformComponent, VisibilityComponent>(e);
+        auto depthShader = ShaderManager::GetShader("Resources/shaders/depth");
+        depthShader->Bind();
+        depthShader->SetUniformMatrix4fv("projectionViewMatrix", m_Projection * m_View);
 
-        if (!visibility.IsVisible) continue;
-        if (model.Handle == 0 && model.ModelResource == nullptr) continue;
+        RenderCommand::SetColorMask(false);
+        Renderer::FlushDepth(depthShader, m_CameraPosition);
+        RenderCommand::SetColorMask(true);
 
-        const auto &entityModel =
-            model.ModelResource ? model.ModelResource : AssetManager::GetAsset<Model>(model.Handle);
+        // the depth buffer now holds the nearest surface everywhere, so each pixel is shaded exactly once
+        RenderCommand::SetDepthFunc(RendererEnum::EQUAL);
+        RenderCommand::SetDepthMask(false);
+    }
 
-        for (auto &mesh : entityModel->GetMeshes())
-        {
-            if (environment->SkyboxHDR) environment->SkyboxHDR->BindMaps();
+    Renderer::Flush(pbrShader, false);
+
+    if (environment->DepthPrepass)
+    {
+        RenderCommand::SetDepthFunc(RendererEnum::LEQUAL);
+        RenderCommand::SetDepthMask(true);
+    }
+
+    if (!snapshot.IsPlaying) InfiniteGrid::Draw(m_Projection, m_View, m_CameraPosition);
+
+    ReadHoveredEntity(snapshot);
+}
+
+void SceneRenderer::DeferredShadingPass(const RenderSnapshot &snapshot, const GBuffer &gbuffer)
+{
+    const Environment *environment = &snapshot.Environment;
+
+    EnvironmentPass(snapshot);
+
+    // geometry: entity ids and the G-buffer, scene color keeps the sky
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT2, gbuffer.Albedo->GetRendererID());
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT3, gbuffer.Normal->GetRendererID());
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT4, gbuffer.Material->GetRendererID());
+    const uint32_t geometryBuffers[] = {0 /* GL_NONE */, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2,
+                                        GL_COLOR_ATTACHMENT3, GL_COLOR_ATTACHMENT4};
+    RenderCommand::SetDrawBuffers(geometryBuffers, 5);
+
+    auto gbufferShader = ShaderManager::GetShader("Resources/shaders/gbuffer");
+    gbufferShader->Bind();
+    gbufferShader->SetUniformMatrix4fv("projectionViewMatrix", m_Projection * m_View);
+
+    SubmitMeshes(snapshot);
+    Renderer::Flush(gbufferShader, false);
+
+    // light lists per screen tile
+    const glm::vec2 size = m_RenderGraph.GetSize();
+    const uint32_t tilesX = ((uint32_t)size.x + DeferredTileSize - 1) / DeferredTileSize;
+    const uint32_t tilesY = ((uint32_t)size.y + DeferredTileSize - 1) / DeferredTileSize;
+    const uint32_t lightCount = UploadLights(tilesX * tilesY);
+
+    auto cullingShader = ShaderManager::GetComputeShader("Resources/shaders/lightCulling");
+    cullingShader->Bind();
+    cullingShader->SetUniformMatrix4fv("view", m_View);
+    cullingShader->SetUniformMatrix4fv("inverseProjection", glm::inverse(m_Projection));
+    cullingShader->SetUniform1i("lightCount", lightCount);
+    cullingShader->SetUniform2f("screenSize", size);
+
+    RenderCommand::BindTexture(0, gbuffer.Depth->GetRendererID());
+    RenderCommand::BindBufferBase(RendererEnum::SHADER_STORAGE_BUFFER, 1, m_LightBuffer);
+    RenderCommand::BindBufferBase(RendererEnum::SHADER_STORAGE_BUFFER, 2, m_TileLightBuffer);
+    RenderCommand::DispatchCompute(tilesX, tilesY);
+    RenderCommand::InsertMemoryBarrier();
+
+    // lighting, once per covered pixel; depth is sampled here so it comes off the framebuffer meanwhile
+    const uint32_t colorBuffer[] = {GL_COLOR_ATTACHMENT0};
+    RenderCommand::SetDrawBuffers(colorBuffer, 1);
+    RenderCommand::AttachTexture(GL_DEPTH_ATTACHMENT, 0);
+    RenderCommand::Disable(RendererEnum::DEPTH_TEST);
+
+    auto lightingShader = ShaderManager::GetShader("Resources/shaders/lighting");
+    lightingShader->Bind();
+    lightingShader->SetUniform1i("irradianceMap", 0);
+    lightingShader->SetUniform1i("prefilterMap", 1);
+    lightingShader->SetUniform1i("brdfLUT", 2);
+    lightingShader->SetUniform1i("gDepth", 3);
+    lightingShader->SetUniform1i("gAlbedo", 4);
+    lightingShader->SetUniform1i("gNormal", 5);
+    lightingShader->SetUniform1i("gMaterial", 6);
+    lightingShader->SetUniform3f("cameraPosition", m_CameraPosition);
+    lightingShader->SetUniformMatrix4fv("inverseProjectionView", glm::inverse(m_Projection * m_View));
+    lightingShader->SetUniform1i("tileCountX", tilesX);
+    m_Lights.SetLightUniforms(*lightingShader);
+
+    if (environment->SkyboxHDR) environment->SkyboxHDR->BindMaps();
+    gbuffer.Depth->Bind(3);
+    gbuffer.Albedo->Bind(4);
+    gbuffer.Normal->Bind(5);
+    gbuffer.Material->Bind(6);
+
+    Renderer::DrawQuad();
+
+    RenderCommand::Enable(RendererEnum::DEPTH_TEST);
+    RenderCommand::AttachTexture(GL_DEPTH_ATTACHMENT, gbuffer.Depth->GetRendererID());
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT2, 0);
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT3, 0);
+    RenderCommand::AttachTexture(GL_COLOR_ATTACHMENT4, 0);
+    const uint32_t sceneBuffers[] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    RenderCommand::SetDrawBuffers(sceneBuffers, 2);
+
+    if (!snapshot.IsPlaying) InfiniteGrid::Draw(m_Projection, m_View, m_CameraPosition);
+
+    ReadHoveredEntity(snapshot);
+}
+
+uint32_t SceneRenderer::UploadLights(uint32_t tileCount)
+{
+    // matches GPULight in lightCulling.comp and lighting.frag
+    struct GPULight
+    {
+        glm::vec4 PositionRadius = glm::vec4(0.0f);
+        glm::vec4 Color = glm::vec4(0.0f);
+        glm::vec4 Direction = glm::vec4(0.0f);
+        glm::vec4 Params = glm::vec4(0.0f); // Direction and Params stay zero for point lights
+    };
+
+    // 1/d^2 falloff never reaches zero, lights are cut off where they drop below this radiance
+    constexpr float LightCutoff = 0.01f;
+    auto radius = [](const glm::vec3 &radiance)
+    { return glm::sqrt(glm::max(radiance.r, glm::max(radiance.g, radiance.b)) / LightCutoff); };
+
+    if (m_LightBuffer == 0)
+        m_LightBuffer = RenderCommand::CreateBuffer(RendererEnum::SHADER_STORAGE_BUFFER,
+                                                    MaxDeferredLights * sizeof(GPULight), nullptr,
+                                                    RendererEnum::DYNAMIC_DRAW);
+
+    const uint32_t tileBufferSize = tileCount * (MaxLightsPerTile + 1) * sizeof(uint32_t);
+    if (tileBufferSize > m_TileLightBufferSize)
+    {
+        if (m_TileLightBuffer != 0) RenderCommand::DeleteBuffer(m_TileLightBuffer);
+        m_TileLightBuffer = RenderCommand::CreateBuffer(RendererEnum::SHADER_STORAGE_BUFFER, tileBufferSize, nullptr,
+                                                        RendererEnum::DYNAMIC_DRAW);
+        m_TileLightBufferSize = tileBufferSize;
+    }
+
+    std::vector<GPULight> lights;
+    for (auto &[index, light] : m_Lights.m_PointLightPropsMap)
+    {
+        if (light == nullptr || lights.size() == MaxDeferredLights) continue;
+
+        glm::vec3 radiance = light->Color * light->Intensity;
+        lights.push_back({glm::vec4(light->Position, radius(radiance)), glm::vec4(radiance, 0.0f)});
+    }
+    for (auto &[index, light] : m_Lights.m_SpotLightPropsMap)
+    {
+        if (light == nullptr || lights.size() == MaxDeferredLights) continue;
+
+        // same cutoff and falloff terms PBR.frag gets from Light::SetLightUniforms
+        glm::vec3 radiance = light->Color * light->Intensity;
+        lights.push_back({glm::vec4(light->Position, radius(radiance)), glm::vec4(radiance, 1.0f),
+                          glm::vec4(light->Direction, glm::cos(glm::radians(light->Cutoff))),
+                          glm::vec4(glm::cos(glm::radians(light->OuterCutoff)), 0.0f, 0.0f, 0.0f)});
+    }
+
+    if (!lights.empty())
+        RenderCommand::SetBufferSubData(RendererEnum::SHADER_STORAGE_BUFFER, m_LightBuffer, 0,
+                                        lights.size() * sizeof(GPULight), lights.data());
 
-			auto trnsfrm = transform.GetTransform();
-            Renderer::SubmitMesh(std::make_shared<Mesh>(mesh), trnsfrm, (int)e);
+    return lights.size();
+}
+
+void SceneRenderer::UpdateSkyLighting(const RenderSnapshot &snapshot)
+{
+    PROFILE_FUNCTION();
+    // LUT and cubemap updates of the sky run here, outside any render graph pass
+    PROFILE_GPU_SCOPE("Sky Lighting");
+
+    // std140 layout of the SkyIrradiance block
+    struct GPUSkyIrradiance
+    {
+        glm::vec4 Coefficients[9];
+        int Enabled;
+    };
+
+    const Environment *environment = &snapshot.Environment;
+    m_Lights.ClearSkySun();
+
+    SH9 sh;
+    bool enabled = environment->SHIrradiance;
+    switch (environment->CurrentSkyType)
+    {
+        case SkyType::ClearColor: sh = SphericalHarmonics::Constant(glm::vec3(environment->AmbientColor)); break;
+        case SkyType::ProceduralSky:
+        {
+            // both come from the sky's LUTs, which only change with its parameters (e.g. the sun)
+            auto &sky = environment->ProceduralSkybox;
+            sh = sky->GetIrradianceSH();
+            m_Lights.SetSkySun(-glm::normalize(sky->SunDirection), sky->GetSunColor());
+            break;
         }
+        case SkyType::SkyboxHDR:
+            if (environment->SkyboxHDR)
+                sh = environment->SkyboxHDR->GetIrradianceSH();
+            else
+                enabled = false;
+            break;
     }
 
-    Renderer::Flush(pbrShader, false);
-	if (!scene.IsPlaying()) InfiniteGrid::Draw(m_Projection, m_View, m_CameraPosition);
+    GPUSkyIrradiance data{};
+    for (int k = 0; k < 9; k++)
+        data.Coefficients[k] = glm::vec4(sh.Coefficients[k], 0.0f);
+    data.Enabled = enabled;
 
-	// weird?
-	auto mouse = scene.GetViewportMousePos();
-    int pixel = m_ShadingBuffer->ReadPixel(1, mouse);
-    scene.SetHoveredEntity((entt::entity)(pixel - 1));
+    if (m_SkyIrradianceBuffer == 0)
+        m_SkyIrradianceBuffer = RenderCommand::CreateBuffer(RendererEnum::UNIFORM_BUFFER, sizeof(GPUSkyIrradiance),
+                                                            nullptr, RendererEnum::DYNAMIC_DRAW);
 
-	m_ShadingBuffer->Unbind();
+    RenderCommand::SetBufferSubData(RendererEnum::UNIFORM_BUFFER, m_SkyIrradianceBuffer, 0, sizeof(data), &data);
+    RenderCommand::BindBufferBase(RendererEnum::UNIFORM_BUFFER, SkyIrradianceBinding, m_SkyIrradianceBuffer);
+}
 
-	// outline
-	auto outlineShader = ShaderManager::GetShader("Resources/shaders/outline");
-    outlineShader->Bind();
-    outlineShader->SetUniformMatrix4fv("projectionViewMatrix", m_Projection * m_View);
+void SceneRenderer::SubmitMeshes(const RenderSnapshot &snapshot)
+{
+    PROFILE_FUNCTION();
+    const Environment *environment = &snapshot.Environment;
+    RenderCommand::GetStats().Culled += snapshot.CulledMeshes;
 
-	m_OutlineBuffer->Bind();
-    for (auto &e : view)
+    for (const auto &proxy : snapshot.Meshes)
     {
-        if (e != scene.GetSelectedEntity()) continue;
-		auto [model, transform] = view.get<MeshComponent, TransformComponent>(e);
+        auto &meshes = proxy.Model->GetMeshes();
+        for (size_t i = 0; i < meshes.size(); i++)
+        {
+            if (environment->SkyboxHDR) environment->SkyboxHDR->BindMaps();
+            Renderer::SubmitMesh(&meshes[i], snapshot.Materials[proxy.FirstMaterial + i], proxy.Transform,
+                                 proxy.EntityId);
+        }
+    }
+}
 
-		if (model.Handle == 0 && model.ModelResource == nullptr) continue;
+void SceneRenderer::ReadHoveredEntity(const RenderSnapshot &snapshot)
+{
+    // weird?
+    auto mouse = snapshot.ViewportMousePos * m_DynamicResolution.GetScale();
+    int pixel = RenderCommand::ReadPixel(1, mouse.x, mouse.y);
+    m_HoveredEntity.store((uint32_t)(pixel - 1), std::memory_order_relaxed);
+}
 
-		const auto &entityModel =
-			model.ModelResource ? model.ModelResource : AssetManager::GetAsset<Model>(model.Handle);
+void SceneRenderer::OutlinePass(const RenderSnapshot &snapshot)
+{
+    auto outlineShader = ShaderManager::GetShader("Resources/shaders/outline");
+    outlineShader->Bind();
+    outlineShader->SetUniformMatrix4fv("projectionViewMatrix", m_Projection * m_View);
 
-		for (auto &mesh : entityModel->GetMeshes())
-		{
-			auto trnsfrm = transform.GetTransform();
-			Renderer::SubmitMesh(std::make_shared<Mesh>(mesh), trnsfrm, (int)e);
-		}
+    for (const auto &proxy : snapshot.Selected)
+    {
+        auto &meshes = proxy.Model->GetMeshes();
+        for (size_t i = 0; i < meshes.size(); i++)
+            Renderer::SubmitMesh(&meshes[i], snapshot.Materials[proxy.FirstMaterial + i], proxy.Transform,
+                                 proxy.EntityId);
     }
-	Renderer::Flush(outlineShader, false);
-    m_OutlineBuffer->Unbind();
-
-	m_Edge->Bind();
-	auto edgeShader = ShaderManager::GetShader("Resources/shaders/edgeDetection");
-	edgeShader->Bind();
-	edgeShader->SetUniform1i("mask", 0);
-	// dimensions
-    edgeShader->SetUniform1f("width", m_Edge->GetSize().x);
-	edgeShader->SetUniform1f("height", m_Edge->GetSize().y);
-	
-	m_OutlineBuffer->GetTexture()->Bind(0);
-
-	Renderer::DrawQuad();
-	m_Edge->Unbind();
-
-	m_ShadingBuffer->QueueResize(framebuffer.GetSize());
-	m_OutlineBuffer->QueueResize(framebuffer.GetSize());
-	m_Edge->QueueResize(framebuffer.GetSize());
-
-	Texture2DRef finalOutput = m_ShadingBuffer->GetTexture();
-	environment->Bloom->RenderBloomTexture(finalOutput->GetRendererID(), 0.005);
-
-	framebuffer.Bind();
-	
-	auto quadShader = ShaderManager::GetShader("Resources/shaders/quad");
-    quadShader->Bind();
-    quadShader->SetUniform1i("scene", 0);
-    quadShader->SetUniform1i("bloomBlur", 1);
-    quadShader->SetUniform1i("outlineTexture", 2);
-
-    quadShader->SetUniform1f("bloomStrength", environment->BloomIntensity);
-    quadShader->SetUniform1f("exposure", environment->Exposure);
-	quadShader->SetUniform1i("bloomEnabled", environment->BloomEnabled);
-
-	finalOutput->Bind(0);
-	glBindTextureUnit(1, environment->Bloom->BloomTexture());
-	m_Edge->GetTexture()->Bind(2);
-
-    Renderer::DrawQuad(); 
-	 
-	framebuffer.Unbind();
+    Renderer::Flush(outlineShader, false);
 }
 
-void SceneRenderer::ShadowPass(Scene &scene) {}
+void SceneRenderer::ShadowPass(const RenderSnapshot &) {}
 
-void SceneRenderer::EnvironmentPass(Scene &scene) 
+void SceneRenderer::EnvironmentPass(const RenderSnapshot &snapshot) 
 { 
-    auto environment = scene.GetEnvironment();
+    const Environment *environment = &snapshot.Environment;
 
     if (environment->CurrentSkyType == SkyType::ClearColor)
     {
@@ -190,11 +506,11 @@ void SceneRenderer::EnvironmentPass(Scene &scene)
 	{
 	if (environment->CurrentSkyType == SkyType::SkyboxHDR)
 	{
-		scene.GetEnvironment()->SkyboxHDR->BindMaps();
+		environment->SkyboxHDR->BindMaps();
 		environment->SkyboxHDR->Render(m_Projection, m_View);
 	}
 	else
-		scene.GetEnvironment()->SkyboxHDR->Destroy();
+		environment->SkyboxHDR->Destroy();
     }
 }
 } // namespace Engine
@@ -2,10 +2,16 @@
 
 #include <glm/glm.hpp>
 
+#include <entt.hpp>
+
 #include "Renderer.h"
-#include "Scene.h"
 #include "Framebuffer.h"
+#include "Light.h"
+#include "RenderGraph.h"
+#include "RenderSnapshot.h"
+#include "DynamicResolution.h"
 
+#include <atomic>
 #include <memory>
 
 namespace Engine
@@ -16,21 +22,57 @@ class SceneRenderer
     void Init();
     void Cleanup();
 
-    void BeginRenderScene(const glm::mat4 &projection, const glm::mat4 &view, const glm::vec3 &cameraPosition);
-    void RenderScene(Scene &scene, Framebuffer &framebuffer);
+    // reads nothing but the snapshot, so it may run on the render thread while the scene updates
+    void RenderScene(const RenderSnapshot &snapshot);
+
+    const RenderGraph &GetRenderGraph() const { return m_RenderGraph; }
+    DynamicResolution &GetDynamicResolution() { return m_DynamicResolution; }
+    // under the mouse as of the last rendered frame
+    entt::entity GetHoveredEntity() const { return (entt::entity)m_HoveredEntity.load(std::memory_order_relaxed); }
 
   private:
-    void ShadowPass(Scene &scene);
+    struct GBuffer
+    {
+        Texture2DRef Depth, Albedo, Normal, Material;
+    };
+
+    void ShadowPass(const RenderSnapshot &snapshot);
+    void ShadingPass(const RenderSnapshot &snapshot);
+    void DeferredShadingPass(const RenderSnapshot &snapshot, const GBuffer &gbuffer);
+    void OutlinePass(const RenderSnapshot &snapshot);
+
+    void SubmitMeshes(const RenderSnapshot &snapshot);
+    void ReadHoveredEntity(const RenderSnapshot &snapshot);
+    // fills the light buffer for tiled culling and makes room for tileCount light lists, returns the light count
+    uint32_t UploadLights(uint32_t tileCount);
+    // SH9 irradiance of the current sky into the uniform buffer PBR.frag and lighting.frag read, and the sky's sun
+    // for a directional light following it
+    void UpdateSkyLighting(const RenderSnapshot &snapshot);
 
-	void EnvironmentPass(Scene &scene);
+	void EnvironmentPass(const RenderSnapshot &snapshot);
 
   private:
     glm::mat4 m_Projection, m_View;
     glm::vec3 m_CameraPosition;
 
-	FramebufferRef m_HDRBuffer;
-    FramebufferRef m_ShadingBuffer;
-	FramebufferRef m_OutlineBuffer;
-    FramebufferRef m_Edge;
+    // the snapshot's lights plus the sky's sun, m_Lights points into m_LightValues
+    LightValues m_LightValues;
+    Light m_Lights;
+    std::atomic<uint32_t> m_HoveredEntity = (uint32_t)entt::entity(entt::null);
+
+    RenderGraph m_RenderGraph;
+    DynamicResolution m_DynamicResolution;
+
+    // deferred path, sizes shared with lightCulling.comp and lighting.frag
+    static constexpr uint32_t DeferredTileSize = 16;
+    static constexpr uint32_t MaxLightsPerTile = 63;
+    static constexpr uint32_t MaxDeferredLights = 1024;
+    uint32_t m_LightBuffer = 0;
+    uint32_t m_TileLightBuffer = 0;
+    uint32_t m_TileLightBufferSize = 0;
+    Texture2DRef m_BlackTexture;
+
+    static constexpr uint32_t SkyIrradianceBinding = 0;
+    uint32_t m_SkyIrradianceBuffer = 0;
 };
 } // namespace Engine
@@ -17,6 +17,7 @@ class Shader
   public:
     Shader() = default;
     Shader(const std::string &vertexSourcePath, const std::string &fragmentSourcePath);
+    explicit Shader(const std::string &computeSourcePath);
 
     void Bind() const;
     void Unbind() const;
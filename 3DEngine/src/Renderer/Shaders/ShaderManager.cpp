@@ -14,4 +14,15 @@ Shader *ShaderManager::GetShader(const std::string &path)
 
     return m_Shaders[path].get();
 }
+
+Shader *ShaderManager::GetComputeShader(const std::string &path)
+{
+    std::string key = path + ".comp";
+    if (m_Shaders.find(key) == m_Shaders.end())
+    {
+        m_Shaders[key] = std::make_unique<Shader>(key);
+    }
+
+    return m_Shaders[key].get();
+}
 } // namespace Engine
\ No newline at end of file
@@ -12,6 +12,7 @@ class ShaderManager
 {
   public:
     static Shader *GetShader(const std::string &path);
+    static Shader *GetComputeShader(const std::string &path);
 
   private:
     static std::map<std::string, std::unique_ptr<Shader>> m_Shaders;
@@ -0,0 +1,52 @@
+#include "TextureReadback.h"
+
+#include "RenderCommand.h"
+
+namespace Engine
+{
+TextureReadback::~TextureReadback()
+{
+    if (RenderCommand::GetRendererAPI() == nullptr) return;
+
+    if (m_Fence != 0) RenderCommand::DeleteFence(m_Fence);
+    if (m_Buffer != 0) RenderCommand::DeleteBuffer(m_Buffer);
+}
+
+void TextureReadback::Start(uint32_t texture, ImageFormat format, uint32_t size)
+{
+    m_Texture = texture;
+    m_Format = format;
+    m_Size = size;
+    m_Queued = true;
+
+    // otherwise it goes out when the one in flight has been fetched
+    if (m_Fence == 0) Issue();
+}
+
+bool TextureReadback::Fetch(void *data)
+{
+    if (m_Fence == 0 || !RenderCommand::IsFenceSignaled(m_Fence)) return false;
+
+    RenderCommand::GetBufferData(RendererEnum::PIXEL_PACK_BUFFER, m_Buffer, 0, m_Size, data);
+    RenderCommand::DeleteFence(m_Fence);
+    m_Fence = 0;
+
+    if (m_Queued) Issue();
+    return true;
+}
+
+void TextureReadback::Issue()
+{
+    if (m_BufferSize < m_Size)
+    {
+        if (m_Buffer != 0) RenderCommand::DeleteBuffer(m_Buffer);
+        m_Buffer = RenderCommand::CreateBuffer(RendererEnum::PIXEL_PACK_BUFFER, m_Size, nullptr,
+                                               RendererEnum::STREAM_READ);
+        m_BufferSize = m_Size;
+    }
+
+    RenderCommand::ReadTextureDataToBuffer(m_Texture, m_Format, m_Size, m_Buffer);
+    m_Fence = RenderCommand::CreateFence();
+    m_Queued = false;
+}
+} // namespace Engine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "Texture.h"
+
+namespace Engine
+{
+// Copies a texture back to the CPU without stalling. Start() queues the copy into a pack buffer behind a fence and
+// Fetch() hands the data out once the GPU got there, usually a frame or two later. A copy started while another one
+// is still in flight is queued after it, so a texture that changes every frame still gets read back.
+class TextureReadback
+{
+  public:
+    TextureReadback() = default;
+    ~TextureReadback();
+
+    TextureReadback(const TextureReadback &) = delete;
+    TextureReadback &operator=(const TextureReadback &) = delete;
+
+    // size is the byte size of mip 0
+    void Start(uint32_t texture, ImageFormat format, uint32_t size);
+    // true when a copy arrived in data, which holds at least size bytes
+    bool Fetch(void *data);
+
+  private:
+    void Issue();
+
+  private:
+    uint32_t m_Buffer = 0;
+    uint32_t m_BufferSize = 0;
+    uint32_t m_Fence = 0;
+
+    // the copy to issue once the one in flight is fetched
+    uint32_t m_Texture = 0;
+    ImageFormat m_Format = ImageFormat::RGBA8;
+    uint32_t m_Size = 0;
+    bool m_Queued = false;
+};
+} // namespace Engine
@@ -18,6 +18,8 @@ enum class ImageFormat
     RGB16,
     RGBA8,
     RGBA32F,
+    R11G11B10F,
+    RG16F,
     RED_INTEGER,
 
     // Depth/stencil formats
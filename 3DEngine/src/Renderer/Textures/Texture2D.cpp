@@ -1,74 +1,17 @@
 #include "Texture2D.h"
 
-#include <glad/glad.h>
+#include "RenderCommand.h"
 
 namespace Engine
 {
-namespace Utils
-{
-static GLenum ImageFormatToGLDataFormat(ImageFormat format)
-{
-    switch (format)
-    {
-        case ImageFormat::R8: return GL_RED;
-        case ImageFormat::RGB8: return GL_RGB;
-        case ImageFormat::RGBA8: return GL_RGBA;
-        case ImageFormat::RGB16: return GL_RGBA;
-        case ImageFormat::RED_INTEGER: return GL_RED_INTEGER;
-        case ImageFormat::Depth: return GL_DEPTH_COMPONENT;
-        default: break;
-    }
-    return 0;
-}
-
-static GLenum ImageFormatToGLInternalFormat(ImageFormat format)
-{
-    switch (format)
-    {
-        case ImageFormat::R8: return GL_RED;
-        case ImageFormat::RGB8: return GL_RGB8;
-        case ImageFormat::RGBA8: return GL_RGBA8;
-        case ImageFormat::RGB16: return GL_RGB16F;
-        case ImageFormat::RED_INTEGER: return GL_R32I;
-        case ImageFormat::Depth: return GL_DEPTH_COMPONENT;
-        default: break;
-    }
-    return 0;
-}
-
-static GLenum ImageFormatToGLDataType(ImageFormat format)
-{
-    switch (format)
-    {
-        case ImageFormat::R8: return GL_UNSIGNED_BYTE;
-        case ImageFormat::RGB8: return GL_UNSIGNED_BYTE;
-        case ImageFormat::RGBA8: return GL_UNSIGNED_BYTE;
-        case ImageFormat::RGB16: return GL_FLOAT;
-        case ImageFormat::RED_INTEGER: return GL_INT;
-        case ImageFormat::Depth: return GL_FLOAT;
-        default: break;
-    }
-    return 0;
-}
-} // namespace Utils
-
 Texture2D::Texture2D()
 {
 }
 
 Texture2D::Texture2D(const TextureSpecification &specification, Buffer data) : m_Specification(specification)
 {
-    m_InternalFormat = Utils::ImageFormatToGLInternalFormat(m_Specification.Format);
-    m_DataFormat = Utils::ImageFormatToGLDataFormat(m_Specification.Format);
-    m_DataType = Utils::ImageFormatToGLDataType(m_Specification.Format);
-
-    glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-    glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Specification.Width, m_Specification.Height);
-
-    glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    m_RendererID = RenderCommand::CreateTexture2D(m_Specification.Format, m_Specification.Width,
+                                                  m_Specification.Height, RendererEnum::REPEAT);
 
     if (data) SetData(data);
 }
@@ -76,76 +19,44 @@ Texture2D::Texture2D(const TextureSpecification &specification, Buffer data) : m
 Texture2D::Texture2D(const TextureSpecification &specification)
 {
     m_Specification = specification;
-    m_InternalFormat = Utils::ImageFormatToGLInternalFormat(m_Specification.Format);
-    m_DataFormat = Utils::ImageFormatToGLDataFormat(m_Specification.Format);
-    m_DataType = Utils::ImageFormatToGLDataType(m_Specification.Format);
-
-    glGenTextures(1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
-    glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Specification.Width, m_Specification.Height, 0, m_DataFormat,
-                 m_DataType, nullptr);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    m_RendererID = RenderCommand::CreateTexture2D(m_Specification.Format, m_Specification.Width,
+                                                  m_Specification.Height, RendererEnum::CLAMP_TO_BORDER);
 }
 
 Texture2D::Texture2D(ImageFormat format) 
 {
     m_Specification = TextureSpecification{.Format = format};
-    m_InternalFormat = Utils::ImageFormatToGLInternalFormat(m_Specification.Format);
-    m_DataFormat = Utils::ImageFormatToGLDataFormat(m_Specification.Format);
-    m_DataType = Utils::ImageFormatToGLDataType(m_Specification.Format);
-
-    glGenTextures(1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
-    glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, m_Specification.Width, m_Specification.Height, 0, m_DataFormat,
-                 m_DataType, nullptr);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    m_RendererID = RenderCommand::CreateTexture2D(m_Specification.Format, m_Specification.Width,
+                                                  m_Specification.Height, RendererEnum::CLAMP_TO_BORDER);
 }
 
 Texture2D::~Texture2D() {}
 
 void Texture2D::SetData(Buffer data) 
 {
-    uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
-	assert(data.Size = m_Specification.Width * m_Specification.Height * bpp);
-    glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Specification.Width, m_Specification.Height, m_DataFormat, m_DataType,
-                        data.Data);
+    RenderCommand::SetTextureData(m_RendererID, m_Specification.Format, m_Specification.Width, m_Specification.Height,
+                                  data.Data);
 }
 
 void Texture2D::Bind(uint32_t slot) const
 {
     // bind at slot
-	//glBindTextureUnit(slot, m_RendererID);
-	glActiveTexture(GL_TEXTURE0 + slot);
-	glBindTexture(GL_TEXTURE_2D, m_RendererID);
+    RenderCommand::BindTexture(slot, m_RendererID);
 }
 
-void Texture2D::Unbind() const { glBindTexture(GL_TEXTURE_2D, 0); }
+void Texture2D::Unbind() const { RenderCommand::BindTexture(0, 0); }
 
 void Texture2D::Resize(glm::vec2 size)
 {
-    glDeleteTextures(1, &m_RendererID);
+    RenderCommand::DeleteTexture(m_RendererID);
     m_Specification.Width = size.x;
     m_Specification.Height = size.y;
 
-    glGenTextures(1, &m_RendererID);
-    glBindTexture(GL_TEXTURE_2D, m_RendererID);
-    glTexImage2D(GL_TEXTURE_2D, 0, m_InternalFormat, size.x, size.y, 0, m_DataFormat, m_DataType, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    m_RendererID = RenderCommand::CreateTexture2D(m_Specification.Format, size.x, size.y);
 }
 
 void Texture2D::AttachToFramebuffer(uint32_t attachment)
 {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, m_RendererID, 0);
+    RenderCommand::AttachTexture(attachment, m_RendererID);
 }
 } // namespace Engine
@@ -34,7 +34,6 @@ class Texture2D : public Texture
   private:
     TextureSpecification m_Specification;
     unsigned int m_RendererID = 0;
-    unsigned int m_InternalFormat, m_DataFormat, m_DataType;
 };
 
 using Texture2DRef = std::shared_ptr<Texture2D>;
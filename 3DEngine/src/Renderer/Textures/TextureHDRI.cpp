@@ -1,5 +1,7 @@
 #include "TextureHDRI.h"
 
+#include "MemoryTracker.h"
+
 #include <glad/glad.h>
 
 namespace Engine
@@ -15,6 +17,10 @@ TextureHDRI::TextureHDRI(const TextureSpecification &specification, float *data)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // RGB16F is stored padded to four halves
+    MemoryTracker::TrackGPU(GPUMemoryType::Textures, m_RendererID,
+                            (size_t)m_Specification.Width * m_Specification.Height * 8);
 }
 
 TextureHDRI::~TextureHDRI() {}
@@ -1,45 +1,52 @@
 #include "VertexArray.h"
 
-#include <glad/glad.h>
+#include "RenderCommand.h"
 
 namespace Engine
 {
-void VertexArray::Init() noexcept { glGenVertexArrays(1, &m_VAO); }
+namespace Utils
+{
+static RendererEnum BufferTypeToRendererEnum(const BufferType &type)
+{
+    return type == BufferType::ARRAY ? RendererEnum::ARRAY_BUFFER : RendererEnum::ELEMENT_ARRAY_BUFFER;
+}
 
-void VertexArray::AttachBuffer(const BufferType &type, const int size, const DrawMode &mode, const void *data) noexcept
+static RendererEnum DrawModeToRendererEnum(const DrawMode &mode)
 {
-    unsigned int buffer;
-    if (type == BufferType::ARRAY)
-    {
-        glGenBuffers(1, &m_VBOs[m_VBOCount]);
-        glBindBuffer(type, m_VBOs[m_VBOCount]);
-        m_VBOCount++;
-    }
-    else
+    switch (mode)
     {
-        glGenBuffers(1, &buffer);
-        glBindBuffer(type, buffer);
+        case DrawMode::STATIC: return RendererEnum::STATIC_DRAW;
+        case DrawMode::DYNAMIC: return RendererEnum::DYNAMIC_DRAW;
+        case DrawMode::STREAM: return RendererEnum::STREAM_DRAW;
     }
-    glBufferData(type, size, data, mode);
+    return RendererEnum::STATIC_DRAW;
+}
+} // namespace Utils
+
+void VertexArray::Init() noexcept { m_VAO = RenderCommand::CreateVertexArray(); }
+
+void VertexArray::AttachBuffer(const BufferType &type, const int size, const DrawMode &mode, const void *data) noexcept
+{
+    uint32_t buffer = RenderCommand::CreateBuffer(Utils::BufferTypeToRendererEnum(type), size, data,
+                                                  Utils::DrawModeToRendererEnum(mode));
+    if (type == BufferType::ARRAY) m_VBOs[m_VBOCount++] = buffer;
 }
 
-void VertexArray::Bind() const noexcept { glBindVertexArray(m_VAO); }
+void VertexArray::Bind() const noexcept { RenderCommand::BindVertexArray(m_VAO); }
 
-void VertexArray::Unbind() const noexcept { glBindVertexArray(0); }
+void VertexArray::Unbind() const noexcept { RenderCommand::BindVertexArray(0); }
 
 void VertexArray::EnableAttribute(const uint32_t index, const int size, const uint32_t offset,
                                   const void *data) noexcept
 {
-    glEnableVertexAttribArray(index);
-    glVertexAttribPointer(index, size, GL_FLOAT, GL_FALSE, offset, data);
+    RenderCommand::SetVertexAttribute(index, size, offset, data);
 }
 
 void VertexArray::SetBufferSubData(const int index, const BufferType &type, const uint32_t offset, const uint32_t size,
                                    const void *data) noexcept
 {
-    glBindBuffer(type, m_VBOs[index]);
-    glBufferSubData(type, offset, size, data);
+    RenderCommand::SetBufferSubData(Utils::BufferTypeToRendererEnum(type), m_VBOs[index], offset, size, data);
 }
 
-void VertexArray::Delete() noexcept { glDeleteVertexArrays(1, &m_VAO); }
-} // namespace Engine
\ No newline at end of file
+void VertexArray::Delete() noexcept { RenderCommand::DeleteVertexArray(m_VAO); }
+} // namespace Engine
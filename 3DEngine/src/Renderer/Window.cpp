@@ -3,8 +3,10 @@
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "FramePacer.h"
 #include "InputManager.h"
 #include "Log.h"
+#include "RenderThread.h"
 #include <iostream>
 
 namespace Engine
@@ -47,7 +49,8 @@ void Window::OnUpdate()
 {
     // Define the viewport dimensions
     auto windowState = InputManager::Instance().GetWindowState();
-    glViewport(0, 0, windowState.Width, windowState.Height);
+    RenderThread::Submit([width = windowState.Width, height = windowState.Height]
+                         { glViewport(0, 0, width, height); });
 
     // reset mouse scroll state
     m_Input.UpdateMouseScrollState(0.0f, 0.0f);
@@ -55,6 +58,16 @@ void Window::OnUpdate()
     glfwPollEvents();
 }
 
+void Window::SetVSync(bool enabled)
+{
+    m_VSync = enabled;
+    RenderThread::Submit([enabled] { glfwSwapInterval(enabled ? 1 : 0); });
+}
+
+bool Window::IsMinimized() const { return glfwGetWindowAttrib(m_Window, GLFW_ICONIFIED); }
+
+bool Window::IsFocused() const { return glfwGetWindowAttrib(m_Window, GLFW_FOCUSED); }
+
 void Window::Init(const WindowProps &props)
 {
     glfwInit();
@@ -78,6 +91,7 @@ void Window::Init(const WindowProps &props)
         glfwTerminate();
     }
     glfwMakeContextCurrent(m_Window);
+    glfwSwapInterval(m_VSync ? 1 : 0);
 
     SetWindowEventCallbacks();
     SetInputEventCallbacks();
@@ -106,6 +120,7 @@ void Window::SetInputEventCallbacks()
             case GLFW_REPEAT: value = 2.0f; break;
         };
         input->UpdateKeyboardState(key, value);
+        FramePacer::RequestRedraw();
     };
     glfwSetKeyCallback(m_Window, keyCallback);
 
@@ -120,6 +135,7 @@ void Window::SetInputEventCallbacks()
             case GLFW_RELEASE: value = -1.0f; break;
         };
         input->UpdateMousePressState(button, value);
+        FramePacer::RequestRedraw();
     };
     glfwSetMouseButtonCallback(m_Window, mouseCallback);
 
@@ -127,6 +143,7 @@ void Window::SetInputEventCallbacks()
     {
         Input *input = static_cast<Input *>(glfwGetWindowUserPointer(window));
         input->UpdateCursorPosition(xPos, yPos);
+        FramePacer::RequestRedraw();
     };
     glfwSetCursorPosCallback(m_Window, cursorPositionCallback);
 
@@ -134,6 +151,7 @@ void Window::SetInputEventCallbacks()
     {
         Input *input = static_cast<Input *>(glfwGetWindowUserPointer(window));
         input->UpdateMouseScrollState(xOffset, yOffset);
+        FramePacer::RequestRedraw();
     };
     glfwSetScrollCallback(m_Window, scrollCallback);
 }
@@ -159,8 +177,14 @@ void Window::SetWindowEventCallbacks()
             .Width = width,
             .Height = height,
         });
+        FramePacer::RequestRedraw();
     };
     glfwSetWindowSizeCallback(m_Window, windowResizeCallback);
+
+    // whatever changes how the window looks is drawn even when rendering on demand
+    glfwSetWindowFocusCallback(m_Window, [](GLFWwindow *, int) { FramePacer::RequestRedraw(); });
+    glfwSetWindowIconifyCallback(m_Window, [](GLFWwindow *, int) { FramePacer::RequestRedraw(); });
+    glfwSetWindowRefreshCallback(m_Window, [](GLFWwindow *) { FramePacer::RequestRedraw(); });
 }
 
 void Window::Shutdown()
@@ -33,6 +33,13 @@ class Window
 
     void OnUpdate();
 
+    // takes effect on the thread that presents, see RenderThread
+    void SetVSync(bool enabled);
+    bool IsVSync() const { return m_VSync; }
+
+    bool IsMinimized() const;
+    bool IsFocused() const;
+
     GLFWwindow *GetNativeWindow() const { return m_Window; }
     Input GetInput() const { return m_Input; }
 
@@ -46,5 +53,6 @@ class Window
     GLFWwindow *m_Window;
     WindowProps m_WindowProps;
     Input m_Input{};
+    bool m_VSync = true;
 };
 } // namespace Engine
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <entt.hpp>
+
+#include <vector>
+
+namespace Engine
+{
+// Entities whose tracked components were added, patched or removed since the owner last called Clear(), fed by the
+// registry's construct, update and destroy signals. Every consumer owns its set and drains it at its own point of
+// the frame, so none of them misses what changed in between. Writes through GetComponent references go unseen,
+// mutations meant to be noticed go through Entity::PatchComponent.
+//
+// Must not outlive the registry it tracks.
+class ChangeSet
+{
+  public:
+    ChangeSet() = default;
+    ChangeSet(const ChangeSet &) = delete;
+    ChangeSet &operator=(const ChangeSet &) = delete;
+    ~ChangeSet() { Disconnect(); }
+
+    template <typename... Components> void Track(entt::registry &registry) { (Connect<Components>(registry), ...); }
+
+    void Disconnect()
+    {
+        for (auto &connection : m_Connections)
+            connection.release();
+        m_Connections.clear();
+    }
+
+    // added or patched; the entity may have lost the component or been destroyed since, so check before use
+    const entt::sparse_set<entt::entity> &GetChanged() const { return m_Changed; }
+    // a tracked component was removed, or the entity destroyed
+    const entt::sparse_set<entt::entity> &GetRemoved() const { return m_Removed; }
+
+    bool Empty() const { return m_Changed.empty() && m_Removed.empty(); }
+    void Clear()
+    {
+        m_Changed.clear();
+        m_Removed.clear();
+    }
+
+  private:
+    template <typename Component> void Connect(entt::registry &registry)
+    {
+        m_Connections.push_back(registry.on_construct<Component>().template connect<&ChangeSet::OnChanged>(*this));
+        m_Connections.push_back(registry.on_update<Component>().template connect<&ChangeSet::OnChanged>(*this));
+        m_Connections.push_back(registry.on_destroy<Component>().template connect<&ChangeSet::OnRemoved>(*this));
+    }
+
+    void OnChanged(entt::registry &, entt::entity entity)
+    {
+        if (!m_Changed.contains(entity)) m_Changed.emplace(entity);
+    }
+
+    void OnRemoved(entt::registry &, entt::entity entity)
+    {
+        if (!m_Removed.contains(entity)) m_Removed.emplace(entity);
+    }
+
+  private:
+    entt::sparse_set<entt::entity> m_Changed, m_Removed;
+    std::vector<entt::connection> m_Connections;
+};
+} // namespace Engine
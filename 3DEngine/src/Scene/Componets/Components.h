@@ -68,6 +68,13 @@ struct TransformComponent
 	glm::vec3 LocalRotation = {0.0f, 0.0f, 0.0f};
 	glm::vec3 LocalScale = {1.0f, 1.0f, 1.0f};
 
+    // GetTransform() cached by Scene::UpdateWorldMatrices, whoever writes Translation, Rotation or Scale calls
+    // MarkDirty() so the next update recomputes it
+    glm::mat4 WorldMatrix = glm::mat4(1.0f);
+    bool Dirty = true;
+    // for children, whose world values follow the parent and the Local* ones
+    bool LocalDirty = true;
+
     TransformComponent() = default;
     TransformComponent(const TransformComponent &) = default;
     TransformComponent(const glm::vec3 &translation) : Translation(translation) {}
@@ -78,8 +85,12 @@ struct TransformComponent
         return glm::translate(glm::mat4(1.0f), Translation) * rotation * glm::scale(glm::mat4(1.0f), Scale);
     }
 
+    const glm::mat4 &GetWorldMatrix() const { return WorldMatrix; }
+    void MarkDirty() { Dirty = true; }
+
     void SetTransform(const glm::mat4 &transform)
     {
+        Dirty = true;
         Translation = glm::vec3(transform[3]);
         Scale = glm::vec3(glm::length(transform[0]), glm::length(transform[1]), glm::length(transform[2]));
 
@@ -97,6 +108,7 @@ struct TransformComponent
 
 	void SetLocalTransform(const glm::mat4 &transform)
 	{
+        LocalDirty = true;
         LocalTranslation = glm::vec3(transform[3]);
         LocalScale = glm::vec3(glm::length(transform[0]), glm::length(transform[1]), glm::length(transform[2]));
 
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 
 #include "Components.h"
 #include "PhysicsShapes.h"
@@ -27,6 +28,11 @@ struct RigidBodyComponent
     bool IsKinematic = false;
     bool UseGravity = true;
 
+    // the body's pose after the last two physics steps, rendering blends them by the interpolation alpha
+    glm::vec3 PreviousPosition = glm::vec3(0.0f), CurrentPosition = glm::vec3(0.0f);
+    glm::quat PreviousRotation = glm::quat(), CurrentRotation = glm::quat();
+    bool HasPose = false;
+
     RigidBodyComponent() = default;
     RigidBodyComponent(const RigidBodyComponent &) = default;
 
@@ -14,5 +14,6 @@ void Entity::AddChild(Entity &child)
 
 	auto id = child.GetComponent<IDComponent>().ID;
 	GetComponent<ParentComponent>().Children.push_back(id);
+	m_Scene->InvalidateHierarchy();
 }
 } // namespace Engine
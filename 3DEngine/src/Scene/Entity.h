@@ -2,6 +2,8 @@
 
 #include <entt.hpp>
 
+#include <typeinfo>
+
 #include "Scene.h"
 #include "UUID.h"
 
@@ -18,31 +20,56 @@ class Entity
 
     template <typename T, typename... Args> T &AddComponent(Args &&...args)
     {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), true);
+#endif
         //if (HasComponent<T>()) throw std::runtime_error("Entity already has component!");
         return m_Scene->m_Registry.emplace<T>(m_EntityHandle, std::forward<Args>(args)...);
     }
 
     template <typename T, typename... Args> T &AddOrReplaceComponent(Args &&...args)
     {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), true);
+#endif
         T &component = m_Scene->m_Registry.emplace_or_replace<T>(m_EntityHandle, std::forward<Args>(args)...);
         // m_Scene->OnComponentAdded<T>(*this, component);
         return component;
     }
 
+    // modifies a component so that change sets tracking it see the entity, see ChangeSet; without a function it
+    // only reports a change made through GetComponent
+    template <typename T, typename... Func> T &PatchComponent(Func &&...func)
+    {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), true);
+#endif
+        return m_Scene->m_Registry.patch<T>(m_EntityHandle, std::forward<Func>(func)...);
+    }
+
     template <typename T> T &GetComponent()
     {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), false);
+#endif
         //if (!HasComponent<T>()) throw std::runtime_error("Entity does not have component!");
         return m_Scene->m_Registry.get<T>(m_EntityHandle);
     }
 
     template <typename T> bool HasComponent()
     {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), false);
+#endif
         //
         return m_Scene->m_Registry.has<T>(m_EntityHandle);
     }
 
     template <typename T> void RemoveComponent()
     {
+#ifdef ENGINE_CHECK_SYSTEM_ACCESS
+        SystemAccess::Check(entt::type_info<T>::id(), typeid(T).name(), true);
+#endif
         //if (!HasComponent<T>()) throw std::runtime_error("Entity does not have component!");
         m_Scene->m_Registry.remove<T>(m_EntityHandle);
     }
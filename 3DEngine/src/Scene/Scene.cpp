@@ -9,6 +9,9 @@
 #include "PhysicsManager.h"
 #include "Components.h"
 #include "RenderCommand.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "RenderThread.h"
 
 namespace Engine
 {
@@ -91,6 +94,10 @@ Scene::Scene()
 
     PhysicsManager::Get().Init(this);
 
+    m_Registry.on_construct<ParentComponent>().connect<&Scene::OnParentComponentChanged>(this);
+    m_Registry.on_destroy<ParentComponent>().connect<&Scene::OnParentComponentChanged>(this);
+    TrackChanges<DirectionalLightComponent, PointLightComponent, SpotLightComponent>(m_LightChanges);
+
     // Add systems
     m_Systems.push_back(std::make_shared<PhysicsSystem>(this));
     m_Systems.push_back(std::make_shared<TransformSystem>(this));
@@ -145,7 +152,17 @@ void Scene::StepRuntimeFrame(int step)
 
 void Scene::OnUpdate(float dt)
 {
-    for (const auto &system : m_Systems) system->Update(dt);
+    m_Scheduler.Run(m_Systems, SystemPhase::Update, dt);
+
+    UpdateLights();
+}
+
+void Scene::UpdateLights()
+{
+    // Light keeps pointers into the component pools, which move when a light is added or removed, so any change
+    // hands all of them over again; a frame without one has nothing to do
+    if (m_LightChanges.Empty()) return;
+    m_LightChanges.Clear();
 
     auto view = m_Registry.view<DirectionalLightComponent>();
     for (auto entity : view)
@@ -170,9 +187,36 @@ void Scene::OnUpdate(float dt)
     }
 }
 
-void Scene::OnFixedUpdate(float dt)
+void Scene::OnFixedUpdate(float dt) { m_Scheduler.Run(m_Systems, SystemPhase::FixedUpdate, dt); }
+
+void Scene::UpdateWorldMatrices()
 {
-    for (const auto &system : m_Systems) system->FixedUpdate(dt);
+    PROFILE_FUNCTION();
+    m_TransformBatch.Clear();
+    m_DirtyTransforms.clear();
+
+    auto view = m_Registry.view<TransformComponent>();
+    for (auto entity : view)
+    {
+        auto &transform = view.get<TransformComponent>(entity);
+        if (!transform.Dirty) continue;
+
+        m_TransformBatch.Add(transform.Translation, transform.Rotation, transform.Scale);
+        m_DirtyTransforms.push_back(&transform);
+    }
+
+    m_WorldMatrices.resize(m_DirtyTransforms.size());
+    JobSystem::ParallelFor(m_DirtyTransforms.size(), 1024,
+                           [this](size_t begin, size_t end)
+                           {
+                               m_TransformBatch.Compute(m_WorldMatrices.data(), begin, end);
+                               for (size_t i = begin; i < end; i++)
+                               {
+                                   m_DirtyTransforms[i]->WorldMatrix = m_WorldMatrices[i];
+                                   m_DirtyTransforms[i]->Dirty = false;
+                               }
+                           });
+    PROFILE_COUNTER("Transforms Updated", m_DirtyTransforms.size());
 }
 
 Entity Scene::CreateEntity(const std::string &name) { return CreateEntityWithUUID(UUID(), name); }
@@ -269,6 +313,7 @@ void Scene::OnUpdateRuntime(float dt)
 	{
 		// Update scripts
 		{
+			PROFILE_SCOPE("Scripts::OnUpdate");
 			// C# Entity OnUpdate
 			auto view = m_Registry.view<ScriptComponent>();
 			for (auto e : view)
@@ -295,21 +340,96 @@ void Scene::OnUpdateRuntime(float dt)
 			}
 		}
 	}
-    RenderCommand::SetClearColor({0, 0, 0});
-    RenderCommand::Clear();
+    // scripts may have moved entities since the transform system ran
+    UpdateWorldMatrices();
 
-    if (m_MainCamera != nullptr)
+    if (m_MainCamera == nullptr)
     {
-        m_SceneRenderer->BeginRenderScene(m_MainCamera->GetProjectionMatrix(), m_MainCamera->GetViewMatrix(),
-                                          m_MainCamera->GetPosition());
-        m_SceneRenderer->RenderScene(*this, *m_Framebuffer);
+        RenderThread::Submit(
+            []
+            {
+                RenderCommand::SetClearColor({0, 0, 0});
+                RenderCommand::Clear();
+            });
+        return;
     }
+    SubmitRender(CaptureRenderSnapshot(m_MainCamera->GetProjectionMatrix(), m_MainCamera->GetViewMatrix(),
+                                       m_MainCamera->GetPosition()));
 }
 
 void Scene::OnUpdateEditor(float dt, EditorCamera &camera)
 {
-    m_SceneRenderer->BeginRenderScene(camera.GetProjectionMatrix(), camera.GetViewMatrix(), camera.GetPosition());
-    m_SceneRenderer->RenderScene(*this, *m_Framebuffer);
+    UpdateWorldMatrices();
+    SubmitRender(CaptureRenderSnapshot(camera.GetProjectionMatrix(), camera.GetViewMatrix(), camera.GetPosition()));
 }
 
+RenderSnapshotRef Scene::CaptureRenderSnapshot(const glm::mat4 &projection, const glm::mat4 &view,
+                                               const glm::vec3 &cameraPosition)
+{
+    PROFILE_FUNCTION();
+    auto snapshot = std::make_shared<RenderSnapshot>();
+    snapshot->Projection = projection;
+    snapshot->View = view;
+    snapshot->CameraPosition = cameraPosition;
+
+    // rigid bodies render between their last two poses, paused ones where they stopped
+    const bool interpolate = m_IsPlaying && !m_IsPaused && m_InterpolationAlpha < 1.0f;
+
+    // models and materials are resolved here, the asset manager belongs to this thread
+    snapshot->Meshes.reserve(m_Registry.view<MeshComponent>().size());
+    auto meshView = m_Registry.view<MeshComponent, TransformComponent, VisibilityComponent>();
+    for (auto entity : meshView)
+    {
+        auto [model, transform, visibility] =
+            meshView.get<MeshComponent, TransformComponent, VisibilityComponent>(entity);
+        const bool selected = entity == m_SelectedEntity;
+        if (!visibility.IsVisible) snapshot->CulledMeshes++;
+        if (!visibility.IsVisible && !selected) continue;
+        if (model.Handle == 0 && model.ModelResource == nullptr) continue;
+
+        MeshProxy proxy{model.ModelResource ? model.ModelResource : AssetManager::GetAsset<Model>(model.Handle),
+                        transform.GetWorldMatrix(), (int)entity};
+        if (proxy.Model == nullptr) continue;
+
+        proxy.FirstMaterial = (uint32_t)snapshot->Materials.size();
+        for (const auto &mesh : proxy.Model->GetMeshes())
+        {
+            MeshMaterials materials;
+            materials.Default = AssetManager::GetAsset<Material>(mesh.DefaultMaterialHandle);
+            materials.Material =
+                mesh.MaterialHandle > 0 ? AssetManager::GetAsset<Material>(mesh.MaterialHandle) : materials.Default;
+            snapshot->Materials.push_back(std::move(materials));
+        }
+
+        const auto *rigidBody = interpolate ? m_Registry.try_get<RigidBodyComponent>(entity) : nullptr;
+        if (rigidBody && rigidBody->HasPose)
+        {
+            const glm::vec3 position =
+                glm::mix(rigidBody->PreviousPosition, rigidBody->CurrentPosition, m_InterpolationAlpha);
+            const glm::quat rotation =
+                glm::slerp(rigidBody->PreviousRotation, rigidBody->CurrentRotation, m_InterpolationAlpha);
+            proxy.Transform = glm::translate(glm::mat4(1.0f), position) * glm::toMat4(rotation) *
+                              glm::scale(glm::mat4(1.0f), transform.Scale);
+        }
+        if (selected) snapshot->Selected.push_back(proxy);
+        if (visibility.IsVisible) snapshot->Meshes.push_back(std::move(proxy));
+    }
+
+    snapshot->Lights = m_Lights->CopyValues();
+    snapshot->Environment = *m_Environment;
+    snapshot->Target = m_Framebuffer;
+    snapshot->ViewportMousePos = m_ViewportMousePos;
+    snapshot->IsPlaying = m_IsPlaying;
+    snapshot->HasSelection = m_Registry.valid(m_SelectedEntity);
+    return snapshot;
+}
+
+void Scene::SubmitRender(RenderSnapshotRef snapshot)
+{
+    RenderThread::Submit([renderer = m_SceneRenderer, snapshot = std::move(snapshot)]
+                         { renderer->RenderScene(*snapshot); });
+}
+
+entt::entity Scene::GetHoveredEntity() const { return m_SceneRenderer->GetHoveredEntity(); }
+
 } // namespace Engine
@@ -10,15 +10,21 @@
 #include "UUID.h"
 #include "Asset.h"
 #include "Environment.h"
+#include "Framebuffer.h"
 #include "Light.h"
+#include "RenderSnapshot.h"
+#include "TransformBatch.h"
 
 #include "System.h"
+#include "SystemScheduler.h"
+#include "ChangeSet.h"
 
 namespace Engine
 {
 class Entity;
 class Camera;
 class SceneRenderer;
+struct TransformComponent;
 
 class Scene : public Asset
 {
@@ -32,6 +38,16 @@ class Scene : public Asset
     void OnUpdate(float dt);
     void OnFixedUpdate(float dt);
 
+    // recomputes the cached world matrix of every dirty TransformComponent, in SIMD batches
+    void UpdateWorldMatrices();
+
+    // called when a parent link changes, creating or destroying entities does it on its own
+    void InvalidateHierarchy() { m_HierarchyVersion++; }
+    uint64_t GetHierarchyVersion() const { return m_HierarchyVersion; }
+
+    // feeds changes of the given component types to a consumer's set, see ChangeSet
+    template <typename... Components> void TrackChanges(ChangeSet &changes) { changes.Track<Components...>(m_Registry); }
+
     Entity CreateEntity(const std::string &name = std::string());
     Entity CreateEntityWithUUID(UUID uuid, const std::string &name = std::string());
     Entity *GetEntity(const std::string &name);
@@ -51,6 +67,13 @@ class Scene : public Asset
     void OnUpdateRuntime(float dt);
     void OnUpdateEditor(float dt, EditorCamera &camera);
 
+    // copies what the renderer needs of the current state, world matrices have to be up to date
+    RenderSnapshotRef CaptureRenderSnapshot(const glm::mat4 &projection, const glm::mat4 &view,
+                                            const glm::vec3 &cameraPosition);
+
+    // how far the frame is between the last two physics steps, rigid bodies render blended between their poses
+    void SetInterpolationAlpha(float alpha) { m_InterpolationAlpha = alpha; }
+
 	bool IsPlaying() const { return m_IsPlaying; }
 	bool IsPaused() const { return m_IsPaused; }
 	void SetPlaying(bool playing) { m_IsPlaying = playing; }
@@ -72,14 +95,15 @@ class Scene : public Asset
     void SetEnvironment(EnvironmentRef environment) { m_Environment = environment; }
 
 	void SetFramebuffer(FramebufferRef framebuffer) { m_Framebuffer = framebuffer; }
+    SceneRenderer *GetSceneRenderer() const { return m_SceneRenderer; }
 
     LightRef GetLights() { return m_Lights; }
 
 	void SetViewportSize(int x, int y) { m_ViewportSize = glm::vec2(x, y) ; }
     void SetViewportMousePos(int x, int y) { m_ViewportMousePos = glm::ivec2(x, y); }
 
-	void SetHoveredEntity(entt::entity entity) { m_HoveredEntity = entity; }
-	entt::entity GetHoveredEntity() const { return m_HoveredEntity; }
+	// as of the last rendered frame, which trails the update by the frame latency when rendering is pipelined
+	entt::entity GetHoveredEntity() const;
 
 	glm::vec2 GetViewportMousePos() { return m_ViewportMousePos; }
 
@@ -89,6 +113,12 @@ class Scene : public Asset
   public:
     static std::shared_ptr<Scene> Copy(std::shared_ptr<Scene> src);
 
+  private:
+    void UpdateLights();
+    // renders on the render thread when it runs, right away otherwise
+    void SubmitRender(RenderSnapshotRef snapshot);
+    void OnParentComponentChanged(entt::registry &, entt::entity) { InvalidateHierarchy(); }
+
   private:
 	bool m_IsPlaying = false;
 	bool m_IsPaused = false;
@@ -97,13 +127,13 @@ class Scene : public Asset
   private:
     entt::registry m_Registry;
     entt::entity m_SelectedEntity = entt::null;
-	entt::entity m_HoveredEntity = entt::null;
 
 	std::unordered_map<UUID, entt::entity> m_EntityMap;
 
     friend class Entity;
     friend class SceneHierarchyPanel;
     friend class SceneSerializer;
+    friend class TransformSystem;
 
   private:
     std::shared_ptr<PerspectiveCamera> m_MainCamera;
@@ -117,6 +147,16 @@ class Scene : public Asset
     EnvironmentRef m_Environment;
 
     std::vector<SystemRef> m_Systems;
+    SystemScheduler m_Scheduler;
+    uint64_t m_HierarchyVersion = 1;
+    ChangeSet m_LightChanges;
+
+    // scratch of UpdateWorldMatrices, kept to reuse the allocations
+    Math::TransformBatch m_TransformBatch;
+    std::vector<TransformComponent *> m_DirtyTransforms;
+    std::vector<glm::mat4> m_WorldMatrices;
+
+    float m_InterpolationAlpha = 1.0f;
 
 	glm::vec2 m_ViewportSize = glm::vec2(0.0f);
     glm::ivec2 m_ViewportMousePos;
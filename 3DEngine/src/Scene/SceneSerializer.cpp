@@ -8,6 +8,7 @@
 #include "Entity.h"
 #include "ScriptEngine.h"
 #include "MaterialSerializer.h"
+#include "VirtualFileSystem.h"
 
 #include <yaml-cpp/yaml.h>
 
@@ -272,6 +273,7 @@ static void SerializeEntity(YAML::Emitter &out, Entity entity)
         out << YAML::Key << "Enabled" << YAML::Value << dlc.Enabled;
         out << YAML::Key << "Color" << YAML::Value << dlc.Light.Color;
         out << YAML::Key << "AmbientIntensity" << YAML::Value << dlc.Light.Intensity;
+        out << YAML::Key << "FollowSky" << YAML::Value << dlc.Light.FollowSky;
 
         out << YAML::EndMap;
     }
@@ -323,6 +325,10 @@ void SceneSerializer::Serialize(const std::string &filepath)
     out << YAML::Key << "Exposure" << YAML::Value << environment->Exposure;
     out << YAML::Key << "BloomIntensity" << YAML::Value << environment->BloomIntensity;
 
+    out << YAML::Key << "DepthPrepass" << YAML::Value << environment->DepthPrepass;
+    out << YAML::Key << "DeferredShading" << YAML::Value << environment->DeferredShading;
+    out << YAML::Key << "SHIrradiance" << YAML::Value << environment->SHIrradiance;
+
     if (environment->SkyboxHDR)
     {
         out << YAML::Key << "HDRIHandle" << YAML::Value << environment->SkyboxHDR->GetHandle();
@@ -373,11 +379,10 @@ void SceneSerializer::SerializeRuntime(const std::string &filepath) {}
 
 bool SceneSerializer::Deserialize(const std::string &filepath)
 {
-    std::ifstream stream(filepath);
-    std::stringstream strStream;
-    strStream << stream.rdbuf();
+    FileMapping file = VirtualFileSystem::Open(filepath);
+    MemoryStream stream(file);
 
-    YAML::Node data = YAML::Load(strStream.str());
+    YAML::Node data = YAML::Load(stream);
     if (!data["Scene"]) return false;
 
     std::string sceneName = data["Scene"].as<std::string>();
@@ -400,6 +405,12 @@ bool SceneSerializer::Deserialize(const std::string &filepath)
 			m_Scene->GetEnvironment()->Exposure = environment["Exposure"].as<float>();
         if (environment["BloomIntensity"])
 			m_Scene->GetEnvironment()->BloomIntensity = environment["BloomIntensity"].as<float>();
+        if (environment["DepthPrepass"])
+			m_Scene->GetEnvironment()->DepthPrepass = environment["DepthPrepass"].as<bool>();
+        if (environment["DeferredShading"])
+			m_Scene->GetEnvironment()->DeferredShading = environment["DeferredShading"].as<bool>();
+        if (environment["SHIrradiance"])
+			m_Scene->GetEnvironment()->SHIrradiance = environment["SHIrradiance"].as<bool>();
 
         if (SkyTypeFromString(skyType) == SkyType::SkyboxHDR)
         {
@@ -545,6 +556,8 @@ bool SceneSerializer::Deserialize(const std::string &filepath)
                 dlc.Light.Direction = tc.Rotation;
                 dlc.Light.Color = directionalLightComponent["Color"].as<glm::vec3>();
                 dlc.Light.Intensity = directionalLightComponent["AmbientIntensity"].as<float>();
+                if (directionalLightComponent["FollowSky"])
+                    dlc.Light.FollowSky = directionalLightComponent["FollowSky"].as<bool>();
             }
 
             auto pointLightComponent = entity["PointLightComponent"];
@@ -9,7 +9,15 @@
 
 namespace Engine
 {
-PhysicsSystem::PhysicsSystem(Scene *scene) { m_Scene = scene; }
+PhysicsSystem::PhysicsSystem(Scene *scene)
+{
+    m_Scene = scene;
+    m_Scene->TrackChanges<RigidBodyComponent, BoxColliderComponent>(m_BodyChanges);
+
+    // the simulation writes the transforms of bodies back
+    Reads<BoxColliderComponent>();
+    Writes<TransformComponent, RigidBodyComponent>();
+}
 
 bool PhysicsSystem::Init()
 {
@@ -33,7 +41,11 @@ void PhysicsSystem::Draw() {}
 
 void PhysicsSystem::FixedUpdate(float dt)
 {
-    InitializeRigidbodies();
+    // only entities whose body or collider changed can be missing a body
+    for (auto entity : m_BodyChanges.GetChanged())
+        InitializeRigidbody(entity);
+    m_BodyChanges.Clear();
+
     ApplyForces();
 
     PhysicsManager::Get().Step(dt);
@@ -56,38 +68,44 @@ void PhysicsSystem::InitializeShapes()
 
 void PhysicsSystem::InitializeRigidbodies()
 {
-    // this code will be called if i have rigid body component
     auto view = m_Scene->GetRegistry().view<TransformComponent, RigidBodyComponent>();
     for (auto entity : view)
-    {
-        auto [transform, rb] = view.get<TransformComponent, RigidBodyComponent>(entity);
-        Entity ent = Entity{entity, m_Scene};
-        auto &rigidBodyComponent = ent.GetComponent<RigidBodyComponent>();
-        Physics::RigidBodyRef rigidBody;
+        InitializeRigidbody(entity);
+    m_BodyChanges.Clear();
+}
 
-        if (rigidBodyComponent.GetRigidBody()) continue;
+void PhysicsSystem::InitializeRigidbody(entt::entity entity)
+{
+    const auto &registry = m_Scene->GetRegistry();
+    if (!registry.valid(entity) || !registry.has<TransformComponent, RigidBodyComponent>(entity)) return;
 
-        // rigidBody will not be registered if it has no shape
-        if (ent.HasComponent<BoxColliderComponent>())
-        {
-            float mass = rigidBodyComponent.Mass;
+    Entity ent = Entity{entity, m_Scene};
+    auto &transform = ent.GetComponent<TransformComponent>();
+    auto &rigidBodyComponent = ent.GetComponent<RigidBodyComponent>();
+    Physics::RigidBodyRef rigidBody;
 
-            auto &boxComponent = ent.GetComponent<BoxColliderComponent>();
-            Physics::BoxRef boxShape = std::make_shared<Physics::Box>(boxComponent.Size * transform.Scale);
-            rigidBody = std::make_shared<Physics::RigidBody>(mass, transform.Translation, transform.Rotation,
-                                                             transform.GetTransform(), boxShape, ent);
+    if (rigidBodyComponent.GetRigidBody()) return;
 
-            rigidBody->MotionType = rigidBodyComponent.MotionType;
-            rigidBody->LinearDamping = rigidBodyComponent.LinearDamping;
-            rigidBody->AngularDamping = rigidBodyComponent.AngularDamping;
-            rigidBody->IsKinematic = rigidBodyComponent.IsKinematic;
-            rigidBody->UseGravity = rigidBodyComponent.UseGravity;
-            PhysicsManager::Get().RegisterBody(rigidBody);
-        }
+    // rigidBody will not be registered if it has no shape
+    if (ent.HasComponent<BoxColliderComponent>())
+    {
+        float mass = rigidBodyComponent.Mass;
 
-        rigidBodyComponent.RigidBody = rigidBody;
+        auto &boxComponent = ent.GetComponent<BoxColliderComponent>();
+        Physics::BoxRef boxShape = std::make_shared<Physics::Box>(boxComponent.Size * transform.Scale);
+        rigidBody = std::make_shared<Physics::RigidBody>(mass, transform.Translation, transform.Rotation,
+                                                         transform.GetTransform(), boxShape, ent);
+
+        rigidBody->MotionType = rigidBodyComponent.MotionType;
+        rigidBody->LinearDamping = rigidBodyComponent.LinearDamping;
+        rigidBody->AngularDamping = rigidBodyComponent.AngularDamping;
+        rigidBody->IsKinematic = rigidBodyComponent.IsKinematic;
+        rigidBody->UseGravity = rigidBodyComponent.UseGravity;
+        PhysicsManager::Get().RegisterBody(rigidBody);
     }
 
+    rigidBodyComponent.RigidBody = rigidBody;
+
     // TODO: Add support for other shapes
 }
 
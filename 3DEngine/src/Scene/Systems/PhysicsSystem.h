@@ -1,6 +1,7 @@
 #pragma once
 
 #include "System.h"
+#include "ChangeSet.h"
 
 namespace Engine
 {
@@ -15,10 +16,17 @@ class PhysicsSystem : public System
     void FixedUpdate(float dt) override;
     void Exit() override;
 
+    const char *GetName() const override { return "PhysicsSystem"; }
+
   private:
     void InitializeShapes();
     void InitializeRigidbodies();
+    void InitializeRigidbody(entt::entity entity);
 
     void ApplyForces();
+
+  private:
+    // rigid bodies and colliders added or edited since the last step
+    ChangeSet m_BodyChanges;
 };
 } // namespace Engine
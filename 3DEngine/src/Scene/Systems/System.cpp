@@ -0,0 +1,70 @@
+#include "System.h"
+
+#include "Log.h"
+
+#include <algorithm>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+
+namespace Engine
+{
+namespace Utils
+{
+static thread_local const SystemAccess *t_CurrentAccess = nullptr;
+static thread_local const char *t_CurrentSystem = nullptr;
+
+static bool Contains(const std::vector<entt::id_type> &types, entt::id_type type)
+{
+    return std::find(types.begin(), types.end(), type) != types.end();
+}
+} // namespace Utils
+
+bool SystemAccess::CanRead(entt::id_type type) const
+{
+    return !Declared || Utils::Contains(Reads, type) || Utils::Contains(Writes, type);
+}
+
+bool SystemAccess::CanWrite(entt::id_type type) const { return !Declared || Utils::Contains(Writes, type); }
+
+bool SystemAccess::ConflictsWith(const SystemAccess &other) const
+{
+    if (!Declared || !other.Declared) return true;
+
+    for (auto type : Writes)
+        if (Utils::Contains(other.Reads, type) || Utils::Contains(other.Writes, type)) return true;
+    for (auto type : other.Writes)
+        if (Utils::Contains(Reads, type)) return true;
+    return false;
+}
+
+void SystemAccess::Check(entt::id_type type, const char *typeName, bool write)
+{
+    const SystemAccess *access = Utils::t_CurrentAccess;
+    if (!access || (write ? access->CanWrite(type) : access->CanRead(type))) return;
+
+    // once per system, type and kind of access, it would repeat every frame otherwise
+    static std::mutex reportedMutex;
+    static std::set<std::tuple<std::string, entt::id_type, bool>> reported;
+    {
+        std::scoped_lock<std::mutex> lock(reportedMutex);
+        if (!reported.emplace(Utils::t_CurrentSystem, type, write).second) return;
+    }
+    LOG_CORE_ERROR("{} {} {} without declaring it, its schedule may race", Utils::t_CurrentSystem,
+                   write ? "writes" : "reads", typeName);
+}
+
+SystemAccessScope::SystemAccessScope(const SystemAccess &access, const char *systemName)
+    : m_PreviousAccess(Utils::t_CurrentAccess), m_PreviousSystem(Utils::t_CurrentSystem)
+{
+    Utils::t_CurrentAccess = &access;
+    Utils::t_CurrentSystem = systemName;
+}
+
+SystemAccessScope::~SystemAccessScope()
+{
+    Utils::t_CurrentAccess = m_PreviousAccess;
+    Utils::t_CurrentSystem = m_PreviousSystem;
+}
+} // namespace Engine
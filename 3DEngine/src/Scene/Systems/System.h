@@ -1,14 +1,56 @@
 #pragma once
 
+#include <entt.hpp>
+
 #include <memory>
+#include <vector>
+
+// undeclared component access is reported in Debug builds
+#ifdef HZ_DEBUG
+#define ENGINE_CHECK_SYSTEM_ACCESS 1
+#endif
 
 namespace Engine
 {
 class Scene;
 
+// The component types a system reads and writes. Two systems whose sets don't conflict may run at the same time;
+// a system that declares nothing is treated as touching everything.
+struct SystemAccess
+{
+    std::vector<entt::id_type> Reads, Writes;
+    bool Declared = false;
+
+    bool CanRead(entt::id_type type) const;
+    bool CanWrite(entt::id_type type) const;
+    bool ConflictsWith(const SystemAccess &other) const;
+
+    // With ENGINE_CHECK_SYSTEM_ACCESS, Entity checks component access against the system the scheduler runs on
+    // the calling thread and logs what it didn't declare. Jobs a system spawns run unchecked.
+    static void Check(entt::id_type type, const char *typeName, bool write);
+};
+
+// marks the system running on this thread for SystemAccess::Check until it ends
+class SystemAccessScope
+{
+  public:
+    SystemAccessScope(const SystemAccess &access, const char *systemName);
+    ~SystemAccessScope();
+
+    SystemAccessScope(const SystemAccessScope &) = delete;
+    SystemAccessScope &operator=(const SystemAccessScope &) = delete;
+
+  private:
+    // a system waiting on jobs may run another system on the same thread
+    const SystemAccess *m_PreviousAccess;
+    const char *m_PreviousSystem;
+};
+
 class System
 {
   public:
+    virtual ~System() = default;
+
     virtual bool Init() { return true; }
 
     virtual void Draw() {}
@@ -18,8 +60,30 @@ class System
     virtual void EditorUpdate() {}
     virtual void Exit() {}
 
+    // shown in the profiler
+    virtual const char *GetName() const { return "System"; }
+
+    const SystemAccess &GetAccess() const { return m_Access; }
+
+  protected:
+    // called from the constructor of a system
+    template <typename... Components> void Reads()
+    {
+        (m_Access.Reads.push_back(entt::type_info<Components>::id()), ...);
+        m_Access.Declared = true;
+    }
+
+    template <typename... Components> void Writes()
+    {
+        (m_Access.Writes.push_back(entt::type_info<Components>::id()), ...);
+        m_Access.Declared = true;
+    }
+
   public:
     Scene *m_Scene;
+
+  private:
+    SystemAccess m_Access;
 };
 
 using SystemRef = std::shared_ptr<System>;
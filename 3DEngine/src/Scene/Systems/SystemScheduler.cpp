@@ -0,0 +1,92 @@
+#include "SystemScheduler.h"
+
+#include "JobSystem.h"
+#include "Profiler.h"
+
+#include <functional>
+
+namespace Engine
+{
+void SystemScheduler::Run(const std::vector<SystemRef> &systems, SystemPhase phase, float dt)
+{
+    const uint32_t count = systems.size();
+    if (count == 0) return;
+
+    if (count > m_Capacity)
+    {
+        m_Remaining = std::make_unique<std::atomic<uint32_t>[]>(count);
+        m_Capacity = count;
+    }
+    m_Dependents.resize(count);
+    for (auto &dependents : m_Dependents)
+        dependents.clear();
+
+#ifdef ENGINE_PROFILE
+    const char *phaseName = phase == SystemPhase::Update ? "Update" : "FixedUpdate";
+    std::vector<ProfileScheduleEntry> schedule(count);
+#endif
+
+    // only earlier systems are looked at, so conflicting ones run in the order they were added
+    std::vector<uint32_t> ready;
+    for (uint32_t j = 0; j < count; j++)
+    {
+        uint32_t dependencies = 0;
+        for (uint32_t i = 0; i < j; i++)
+        {
+            if (!systems[i]->GetAccess().ConflictsWith(systems[j]->GetAccess())) continue;
+
+            m_Dependents[i].push_back(j);
+            dependencies++;
+#ifdef ENGINE_PROFILE
+            schedule[j].DependsOn.push_back(systems[i]->GetName());
+#endif
+        }
+        m_Remaining[j].store(dependencies, std::memory_order_relaxed);
+        if (dependencies == 0) ready.push_back(j);
+    }
+
+    JobCounter done;
+    std::function<void(uint32_t)> launch = [&](uint32_t index)
+    {
+        JobSystem::Submit(
+            [&, index]
+            {
+                System &system = *systems[index];
+#ifdef ENGINE_PROFILE
+                const double start = Profiler::Now();
+#endif
+                {
+                    PROFILE_SCOPE(system.GetName());
+                    SystemAccessScope access(system.GetAccess(), system.GetName());
+                    if (phase == SystemPhase::Update)
+                        system.Update(dt);
+                    else
+                        system.FixedUpdate(dt);
+                }
+#ifdef ENGINE_PROFILE
+                auto &entry = schedule[index];
+                entry.Name = system.GetName();
+                entry.Phase = phaseName;
+                entry.Start = start;
+                entry.Duration = Profiler::Now() - start;
+                entry.ThreadId = Profiler::GetThreadId();
+#endif
+                // the last dependency to finish starts the dependent
+                for (uint32_t dependent : m_Dependents[index])
+                {
+                    if (m_Remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) launch(dependent);
+                }
+            },
+            &done);
+    };
+
+    // collected up front, a system that becomes ready while these are submitted is launched by its dependency
+    for (uint32_t index : ready)
+        launch(index);
+    JobSystem::Wait(done);
+
+#ifdef ENGINE_PROFILE
+    Profiler::RecordSchedule(std::move(schedule));
+#endif
+}
+} // namespace Engine
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "System.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+enum class SystemPhase
+{
+    Update,
+    FixedUpdate
+};
+
+// Runs the systems of a scene on the JobSystem. A system is ordered after every earlier system whose SystemAccess
+// conflicts with its own and starts as soon as those are done, so systems that don't share components run side by
+// side while the rest keep their registration order. Run returns once all of them finished.
+class SystemScheduler
+{
+  public:
+    void Run(const std::vector<SystemRef> &systems, SystemPhase phase, float dt);
+
+  private:
+    // the graph is rebuilt every run, the storage is kept
+    std::vector<std::vector<uint32_t>> m_Dependents;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_Remaining;
+    uint32_t m_Capacity = 0;
+};
+} // namespace Engine
@@ -1,31 +1,134 @@
 #include "TransformSystem.h"
 
 #include "Components.h"
+#include "Entity.h"
+#include "Log.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "TransformBatch.h"
+
+#include <atomic>
+#include <unordered_map>
 
 namespace Engine
 {
-TransformSystem::TransformSystem(Scene *scene) { m_Scene = scene; }
-
-void TransformSystem::Update(float dt) 
-{ 
-	auto view = m_Scene->GetRegistry().view<TransformComponent, ParentComponent>();
-	for (auto entity : view)
-	{
-		Entity ent = Entity{entity, m_Scene};
-		auto &transformComponent = ent.GetComponent<TransformComponent>();
-		auto &parentComponent = ent.GetComponent<ParentComponent>();
-
-		if (parentComponent.HasParent)
-		{
-			auto parent = m_Scene->GetEntityByUUID(parentComponent.Parent);
-			const auto &parentTransform = parent.GetComponent<TransformComponent>();
-
-			transformComponent.Translation = parentTransform.Translation + transformComponent.LocalTranslation;
-			transformComponent.Rotation = parentTransform.Rotation * transformComponent.LocalRotation;
-			transformComponent.Scale = parentTransform.Scale * transformComponent.LocalScale;
-
-            transformComponent.SetTransform(parentTransform.GetTransform() * transformComponent.GetLocalTransform());
-		}
-	}
+TransformSystem::TransformSystem(Scene *scene)
+{
+    m_Scene = scene;
+    Reads<ParentComponent>();
+    Writes<TransformComponent>();
+}
+
+void TransformSystem::Update(float dt)
+{
+    const bool rebuilt = m_HierarchyVersion != m_Scene->GetHierarchyVersion();
+    if (rebuilt) RebuildHierarchy();
+
+    auto &registry = m_Scene->m_Registry;
+
+    // a child changes with its parent, or when its own values were touched, in which case its world values are
+    // taken from the parent again like they always were
+    std::fill(m_Changed.begin(), m_Changed.end(), rebuilt);
+    for (size_t i = 0; i < m_Hierarchy.size(); i++)
+    {
+        const auto &node = m_Hierarchy[i];
+        auto &transform = registry.get<TransformComponent>(node.Entity);
+        if (node.Parent < 0)
+        {
+            m_Changed[i] |= transform.Dirty;
+            continue;
+        }
+
+        m_Changed[i] |= transform.Dirty || transform.LocalDirty || m_Changed[node.Parent];
+        // computed from the parent below rather than in the batch
+        if (m_Changed[i]) transform.Dirty = false;
+    }
+
+    // roots and entities outside the hierarchy
+    m_Scene->UpdateWorldMatrices();
+
+    // level 0 are the roots, done above
+    std::atomic<uint32_t> updated = 0;
+    for (size_t level = 1; level + 1 < m_Levels.size(); level++)
+    {
+        const size_t first = m_Levels[level];
+        JobSystem::ParallelFor(m_Levels[level + 1] - first, 256,
+                               [&](size_t begin, size_t end)
+                               {
+                                   uint32_t count = 0;
+                                   for (size_t i = first + begin; i < first + end; i++)
+                                   {
+                                       const auto &node = m_Hierarchy[i];
+                                       if (!m_Changed[i]) continue;
+
+                                       const auto &parent =
+                                           registry.get<TransformComponent>(m_Hierarchy[node.Parent].Entity);
+                                       auto &transform = registry.get<TransformComponent>(node.Entity);
+
+                                       const glm::mat4 world =
+                                           parent.WorldMatrix * Math::ComposeTransform(transform.LocalTranslation,
+                                                                                       transform.LocalRotation,
+                                                                                       transform.LocalScale);
+
+                                       // the world values follow for physics, the inspector and the serializer
+                                       transform.SetTransform(world);
+                                       transform.WorldMatrix = world;
+                                       transform.Dirty = false;
+                                       transform.LocalDirty = false;
+                                       count++;
+                                   }
+                                   updated += count;
+                               });
+    }
+    PROFILE_COUNTER("Hierarchy Updated", updated.load());
+}
+
+void TransformSystem::RebuildHierarchy()
+{
+    PROFILE_FUNCTION();
+    auto &registry = m_Scene->m_Registry;
+
+    // children by parent from each child's own link, a parent that is gone makes the child a root
+    std::unordered_map<entt::entity, std::vector<entt::entity>> children;
+    m_Hierarchy.clear();
+    m_Levels.clear();
+
+    size_t count = 0;
+    auto view = registry.view<ParentComponent, TransformComponent>();
+    for (auto entity : view)
+    {
+        count++;
+        const auto &parentComponent = view.get<ParentComponent>(entity);
+        const Entity parent = parentComponent.HasParent ? m_Scene->GetEntityByUUID(parentComponent.Parent) : Entity();
+
+        if (parent && (entt::entity)parent != entity)
+            children[(entt::entity)parent].push_back(entity);
+        else
+            m_Hierarchy.push_back({entity, -1});
+    }
+
+    // breadth first one level at a time, so every parent comes before its children
+    for (size_t levelStart = 0; levelStart < m_Hierarchy.size();)
+    {
+        m_Levels.push_back(levelStart);
+        const size_t levelEnd = m_Hierarchy.size();
+        for (size_t i = levelStart; i < levelEnd; i++)
+        {
+            auto it = children.find(m_Hierarchy[i].Entity);
+            if (it == children.end()) continue;
+
+            for (auto child : it->second)
+                m_Hierarchy.push_back({child, (int32_t)i});
+        }
+        levelStart = levelEnd;
+    }
+    m_Levels.push_back(m_Hierarchy.size());
+
+    if (m_Hierarchy.size() < count)
+        LOG_CORE_WARN("TransformSystem: {} entities are part of a parent cycle and won't be updated",
+                      count - m_Hierarchy.size());
+
+    m_Changed.resize(m_Hierarchy.size());
+    m_HierarchyVersion = m_Scene->GetHierarchyVersion();
 }
 } // namespace Engine
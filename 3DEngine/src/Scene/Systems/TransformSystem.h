@@ -2,13 +2,40 @@
 
 #include "System.h"
 
+#include <entt.hpp>
+
+#include <cstdint>
+#include <vector>
+
 namespace Engine
 {
+// Keeps the hierarchy as a flat array with parents before their children and parent indices instead of UUIDs,
+// rebuilt only when Scene::GetHierarchyVersion() moves. A frame recomputes the subtrees under a dirty transform
+// and nothing else, one depth after the other with the nodes of a depth spread over the job system.
 class TransformSystem : public System
 {
   public:
     TransformSystem(Scene *scene);
 
     void Update(float dt) override;
+
+    const char *GetName() const override { return "TransformSystem"; }
+
+  private:
+    void RebuildHierarchy();
+
+  private:
+    struct HierarchyNode
+    {
+        entt::entity Entity;
+        // index into m_Hierarchy, -1 for roots
+        int32_t Parent;
+    };
+
+    std::vector<HierarchyNode> m_Hierarchy;
+    // where each depth starts in m_Hierarchy, plus its end; a level only reads the one before it
+    std::vector<size_t> m_Levels;
+    std::vector<uint8_t> m_Changed;
+    uint64_t m_HierarchyVersion = 0;
 };
 } // namespace Engine
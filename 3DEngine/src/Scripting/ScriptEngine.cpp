@@ -6,8 +6,9 @@
 
 #include <glm/glm.hpp>
 
-#include <fstream>
+#include "FileMapping.h"
 #include "Log.h"
+#include "MemoryTracker.h"
 #include "Components.h"
 #include "Project.h"
 #include "Application.h"
@@ -40,39 +41,17 @@ static std::unordered_map<std::string, ScriptFieldType> s_ScriptFieldTypeMap = {
 
 namespace Utils
 {
-static char *ReadBytes(const std::filesystem::path &filepath, uint32_t *outSize)
-{
-    std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
-
-    if (!stream)
-    {
-        // Failed to open the file
-        return nullptr;
-    }
-
-    std::streampos end = stream.tellg();
-    stream.seekg(0, std::ios::beg);
-    uint32_t size = end - stream.tellg();
-
-    if (size == 0) return nullptr;
-
-    char *buffer = new char[size];
-    stream.read((char *)buffer, size);
-    stream.close();
-
-    *outSize = size;
-    return buffer;
-}
-
 static MonoAssembly *LoadMonoAssembly(const std::filesystem::path &assemblyPath)
 {
-    uint32_t fileSize = 0;
-    char *fileData = ReadBytes(assemblyPath, &fileSize);
+    FileMapping file(assemblyPath);
+    if (!file || file.GetSize() == 0) return nullptr;
 
     // NOTE: We can't use this image for anything other than loading the assembly because this image doesn't have a
     // reference to the assembly
+    // mono keeps its own copy of the image (need_copy), so the mapping may go away afterwards
     MonoImageOpenStatus status;
-    MonoImage *image = mono_image_open_from_data_full(fileData, fileSize, 1, &status, 0);
+    MonoImage *image =
+        mono_image_open_from_data_full((char *)file.GetData(), (uint32_t)file.GetSize(), 1, &status, 0);
 
     if (status != MONO_IMAGE_OK)
     {
@@ -84,9 +63,6 @@ static MonoAssembly *LoadMonoAssembly(const std::filesystem::path &assemblyPath)
     MonoAssembly *assembly = mono_assembly_load_from_full(image, assemblyPath.string().c_str(), &status, 0);
     mono_image_close(image);
 
-    // Don't forget to free the file data
-    delete[] fileData;
-
     return assembly;
 }
 
@@ -169,6 +145,7 @@ static void OnAppAssemblyFileSystemEvent(const std::string &path, const filewatc
 
 void ScriptEngine::Init() 
 {
+    MEMORY_TAG(Scripting);
 	s_Data = new ScriptEngineData();
 
 	InitMono();
@@ -259,6 +236,7 @@ Scene *ScriptEngine::GetSceneContext() { return s_Data->SceneContext; }
 
 void ScriptEngine::ReloadAssembly()
 {
+    MEMORY_TAG(Scripting);
     mono_domain_set(mono_get_root_domain(), false);
 
     mono_domain_unload(s_Data->AppDomain);
@@ -291,6 +269,7 @@ bool ScriptEngine::EntityClassExists(const std::string &fullClassName)
 
 void ScriptEngine::OnCreateEntity(Entity entity) 
 {
+    MEMORY_TAG(Scripting);
     const auto &sc = entity.GetComponent<ScriptComponent>();
     if (ScriptEngine::EntityClassExists(sc.ClassName))
     {
@@ -313,6 +292,7 @@ void ScriptEngine::OnCreateEntity(Entity entity)
 
 void ScriptEngine::OnUpdateEntity(Entity entity, float dt) 
 {
+    MEMORY_TAG(Scripting);
     UUID entityUUID = entity.GetComponent<IDComponent>().ID;
     if (s_Data->EntityInstances.find(entityUUID) != s_Data->EntityInstances.end())
     {
@@ -4,6 +4,7 @@
 #include <mono/metadata/reflection.h>
 #include <glm/glm.hpp>
 
+#include "Allocators.h"
 #include "Log.h"
 #include "UUID.h"
 #include "AllComponents.h"
@@ -16,11 +17,52 @@ namespace Engine
 
 static std::unordered_map<MonoType *, std::function<bool(Entity)>> s_EntityHasComponentFuncs;
 
+namespace Utils
+{
+// a managed string as UTF-8 in the frame arena, without the heap allocation of mono_string_to_utf8
+static std::string_view MonoStringToFrameString(MonoString *string)
+{
+    const mono_unichar2 *chars = mono_string_chars(string);
+    const int32_t length = mono_string_length(string);
+
+    // a UTF-16 unit takes at most 3 bytes, a surrogate pair 4
+    auto *out = static_cast<char *>(FrameArena::Allocate(length * 3 + 1, 1));
+    size_t size = 0;
+    for (int32_t i = 0; i < length; i++)
+    {
+        uint32_t c = chars[i];
+        if (c >= 0xD800 && c < 0xDC00 && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] < 0xE000)
+            c = 0x10000 + ((c - 0xD800) << 10) + (chars[++i] - 0xDC00);
+
+        if (c < 0x80)
+            out[size++] = (char)c;
+        else if (c < 0x800)
+        {
+            out[size++] = (char)(0xC0 | (c >> 6));
+            out[size++] = (char)(0x80 | (c & 0x3F));
+        }
+        else if (c < 0x10000)
+        {
+            out[size++] = (char)(0xE0 | (c >> 12));
+            out[size++] = (char)(0x80 | ((c >> 6) & 0x3F));
+            out[size++] = (char)(0x80 | (c & 0x3F));
+        }
+        else
+        {
+            out[size++] = (char)(0xF0 | (c >> 18));
+            out[size++] = (char)(0x80 | ((c >> 12) & 0x3F));
+            out[size++] = (char)(0x80 | ((c >> 6) & 0x3F));
+            out[size++] = (char)(0x80 | (c & 0x3F));
+        }
+    }
+    out[size] = '\0';
+    return std::string_view(out, size);
+}
+} // namespace Utils
+
 static void NativeLog(MonoString *string, int parameter)
 {
-    char *str = mono_string_to_utf8(string);
-    LOG_CORE_TRACE("{}, {}", str, parameter);
-    mono_free(str);
+    LOG_CORE_TRACE("{}, {}", Utils::MonoStringToFrameString(string), parameter);
 }
 
 static void NativeLog_Vector(glm::vec3 *parameter, glm::vec3 *out)
@@ -43,12 +85,9 @@ static bool Entity_HasComponent(UUID entityID, MonoReflectionType *componentType
 
 static uint64_t Entity_FindEntityByName(MonoString *name)
 {
-    char *nameCStr = mono_string_to_utf8(name);
-
     Scene *scene = ScriptEngine::GetSceneContext();
     assert(scene);
-    Entity entity = scene->FindEntityByName(nameCStr);
-    mono_free(nameCStr);
+    Entity entity = scene->FindEntityByName(Utils::MonoStringToFrameString(name));
 
     if (!entity) return 0;
 
@@ -72,7 +111,12 @@ static void TransformComponent_SetTranslation(UUID entityID, glm::vec3 *translat
     Entity entity = scene->GetEntityByUUID(entityID);
 	assert(entity);
 
-    entity.GetComponent<TransformComponent>().Translation = *translation;
+    entity.PatchComponent<TransformComponent>(
+        [translation](auto &transform)
+        {
+            transform.Translation = *translation;
+            transform.MarkDirty();
+        });
 }
 
 static bool Input_IsKeyDown(int keycode)
@@ -0,0 +1,57 @@
+project "Benchmark"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++20"
+	staticruntime "off"
+
+	targetdir ("%{wks.location}/bin/" .. outputdir .. "/%{prj.name}")
+	objdir ("%{wks.location}/bin-int/" .. outputdir .. "/%{prj.name}")
+
+	-- shaders and the sandbox project are loaded relative to the working directory
+	debugdir "%{wks.location}/Sandbox"
+
+	files
+	{
+		"src/**.h",
+		"src/**.cpp"
+	}
+
+	includedirs
+	{
+		"%{wks.location}/3DEngine/vendor/spdlog/include",
+		"%{wks.location}/3DEngine/vendor/imgui",
+		"%{wks.location}/3DEngine/src",
+		"%{wks.location}/3DEngine/src/**",
+		"%{wks.location}/3DEngine/vendor",
+		"%{IncludeDir.glm}",
+		"%{IncludeDir.filewatch}",
+		"%{IncludeDir.entt}",
+		"%{IncludeDir.ImGuizmo}",
+		"%{IncludeDir.yaml_cpp}",
+		"%{IncludeDir.JoltPhysics}",
+		"%{IncludeDir.GLFW}",
+		"%{IncludeDir.Glad}"
+	}
+
+	links
+	{
+		"3DEngine"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+
+	filter "configurations:Debug"
+		defines "HZ_DEBUG"
+		runtime "Debug"
+		symbols "on"
+
+	filter "configurations:Release"
+		defines "HZ_RELEASE"
+		runtime "Release"
+		optimize "on"
+
+	filter "configurations:Dist"
+		defines "HZ_DIST"
+		runtime "Release"
+		optimize "on"
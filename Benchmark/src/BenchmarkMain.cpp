@@ -0,0 +1,278 @@
+#include "BenchmarkReport.h"
+#include "StressScene.h"
+#include "TransformMicrobenchmark.h"
+
+#include "Allocators.h"
+#include "EditorCamera.h"
+#include "Framebuffer.h"
+#include "JobSystem.h"
+#include "Log.h"
+#include "MemoryTracker.h"
+#include "PhysicsManager.h"
+#include "Profiler.h"
+#include "Project.h"
+#include "RenderCommand.h"
+#include "RendererAPI.h"
+#include "RenderThread.h"
+#include "Scene.h"
+#include "Texture2D.h"
+#include "VirtualFileSystem.h"
+#include "Window.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+namespace Engine
+{
+struct BenchmarkOptions
+{
+    StressSceneConfig Scene;
+    uint32_t Frames = 300;
+    uint32_t WarmupFrames = 30;
+    bool UseOpenGL = false;
+    // render on a RenderThread, 0 renders inline
+    uint32_t FrameLatency = 0;
+    // runs an isolated kernel instead of a scene when set
+    std::string Microbenchmark;
+
+    std::filesystem::path Project = "SandboxProject/SandboxProject.3dproj";
+    std::filesystem::path Output = "benchmark.json";
+    std::filesystem::path Baseline;
+    std::filesystem::path Trace;
+    double Tolerance = 0.1;
+};
+
+namespace Utils
+{
+static bool ReadOption(const char *argument, const char *name, std::string &value)
+{
+    const size_t length = std::strlen(name);
+    if (std::strncmp(argument, name, length) != 0 || argument[length] != '=') return false;
+
+    value = argument + length + 1;
+    return true;
+}
+
+static bool ParseOptions(int argc, char **argv, BenchmarkOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        std::string value;
+        const char *argument = argv[i];
+        if (ReadOption(argument, "--entities", value))
+            options.Scene.MeshEntities = std::stoul(value);
+        else if (ReadOption(argument, "--depth", value))
+            options.Scene.HierarchyDepth = std::stoul(value);
+        else if (ReadOption(argument, "--lights", value))
+        {
+            // split evenly between point and spot lights
+            const uint32_t lights = std::stoul(value);
+            options.Scene.PointLights = lights - lights / 2;
+            options.Scene.SpotLights = lights / 2;
+        }
+        else if (ReadOption(argument, "--bodies", value))
+            options.Scene.RigidBodies = std::stoul(value);
+        else if (ReadOption(argument, "--seed", value))
+            options.Scene.Seed = std::stoul(value);
+        else if (ReadOption(argument, "--frames", value))
+            options.Frames = std::stoul(value);
+        else if (ReadOption(argument, "--warmup", value))
+            options.WarmupFrames = std::stoul(value);
+        else if (ReadOption(argument, "--renderer", value) && (value == "null" || value == "opengl"))
+            options.UseOpenGL = value == "opengl";
+        else if (std::strcmp(argument, "--pipelined") == 0)
+            options.FrameLatency = std::max(options.FrameLatency, 1u);
+        else if (ReadOption(argument, "--frame-latency", value))
+            options.FrameLatency = std::clamp((uint32_t)std::stoul(value), 1u, 2u);
+        else if (ReadOption(argument, "--project", value))
+            options.Project = value;
+        else if (ReadOption(argument, "--output", value))
+            options.Output = value;
+        else if (ReadOption(argument, "--baseline", value))
+            options.Baseline = value;
+        else if (ReadOption(argument, "--tolerance", value))
+            options.Tolerance = std::stod(value);
+        else if (ReadOption(argument, "--trace", value))
+            options.Trace = value;
+        else if (ReadOption(argument, "--microbench", value) && value == "transforms")
+            options.Microbenchmark = value;
+        else
+        {
+            std::cerr << "unknown option " << argument << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+static void PrintUsage()
+{
+    std::cerr << "Benchmark [options]\n"
+                 "  --entities=N     mesh entities (1000)\n"
+                 "  --depth=D        hierarchy depth, 1 is flat (1)\n"
+                 "  --lights=L       point + spot lights (16)\n"
+                 "  --bodies=B       dynamic rigid bodies (100)\n"
+                 "  --seed=S         random seed (1)\n"
+                 "  --frames=F       measured frames (300)\n"
+                 "  --warmup=W       frames run before measuring (30)\n"
+                 "  --renderer=null|opengl\n"
+                 "  --pipelined      render frame N on a render thread while frame N+1 updates\n"
+                 "  --frame-latency=1|2\n"
+                 "                   frames the update may run ahead when pipelined, implies it (1)\n"
+                 "  --project=PATH   project providing the asset manager\n"
+                 "  --output=PATH    results (benchmark.json)\n"
+                 "  --baseline=PATH  earlier results to compare with, exits with 1 on a regression\n"
+                 "  --tolerance=T    allowed median slowdown per stage (0.1 = 10%)\n"
+                 "  --trace=PATH     also write a Chrome trace of the measured frames\n"
+                 "  --microbench=transforms\n"
+                 "                   world matrices of --entities transforms, glm against the SIMD batch,\n"
+                 "                   --frames times\n";
+}
+} // namespace Utils
+
+static int RunMicrobenchmark(const BenchmarkOptions &options)
+{
+    Log::Init();
+
+    BenchmarkReport report;
+    TransformMicrobenchmark::Run(options.Scene.MeshEntities, options.Frames, report);
+    report.RecordMemory();
+
+    if (!report.Write(options.Output)) return EXIT_FAILURE;
+    if (!options.Baseline.empty() && !report.CompareWithBaseline(options.Baseline, options.Tolerance))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+
+// Runs a generated scene for a fixed number of frames at a fixed time step, timing update, fixed update and
+// rendering separately. With the null renderer no window or GPU is needed, so the numbers are the CPU cost alone.
+static int RunBenchmark(const BenchmarkOptions &options)
+{
+    constexpr float deltaTime = 1.0f / 60.0f;
+    constexpr float fixedTime = 1.0f / 90.0f;
+    const glm::vec2 viewportSize(1280.0f, 720.0f);
+
+    Log::Init();
+    Profiler::SetThreadName("Main");
+    JobSystem::Init();
+    VirtualFileSystem::Init();
+
+    RendererAPI::SetAPI(options.UseOpenGL ? RendererAPI::API::OpenGL : RendererAPI::API::Null);
+    // only the OpenGL backend needs a context, and so a window
+    std::shared_ptr<Window> window;
+    if (options.UseOpenGL) window = std::make_shared<Window>(WindowProps("Benchmark", viewportSize.x, viewportSize.y));
+    RenderCommand::Init();
+
+    if (!Project::Load(options.Project))
+    {
+        LOG_ERROR("Benchmark: could not load project '{}'", options.Project.string());
+        return EXIT_FAILURE;
+    }
+
+    auto framebuffer = std::make_shared<Framebuffer>(true, viewportSize);
+    framebuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::Depth), GL_DEPTH_ATTACHMENT);
+    framebuffer->SetTexture(std::make_shared<Texture2D>(ImageFormat::RGBA8), GL_COLOR_ATTACHMENT0);
+
+    auto scene = std::make_shared<Scene>();
+    StressScene::Generate(*scene, options.Scene);
+    scene->SetViewportSize(viewportSize.x, viewportSize.y);
+    scene->SetFramebuffer(framebuffer);
+    scene->OnAttach();
+    scene->OnRuntimeStart();
+
+    EditorCamera camera(45.0f, viewportSize.x / viewportSize.y, 0.1f, 1000.0f);
+    camera.SetViewportSize(viewportSize.x, viewportSize.y);
+
+    BenchmarkReport report;
+    report.SetConfig("Entities", options.Scene.MeshEntities);
+    report.SetConfig("HierarchyDepth", options.Scene.HierarchyDepth);
+    report.SetConfig("PointLights", options.Scene.PointLights);
+    report.SetConfig("SpotLights", options.Scene.SpotLights);
+    report.SetConfig("RigidBodies", options.Scene.RigidBodies);
+    report.SetConfig("Seed", options.Scene.Seed);
+    report.SetConfig("Frames", options.Frames);
+    report.SetConfig("Renderer", RendererAPIToString(RendererAPI::GetAPI()));
+    report.SetConfig("FrameLatency", options.FrameLatency);
+
+    LOG_INFO("Benchmark: {} entities, depth {}, {} lights, {} bodies, {} frames", options.Scene.MeshEntities,
+             options.Scene.HierarchyDepth, options.Scene.PointLights + options.Scene.SpotLights,
+             options.Scene.RigidBodies, options.Frames);
+
+    // set up on this thread, from here on the context belongs to the render thread
+    if (options.FrameLatency > 0)
+    {
+        RenderThread::Start(window ? window->GetNativeWindow() : nullptr, options.FrameLatency);
+        FrameArena::SetFrameCount(RenderThread::GetFrameLatency() + 1);
+    }
+
+    for (uint32_t frame = 0; frame < options.WarmupFrames + options.Frames; frame++)
+    {
+        const bool measured = frame >= options.WarmupFrames;
+        if (frame == options.WarmupFrames && !options.Trace.empty()) Profiler::BeginCapture();
+
+        Profiler::BeginFrame();
+        const double start = Profiler::Now();
+        scene->OnUpdate(deltaTime);
+        const double updated = Profiler::Now();
+        scene->OnFixedUpdate(fixedTime);
+        const double simulated = Profiler::Now();
+        scene->OnUpdateEditor(deltaTime, camera);
+        // the null backend's recording would otherwise grow over the whole run
+        RenderThread::Submit([] { RenderCommand::EndFrame(); });
+        const double rendered = Profiler::Now();
+        // blocks while the render thread is more than the latency behind
+        RenderThread::EndFrame(false);
+        const double ended = Profiler::Now();
+        AllocatorStats::ReportFrame();
+        MemoryTracker::ReportFrame();
+        FrameArena::EndFrame();
+        Profiler::EndFrame();
+
+        if (!measured) continue;
+        report.RecordStage("Scene::OnUpdate", (updated - start) / 1000.0);
+        report.RecordStage("Scene::OnFixedUpdate", (simulated - updated) / 1000.0);
+        // only the snapshot when pipelined
+        report.RecordStage("Render", (rendered - simulated) / 1000.0);
+        report.RecordStage("Frame", (ended - start) / 1000.0);
+        report.RecordProfileFrame(Profiler::GetLastFrame());
+    }
+
+    if (!options.Trace.empty())
+    {
+        Profiler::EndCapture();
+        Profiler::WriteChromeTrace(options.Trace);
+    }
+
+    RenderThread::Stop();
+    // while the scene and its GPU resources are still alive
+    report.RecordMemory();
+    scene->OnRuntimeStop();
+    scene->OnDetach();
+
+    if (!report.Write(options.Output)) return EXIT_FAILURE;
+    if (!options.Baseline.empty() && !report.CompareWithBaseline(options.Baseline, options.Tolerance))
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
+} // namespace Engine
+
+int main(int argc, char **argv)
+{
+    Engine::BenchmarkOptions options;
+    if (!Engine::Utils::ParseOptions(argc, argv, options))
+    {
+        Engine::Utils::PrintUsage();
+        return 2;
+    }
+
+    const int result =
+        options.Microbenchmark.empty() ? Engine::RunBenchmark(options) : Engine::RunMicrobenchmark(options);
+    // the workers and the log thread must be joined before static destruction
+    Engine::VirtualFileSystem::Shutdown();
+    Engine::JobSystem::Shutdown();
+    Engine::Log::Shutdown();
+    return result;
+}
@@ -0,0 +1,205 @@
+#include "BenchmarkReport.h"
+
+#include "Log.h"
+#include "Profiler.h"
+
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace Engine
+{
+namespace Utils
+{
+static std::string QuoteJSON(const std::string &text)
+{
+    std::string result = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\') result += '\\';
+        result += c;
+    }
+    return result + "\"";
+}
+
+static std::string FormatNumber(double value)
+{
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+} // namespace Utils
+
+void BenchmarkReport::SetConfig(const std::string &key, double value)
+{
+    m_Config.push_back({key, Utils::FormatNumber(value), false});
+}
+
+void BenchmarkReport::SetConfig(const std::string &key, const std::string &value)
+{
+    m_Config.push_back({key, value, true});
+}
+
+void BenchmarkReport::RecordStage(const std::string &stage, double milliseconds)
+{
+    auto it = std::find_if(m_Stages.begin(), m_Stages.end(), [&](const auto &entry) { return entry.first == stage; });
+    if (it == m_Stages.end()) it = m_Stages.emplace(m_Stages.end(), stage, std::vector<double>());
+    it->second.push_back(milliseconds);
+}
+
+void BenchmarkReport::RecordProfileFrame(const ProfileFrame &frame)
+{
+    // a scope that runs several times a frame counts with its total
+    for (const auto &event : frame.Events)
+        m_ScopeTotals[event.Name] += event.Duration / 1000.0;
+    for (const auto &counter : frame.Counters)
+        m_CounterTotals[counter.Name] += counter.Value;
+    m_ProfileFrames++;
+}
+
+void BenchmarkReport::RecordMemory()
+{
+    m_Memory.clear();
+    m_Memory.emplace_back("Heap", MemoryTracker::GetTotalStats());
+    for (size_t i = 0; i < (size_t)MemoryTag::Count; i++)
+        m_Memory.emplace_back(MemoryTracker::GetTagName((MemoryTag)i), MemoryTracker::GetStats((MemoryTag)i));
+    for (size_t i = 0; i < (size_t)GPUMemoryType::Count; i++)
+    {
+        const auto type = (GPUMemoryType)i;
+        m_Memory.emplace_back(std::string("GPU ") + MemoryTracker::GetGPUTypeName(type),
+                              MemoryTracker::GetGPUStats(type));
+    }
+}
+
+StageStatistics BenchmarkReport::ComputeStatistics(std::vector<double> samples)
+{
+    StageStatistics statistics;
+    if (samples.empty()) return statistics;
+
+    std::sort(samples.begin(), samples.end());
+    auto percentile = [&](double p) { return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))]; };
+
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += sample;
+
+    statistics.Mean = sum / samples.size();
+    statistics.Median = percentile(0.5);
+    statistics.P95 = percentile(0.95);
+    statistics.Min = samples.front();
+    statistics.Max = samples.back();
+    return statistics;
+}
+
+bool BenchmarkReport::Write(const std::filesystem::path &path) const
+{
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path());
+
+    std::ofstream stream(path);
+    if (!stream)
+    {
+        LOG_ERROR("Benchmark: could not write '{}'", path.string());
+        return false;
+    }
+
+    stream << std::fixed << std::setprecision(4);
+    stream << "{\n  \"Config\": {";
+    for (size_t i = 0; i < m_Config.size(); i++)
+    {
+        const auto &entry = m_Config[i];
+        stream << (i ? ",\n    " : "\n    ") << Utils::QuoteJSON(entry.Key) << ": "
+               << (entry.IsString ? Utils::QuoteJSON(entry.Value) : entry.Value);
+    }
+
+    stream << "\n  },\n  \"Stages\": {";
+    for (size_t i = 0; i < m_Stages.size(); i++)
+    {
+        const auto &[name, samples] = m_Stages[i];
+        const StageStatistics statistics = ComputeStatistics(samples);
+        stream << (i ? ",\n    " : "\n    ") << Utils::QuoteJSON(name) << ": {\"Mean\": " << statistics.Mean
+               << ", \"Median\": " << statistics.Median << ", \"P95\": " << statistics.P95
+               << ", \"Min\": " << statistics.Min << ", \"Max\": " << statistics.Max << "}";
+    }
+
+    const double frames = std::max(m_ProfileFrames, 1u);
+    auto writeAverages = [&](const std::map<std::string, double> &totals)
+    {
+        bool first = true;
+        for (const auto &[name, total] : totals)
+        {
+            stream << (first ? "\n    " : ",\n    ") << Utils::QuoteJSON(name) << ": " << total / frames;
+            first = false;
+        }
+    };
+
+    stream << "\n  },\n  \"Scopes\": {";
+    writeAverages(m_ScopeTotals);
+    stream << "\n  },\n  \"Counters\": {";
+    writeAverages(m_CounterTotals);
+
+    // bytes
+    stream << "\n  },\n  \"Memory\": {";
+    for (size_t i = 0; i < m_Memory.size(); i++)
+    {
+        const auto &[name, stats] = m_Memory[i];
+        stream << (i ? ",\n    " : "\n    ") << Utils::QuoteJSON(name) << ": {\"Current\": " << stats.Current
+               << ", \"Peak\": " << stats.Peak << ", \"Allocations\": " << stats.Allocations << "}";
+    }
+    stream << "\n  }\n}\n";
+
+    LOG_INFO("Benchmark: wrote '{}'", path.string());
+    return true;
+}
+
+bool BenchmarkReport::CompareWithBaseline(const std::filesystem::path &path, double tolerance) const
+{
+    // JSON is valid YAML, so the baseline is read back with yaml-cpp like every other file of the engine
+    YAML::Node baseline;
+    try
+    {
+        baseline = YAML::LoadFile(path.string());
+    }
+    catch (const YAML::Exception &e)
+    {
+        LOG_ERROR("Benchmark: failed to load baseline '{}'\n     {}", path.string(), e.what());
+        return false;
+    }
+
+    bool passed = true;
+    for (const auto &entry : m_Config)
+    {
+        auto node = baseline["Config"][entry.Key];
+        if (node && node.as<std::string>() == entry.Value) continue;
+
+        LOG_ERROR("Benchmark: baseline was recorded with {} = {}, this run used {}", entry.Key,
+                  node ? node.as<std::string>() : "<missing>", entry.Value);
+        passed = false;
+    }
+    if (!passed) return false;
+
+    for (const auto &[name, samples] : m_Stages)
+    {
+        auto node = baseline["Stages"][name]["Median"];
+        if (!node)
+        {
+            LOG_WARN("Benchmark: {} is not in the baseline", name);
+            continue;
+        }
+
+        const double before = node.as<double>();
+        const double after = ComputeStatistics(samples).Median;
+        const double change = before > 0.0 ? after / before - 1.0 : 0.0;
+        if (change > tolerance)
+        {
+            LOG_ERROR("Benchmark: {} regressed {:.3f} ms -> {:.3f} ms ({:+.1f}%)", name, before, after, change * 100.0);
+            passed = false;
+        }
+        else
+            LOG_INFO("Benchmark: {} {:.3f} ms -> {:.3f} ms ({:+.1f}%)", name, before, after, change * 100.0);
+    }
+    return passed;
+}
+} // namespace Engine
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "MemoryTracker.h"
+
+#include <filesystem>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+struct ProfileFrame;
+
+// milliseconds
+struct StageStatistics
+{
+    double Mean = 0.0;
+    double Median = 0.0;
+    double P95 = 0.0;
+    double Min = 0.0;
+    double Max = 0.0;
+};
+
+// Per-frame timings of the benchmark stages, written as JSON and compared against an earlier run of the same
+// configuration. Besides the stages it averages every profiler scope and counter, which points at the culprit
+// when a stage regresses.
+class BenchmarkReport
+{
+  public:
+    void SetConfig(const std::string &key, double value);
+    void SetConfig(const std::string &key, const std::string &value);
+
+    void RecordStage(const std::string &stage, double milliseconds);
+    void RecordProfileFrame(const ProfileFrame &frame);
+    // current, peak and live allocations of the memory tracker at this point of the run
+    void RecordMemory();
+
+    bool Write(const std::filesystem::path &path) const;
+
+    // Logs each stage against the baseline file. False when the median of a stage grew by more than tolerance
+    // (0.1 = 10%) or the baseline can't be read.
+    bool CompareWithBaseline(const std::filesystem::path &path, double tolerance) const;
+
+  private:
+    static StageStatistics ComputeStatistics(std::vector<double> samples);
+
+  private:
+    struct ConfigEntry
+    {
+        std::string Key, Value;
+        bool IsString;
+    };
+
+    std::vector<ConfigEntry> m_Config;
+    std::vector<std::pair<std::string, std::vector<double>>> m_Stages;
+
+    std::map<std::string, double> m_ScopeTotals;
+    std::map<std::string, double> m_CounterTotals;
+    uint32_t m_ProfileFrames = 0;
+
+    std::vector<std::pair<std::string, MemoryStats>> m_Memory;
+};
+} // namespace Engine
@@ -0,0 +1,130 @@
+#include "StressScene.h"
+
+#include "Components.h"
+#include "PhysicsComponents.h"
+#include "Entity.h"
+#include "Material.h"
+#include "Project.h"
+#include "Scene.h"
+
+#include <cmath>
+#include <random>
+#include <string>
+
+namespace Engine
+{
+void StressScene::Generate(Scene &scene, const StressSceneConfig &config)
+{
+    std::mt19937 random(config.Seed);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    auto material = std::make_shared<Material>();
+    material->Init("Stress", glm::vec3(0.8f), 1.0f, glm::vec3(0.0f, 0.0f, 1.0f), 0.0f, 0.5f);
+    const AssetHandle materialHandle = Project::GetActive()->GetEditorAssetManager()->AddAsset(material);
+    const ModelRef cube = CreateCube(materialHandle);
+
+    // chains of HierarchyDepth entities, the roots spread over a square grid
+    const uint32_t depth = std::max(config.HierarchyDepth, 1u);
+    const uint32_t chains = (config.MeshEntities + depth - 1) / depth;
+    const uint32_t gridSize = std::max(1u, (uint32_t)std::ceil(std::sqrt((float)chains)));
+    const float spacing = 3.0f;
+
+    Entity parent;
+    for (uint32_t i = 0; i < config.MeshEntities; i++)
+    {
+        Entity entity = scene.CreateEntity("Mesh " + std::to_string(i));
+        entity.AddComponent<MeshComponent>().ModelResource = cube;
+
+        auto &transform = entity.GetComponent<TransformComponent>();
+        transform.Rotation = glm::vec3(unit(random), unit(random), unit(random));
+        if (i % depth == 0)
+        {
+            const uint32_t chain = i / depth;
+            transform.Translation = glm::vec3((chain % gridSize - gridSize * 0.5f) * spacing, 0.0f,
+                                              (chain / gridSize - gridSize * 0.5f) * spacing);
+        }
+        else
+        {
+            transform.LocalTranslation = glm::vec3(0.0f, 1.0f, 0.0f);
+            transform.LocalRotation = glm::vec3(0.0f, 0.2f, 0.0f);
+            transform.LocalScale = glm::vec3(0.9f);
+            parent.AddChild(entity);
+        }
+        parent = entity;
+    }
+
+    const float extent = gridSize * spacing * 0.5f;
+    for (uint32_t i = 0; i < config.PointLights; i++)
+    {
+        Entity entity = scene.CreateEntity("Point Light " + std::to_string(i));
+        auto &light = entity.AddComponent<PointLightComponent>();
+        light.Index = i;
+        light.Light.Position = glm::vec3(unit(random) * extent, 2.0f, unit(random) * extent);
+        light.Light.Color = glm::vec3(0.5f) + 0.5f * glm::abs(glm::vec3(unit(random), unit(random), unit(random)));
+        light.Light.Intensity = 5.0f;
+    }
+
+    for (uint32_t i = 0; i < config.SpotLights; i++)
+    {
+        Entity entity = scene.CreateEntity("Spot Light " + std::to_string(i));
+        auto &light = entity.AddComponent<SpotLightComponent>();
+        light.Index = i;
+        light.Light.Position = glm::vec3(unit(random) * extent, 5.0f, unit(random) * extent);
+        light.Light.Direction = glm::vec3(0.0f, -1.0f, 0.0f);
+        light.Light.Color = glm::vec3(1.0f);
+        light.Light.Intensity = 5.0f;
+    }
+
+    if (config.RigidBodies == 0) return;
+
+    // a static floor under a stack of falling boxes, away from the mesh grid
+    const glm::vec3 origin(0.0f, 0.0f, extent + 20.0f);
+    Entity floor = scene.CreateEntity("Floor");
+    floor.AddComponent<MeshComponent>().ModelResource = cube;
+    floor.GetComponent<TransformComponent>().Translation = origin - glm::vec3(0.0f, 1.0f, 0.0f);
+    floor.GetComponent<TransformComponent>().Scale = glm::vec3(40.0f, 1.0f, 40.0f);
+    floor.AddComponent<BoxColliderComponent>();
+    floor.AddComponent<RigidBodyComponent>().MotionType = Physics::MotionType::Static;
+
+    const uint32_t layerSize = 8;
+    for (uint32_t i = 0; i < config.RigidBodies; i++)
+    {
+        Entity entity = scene.CreateEntity("Rigid Body " + std::to_string(i));
+        entity.AddComponent<MeshComponent>().ModelResource = cube;
+
+        const uint32_t layer = i / (layerSize * layerSize), cell = i % (layerSize * layerSize);
+        auto &transform = entity.GetComponent<TransformComponent>();
+        transform.Translation = origin + glm::vec3((cell % layerSize - layerSize * 0.5f) * 1.5f, 2.0f + layer * 1.5f,
+                                                   (cell / layerSize - layerSize * 0.5f) * 1.5f);
+        transform.Rotation = glm::vec3(unit(random), unit(random), unit(random));
+
+        entity.AddComponent<BoxColliderComponent>();
+        entity.AddComponent<RigidBodyComponent>().MotionType = Physics::MotionType::Dynamic;
+    }
+}
+
+ModelRef StressScene::CreateCube(AssetHandle material)
+{
+    const glm::vec3 normals[6] = {{1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1}};
+    const glm::vec3 tangents[6] = {{0, 0, -1}, {0, 0, 1}, {1, 0, 0}, {1, 0, 0}, {1, 0, 0}, {-1, 0, 0}};
+    const glm::vec2 corners[4] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    for (int face = 0; face < 6; face++)
+    {
+        const glm::vec3 bitangent = glm::cross(normals[face], tangents[face]);
+        const unsigned int base = vertices.size();
+        for (const auto &uv : corners)
+        {
+            const glm::vec3 position =
+                0.5f * (normals[face] + (uv.x * 2.0f - 1.0f) * tangents[face] + (uv.y * 2.0f - 1.0f) * bitangent);
+            vertices.push_back({position, uv, normals[face], tangents[face], bitangent});
+        }
+        for (unsigned int index : {0u, 1u, 2u, 2u, 3u, 0u})
+            indices.push_back(base + index);
+    }
+
+    return std::make_shared<Model>(vertices, indices, material);
+}
+} // namespace Engine
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Asset.h"
+#include "Model.h"
+
+#include <cstdint>
+
+namespace Engine
+{
+class Scene;
+
+struct StressSceneConfig
+{
+    uint32_t MeshEntities = 1000;
+    // entities per parent chain, 1 keeps the scene flat
+    uint32_t HierarchyDepth = 1;
+    uint32_t PointLights = 8;
+    uint32_t SpotLights = 8;
+    // dynamic boxes dropped on a static floor, on top of the mesh entities
+    uint32_t RigidBodies = 100;
+    uint32_t Seed = 1;
+};
+
+// Fills a scene with generated content of a given size. Everything is built in memory (one cube model, one
+// material) so the result only depends on the config, never on the assets on disk.
+class StressScene
+{
+  public:
+    static void Generate(Scene &scene, const StressSceneConfig &config);
+
+  private:
+    static ModelRef CreateCube(AssetHandle material);
+};
+} // namespace Engine
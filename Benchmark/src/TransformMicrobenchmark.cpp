@@ -0,0 +1,64 @@
+#include "TransformMicrobenchmark.h"
+
+#include "BenchmarkReport.h"
+#include "Components.h"
+#include "Log.h"
+#include "Profiler.h"
+#include "TransformBatch.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace Engine
+{
+void TransformMicrobenchmark::Run(uint32_t transforms, uint32_t iterations, BenchmarkReport &report)
+{
+    std::mt19937 random(1);
+    std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+    std::vector<TransformComponent> components(transforms);
+    for (auto &component : components)
+    {
+        component.Translation = glm::vec3(unit(random), unit(random), unit(random)) * 100.0f;
+        component.Rotation = glm::vec3(unit(random), unit(random), unit(random)) * glm::pi<float>();
+        component.Scale = glm::vec3(1.0f) + 0.5f * glm::vec3(unit(random), unit(random), unit(random));
+    }
+
+    std::vector<glm::mat4> reference(transforms), batched(transforms);
+    Math::TransformBatch batch;
+    batch.Reserve(transforms);
+
+    report.SetConfig("Microbenchmark", "Transforms");
+    report.SetConfig("Transforms", transforms);
+    report.SetConfig("InstructionSet", Math::TransformBatch::GetInstructionSet());
+
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        const double start = Profiler::Now();
+        for (uint32_t j = 0; j < transforms; j++)
+            reference[j] = components[j].GetTransform();
+        const double glmDone = Profiler::Now();
+
+        batch.Clear();
+        for (const auto &component : components)
+            batch.Add(component.Translation, component.Rotation, component.Scale);
+        batch.Compute(batched.data());
+        const double batchDone = Profiler::Now();
+
+        report.RecordStage("glm", (glmDone - start) / 1000.0);
+        report.RecordStage("TransformBatch", (batchDone - glmDone) / 1000.0);
+    }
+
+    // both paths are float, so only rounding should set them apart
+    float maxError = 0.0f;
+    for (uint32_t j = 0; j < transforms; j++)
+        for (int column = 0; column < 4; column++)
+            maxError = std::max(maxError, glm::length(reference[j][column] - batched[j][column]));
+
+    LOG_INFO("Benchmark: {} transforms with {}, max difference to glm {}", transforms,
+             Math::TransformBatch::GetInstructionSet(), maxError);
+}
+} // namespace Engine
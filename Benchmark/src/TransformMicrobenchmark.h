@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Engine
+{
+class BenchmarkReport;
+
+// Times TransformComponent::GetTransform, the glm path, against the batched SIMD kernel behind
+// Scene::UpdateWorldMatrices on the same random transforms. Both become stages of the report, the batch one
+// including the gather into structure-of-arrays that the scene pays as well.
+class TransformMicrobenchmark
+{
+  public:
+    static void Run(uint32_t transforms, uint32_t iterations, BenchmarkReport &report);
+};
+} // namespace Engine
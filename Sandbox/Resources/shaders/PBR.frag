@@ -1,4 +1,4 @@
-#version 330 core
+#version 450 core
 
 #define MAX_POINT_LIGHTS 5
 #define MAX_SPOT_LIGHTS 5
@@ -47,6 +47,29 @@ uniform samplerCube irradianceMap;
 uniform samplerCube prefilterMap;
 uniform sampler2D brdfLUT;
 
+// SH9 irradiance of the sky, filled by SceneRenderer::UploadSkyIrradiance
+layout (std140, binding = 0) uniform SkyIrradiance {
+    vec4 shCoefficients[9];
+    int shEnabled;
+};
+
+vec3 sampleIrradiance(vec3 N)
+{
+    if (shEnabled == 0)
+        return texture(irradianceMap, N).rgb;
+
+    vec3 irradiance = shCoefficients[0].rgb * 0.282095
+        + shCoefficients[1].rgb * 0.488603 * N.y
+        + shCoefficients[2].rgb * 0.488603 * N.z
+        + shCoefficients[3].rgb * 0.488603 * N.x
+        + shCoefficients[4].rgb * 1.092548 * N.x * N.y
+        + shCoefficients[5].rgb * 1.092548 * N.y * N.z
+        + shCoefficients[6].rgb * 0.315392 * (3.0 * N.z * N.z - 1.0)
+        + shCoefficients[7].rgb * 1.092548 * N.x * N.z
+        + shCoefficients[8].rgb * 0.546274 * (N.x * N.x - N.y * N.y);
+    return max(irradiance, vec3(0.0));
+}
+
 // material textures maps
 uniform sampler2D albedoMap;
 uniform sampler2D normalMap;
@@ -217,7 +240,7 @@ void main() {
     vec3 kD = 1.0 - kS;
     kD *= 1.0 - metallic;
     
-    vec3 irradiance = mix(texture(irradianceMap, N).rgb, vec3(0.1f), 0.9f);
+    vec3 irradiance = mix(sampleIrradiance(N), vec3(0.1f), 0.9f);
     vec3 diffuse = irradiance * albedo;
     
     // sample both the pre-filter map and the BRDF lut and combine them together as per the Split-Sum approximation to get the IBL specular part.
@@ -14,6 +14,9 @@ out mat3 TBN;
 uniform mat4 model;
 uniform mat4 projectionViewMatrix;
 
+// must match depth.vert exactly when drawing over the depth prepass
+invariant gl_Position;
+
 void main()
 {
     mat3 normalMatrix = mat3(transpose(inverse(model)));
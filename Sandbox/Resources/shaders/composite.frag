@@ -0,0 +1,80 @@
+#version 460 core
+
+// quad.frag and edgeDetection.frag in one pass: selection outline straight from the mask, bloom, exposure,
+// tonemap and gamma, without the intermediate edge texture.
+
+layout (location = 0) out vec4 FragColor;
+
+in vec2 TexCoords;
+
+uniform sampler2D scene;
+uniform sampler2D bloomBlur;
+uniform sampler2D outlineMask;
+uniform float exposure;
+uniform float bloomStrength = 0.04f;
+uniform int bloomEnabled;
+uniform int outlineEnabled;
+uniform float sharpness;
+
+const vec4 outlineColor = vec4(1.0, 0.8, 0.3, 1.0);
+const float outlineThreshold = 0.5;
+
+// Upscaling from the internal render resolution is the bilinear fetch itself; this puts some of the lost detail
+// back with a small unsharp mask, clamped to the neighbourhood so edges don't ring.
+vec3 SampleScene()
+{
+  vec3 c = texture(scene, TexCoords).rgb;
+  if (sharpness <= 0.0)
+    return c;
+
+  vec2 texelSize = 1.0 / vec2(textureSize(scene, 0));
+  vec3 n = texture(scene, TexCoords + vec2(0.0, -texelSize.y)).rgb;
+  vec3 s = texture(scene, TexCoords + vec2(0.0,  texelSize.y)).rgb;
+  vec3 e = texture(scene, TexCoords + vec2( texelSize.x, 0.0)).rgb;
+  vec3 w = texture(scene, TexCoords + vec2(-texelSize.x, 0.0)).rgb;
+
+  vec3 minColor = min(c, min(min(n, s), min(e, w)));
+  vec3 maxColor = max(c, max(max(n, s), max(e, w)));
+
+  vec3 sharpened = c + (4.0 * c - (n + s + e + w)) * 0.25 * sharpness;
+  return clamp(sharpened, minColor, maxColor);
+}
+
+float OutlineEdge()
+{
+  vec2 texelSize = 1.0 / vec2(textureSize(outlineMask, 0));
+  float w = texelSize.x;
+  float h = texelSize.y;
+
+  float n[9];
+  n[0] = texture(outlineMask, TexCoords + vec2( -w, -h)).r;
+  n[1] = texture(outlineMask, TexCoords + vec2(0.0, -h)).r;
+  n[2] = texture(outlineMask, TexCoords + vec2(  w, -h)).r;
+  n[3] = texture(outlineMask, TexCoords + vec2( -w, 0.0)).r;
+  n[4] = texture(outlineMask, TexCoords).r;
+  n[5] = texture(outlineMask, TexCoords + vec2(  w, 0.0)).r;
+  n[6] = texture(outlineMask, TexCoords + vec2( -w, h)).r;
+  n[7] = texture(outlineMask, TexCoords + vec2(0.0, h)).r;
+  n[8] = texture(outlineMask, TexCoords + vec2(  w, h)).r;
+
+  float sobelH = n[2] + (2.0*n[5]) + n[8] - (n[0] + (2.0*n[3]) + n[6]);
+  float sobelV = n[0] + (2.0*n[1]) + n[2] - (n[6] + (2.0*n[7]) + n[8]);
+  return sqrt(sobelH * sobelH + sobelV * sobelV);
+}
+
+void main()
+{
+  vec3 result = SampleScene();
+  if (bloomEnabled != 0)
+    result += texture(bloomBlur, TexCoords).rgb * bloomStrength;
+
+  // tone mapping
+  result = vec3(1.0) - exp(-result * exposure);
+  // also gamma correct while we're at it
+  const float gamma = 2.2;
+  result = pow(result, vec3(1.0 / gamma));
+
+  FragColor = vec4(result, 1.0);
+  if (outlineEnabled != 0 && OutlineEdge() > outlineThreshold)
+    FragColor = outlineColor;
+}
@@ -0,0 +1,16 @@
+#version 330 core
+
+// Depth prepass. Position has to come out bit-identical to PBR.vert for the GL_EQUAL test that follows.
+
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 projectionViewMatrix;
+
+invariant gl_Position;
+
+void main()
+{
+    vec3 currentPos = vec3(model * vec4(aPos, 1.0f));
+    gl_Position = projectionViewMatrix * vec4(currentPos, 1.0f);
+}
@@ -1,79 +1,88 @@
 #version 460 core
 
-layout(location = 0) out vec4 gAlbedo;
-layout(location = 1) out vec4 gNormal;
-layout(location = 2) out vec4 gMaterial;
-layout(location = 3) out int gEntityID;
+// Geometry pass of the deferred path. Takes the same material uniforms as PBR.frag and writes:
+//   1: entity id (R32I)
+//   2: albedo, gamma encoded (RGBA8)
+//   3: normal, octahedral encoded (RG16F)
+//   4: metallic, roughness, ao, emissive / EMISSIVE_RANGE (RGBA8)
+// World position is rebuilt from depth in lighting.frag.
 
-in vec3 FragPos;
-in vec2 UV;
-in mat3 TBN;
+#define EMISSIVE_RANGE 16.0
 
-// Material
-uniform sampler2D m_Albedo;
-uniform sampler2D m_Metalness;
-uniform sampler2D m_Roughness;
-uniform sampler2D m_AO;
-uniform sampler2D m_Normal;
-uniform sampler2D m_Displacement;
-uniform int u_EntityID;
+layout (location = 1) out int gEntityId;
+layout (location = 2) out vec4 gAlbedo;
+layout (location = 3) out vec2 gNormal;
+layout (location = 4) out vec4 gMaterial;
 
-layout(std140, binding = 32) uniform u_MaterialUniform
-{
-    int u_HasAlbedo;
-    vec3 m_AlbedoColor;     //  16 byte
-    int u_HasMetalness;     //  32 byte
-    float u_MetalnessValue; //  36 byte
-    int u_HasRoughness;     //  40 byte
-    float u_RoughnessValue; //  44 byte
-    int u_HasAO;            //  48 byte
-    float u_AOValue;        //  52 byte
-    int u_HasNormal;        //  56 byte
-    int u_HasDisplacement;  //  60 byte
-    int u_Unlit;
-};
+in vec2 TexCoords;
+in mat3 TBN;
 
-void main()
-{
-    // Normal
-    vec3 normal = vec3(0.5, 0.5, 1.0);
-    if (u_HasNormal == 1)
-        normal = texture(m_Normal, UV).rgb;
-    normal = normal * 2.0 - 1.0;
-    normal = TBN * normalize(normal);
-    gNormal = vec4(normal / 2.0 + 0.5, 1.0);
+// material parameters
+uniform vec3 albedoParam;
+uniform float metallicParam;
+uniform float roughnessParam;
+uniform float aoParam;
+uniform float emissiveParam;
 
-    // Albedo
-    gAlbedo = vec4(m_AlbedoColor, 1.0);
-    if (u_HasAlbedo == 1)
-    {
-        vec4 albedoSample = texture(m_Albedo, UV);
-        gAlbedo.rgb = albedoSample.rgb * m_AlbedoColor.rgb;
-        gAlbedo.a = albedoSample.a;
+// material textures maps
+uniform sampler2D albedoMap;
+uniform sampler2D normalMap;
+uniform sampler2D metallicMap;
+uniform sampler2D roughnessMap;
+uniform sampler2D aoMap;
 
-        if (albedoSample.a < 0.1f)
-        {
-            discard;
-        }
-    }
+uniform int entityId;
 
-    // Material
-    float finalMetalness = u_MetalnessValue;
-    if (u_HasMetalness == 1)
-        finalMetalness = texture(m_Metalness, UV).r;
+uniform int hasAlbedoMap;
+uniform int hasNormalMap;
+uniform int hasMetallicMap;
+uniform int hasRoughnessMap;
+uniform int hasAoMap;
+
+vec2 OctWrap(vec2 v)
+{
+    return (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+}
 
-    float finalAO = u_AOValue;
-    if (u_HasAO == 1)
-        finalAO = texture(m_AO, UV).r;
+vec2 EncodeNormal(vec3 n)
+{
+    n /= abs(n.x) + abs(n.y) + abs(n.z);
+    return n.z >= 0.0 ? n.xy : OctWrap(n.xy);
+}
 
-    float finalRoughness = u_RoughnessValue;
-    if (u_HasRoughness == 1)
-        finalRoughness = texture(m_Roughness, UV).r;
+void main()
+{
+    // same material evaluation as PBR.frag
+    vec3 albedo = albedoParam;
+    if (hasAlbedoMap == 1) {
+        albedo = pow(texture(albedoMap, TexCoords).rgb, vec3(2.2));
+        albedo = mix(albedo, albedoParam, 0.5);
+    }
 
-    gMaterial = vec4(0, 0, 0, 1);
-    gMaterial.r = finalMetalness;
-    gMaterial.g = finalAO;
-    gMaterial.b = finalRoughness;
+    float metallic = metallicParam;
+    if (hasMetallicMap == 1) {
+        metallic = texture(metallicMap, TexCoords).r;
+        metallic = mix(metallic, metallicParam, 0.5);
+    }
+    float roughness = roughnessParam;
+    if (hasRoughnessMap == 1) {
+        roughness = texture(roughnessMap, TexCoords).r;
+        roughness = mix(roughness, roughnessParam, 0.5);
+    }
+    float ao = aoParam;
+    if (hasAoMap == 1) {
+        ao = texture(aoMap, TexCoords).r;
+        ao = mix(ao, aoParam, 0.5);
+    }
+    vec3 normal = vec3(0.5, 0.5, 1.0);
+    if (hasNormalMap == 1) {
+        normal = texture(normalMap, TexCoords).rgb;
+    }
+    normal = normal * 2.0 - 1.0;
+    normal = normalize(TBN * normalize(normal));
 
-    gEntityID = int(u_EntityID);
-}
\ No newline at end of file
+    gEntityId = entityId;
+    gAlbedo = vec4(pow(albedo, vec3(1.0 / 2.2)), 1.0);
+    gNormal = EncodeNormal(normal);
+    gMaterial = vec4(metallic, roughness, ao, emissiveParam / EMISSIVE_RANGE);
+}
@@ -1,152 +1,228 @@
-#version 330 core
+#version 460 core
 
-in vec3 Color;
-in vec2 TexCoord;
-in vec3 Normal;
-in vec3 CurrentPos;
+// Lighting pass of the deferred path. Shades every pixel covered by geometry once, with the directional light,
+// the lights lightCulling.comp put in its tile and the same IBL ambient term as PBR.frag. Sky pixels are left as
+// they were drawn.
+
+#define TILE_SIZE 16
+#define MAX_LIGHTS_PER_TILE 63
+#define EMISSIVE_RANGE 16.0
 
 layout (location = 0) out vec4 FragColor;
-layout (location = 1) out int color2;
 
-#define MAX_POINT_LIGHTS 10
-#define MAX_SPOT_LIGHTS 10
+in vec2 TexCoords;
 
-struct BaseLight
+struct GPULight
 {
-    vec3 Color;
-    float AmbientIntensity;
-    float DiffuseIntensity;
+    vec4 PositionRadius;
+    vec4 Color;
+    vec4 Direction;
+    vec4 Params;
 };
 
-struct DirectionalLight
+layout(std430, binding = 1) readonly buffer Lights
 {
-    BaseLight Base;
-    vec3 Direction;
+    GPULight lights[];
 };
 
-struct Attenuation
+layout(std430, binding = 2) readonly buffer TileLights
 {
-    float Constant;
-    float Linear;
-    float Exp;
+    uint tileLights[];
 };
 
-struct PointLight
-{
-    BaseLight Base;
-    vec3 Position;
-    Attenuation Atten;
+struct DirectionalLight {
+    vec3 Direction;
+    vec3 Color;
 };
+uniform DirectionalLight gDirectionalLight;
 
-struct SpotLight
-{
-    PointLight Base;
-    vec3 Direction;
-    float Cutoff;
-    float OuterCutoff;
+uniform vec3 cameraPosition;
+uniform mat4 inverseProjectionView;
+uniform int tileCountX;
+
+// G-buffer
+uniform sampler2D gDepth;
+uniform sampler2D gAlbedo;
+uniform sampler2D gNormal;
+uniform sampler2D gMaterial;
+
+// IBL
+uniform samplerCube irradianceMap;
+uniform samplerCube prefilterMap;
+uniform sampler2D brdfLUT;
+
+// SH9 irradiance of the sky, filled by SceneRenderer::UploadSkyIrradiance
+layout (std140, binding = 0) uniform SkyIrradiance {
+    vec4 shCoefficients[9];
+    int shEnabled;
 };
 
-struct Material
+vec3 sampleIrradiance(vec3 N)
 {
-    vec3 AmbientColor;
-    vec3 DiffuseColor;
-    vec3 SpecularColor;
-};
+    if (shEnabled == 0)
+        return texture(irradianceMap, N).rgb;
+
+    vec3 irradiance = shCoefficients[0].rgb * 0.282095
+        + shCoefficients[1].rgb * 0.488603 * N.y
+        + shCoefficients[2].rgb * 0.488603 * N.z
+        + shCoefficients[3].rgb * 0.488603 * N.x
+        + shCoefficients[4].rgb * 1.092548 * N.x * N.y
+        + shCoefficients[5].rgb * 1.092548 * N.y * N.z
+        + shCoefficients[6].rgb * 0.315392 * (3.0 * N.z * N.z - 1.0)
+        + shCoefficients[7].rgb * 1.092548 * N.x * N.z
+        + shCoefficients[8].rgb * 0.546274 * (N.x * N.x - N.y * N.y);
+    return max(irradiance, vec3(0.0));
+}
 
-uniform Material gMaterial;
-uniform DirectionalLight gDirectionalLight;
-uniform int gNumPointLights;
-uniform PointLight gPointLights[MAX_POINT_LIGHTS];
-uniform int gNumSpotLights;
-uniform SpotLight gSpotLights[MAX_SPOT_LIGHTS];
+const float PI = 3.14159265359;
 
-uniform sampler2D diffuse0;
-uniform sampler2D specular0;
-uniform vec3 gCameraPos;
+vec3 DecodeNormal(vec2 f)
+{
+    vec3 n = vec3(f, 1.0 - abs(f.x) - abs(f.y));
+    float t = clamp(-n.z, 0.0, 1.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
-vec4 calcLightInternal(BaseLight base, vec3 direction, vec3 normal)
+vec3 fresnelSchlick(float cosTheta, vec3 F0)
 {
-    vec4 ambientColor = vec4(base.Color, 1.0f) *
-                        base.AmbientIntensity *
-                        vec4(gMaterial.AmbientColor, 1.0f);
-
-    float diffuseFactor = dot(normal, -direction);
-    vec4 diffuseColor = vec4(0, 0, 0, 0);
-    vec4 specularColor = vec4(0, 0, 0, 0);
-    if (diffuseFactor > 0)
-    {
-        diffuseColor = vec4(base.Color, 1.0f) *
-                       base.DiffuseIntensity *
-                       vec4(gMaterial.DiffuseColor, 1.0f) *
-                       diffuseFactor;
-
-        vec3 viewDirection = normalize(gCameraPos - CurrentPos);
-        vec3 lightReflect = reflect(direction, normal);
-        float specularFactor = pow(max(dot(viewDirection, lightReflect), 0.0), 32);
-          
-        specularColor = vec4(base.Color, 1.0f) *
-                        vec4(gMaterial.SpecularColor, 1.0f) *
-                        texture(specular0, TexCoord).r *
-                        specularFactor;
-    }
+    return F0 + (1.0 - F0) * pow(clamp(1.0 - cosTheta, 0.0, 1.0), 5.0);
+}
 
-    return (ambientColor + diffuseColor + specularColor);   
+vec3 fresnelSchlickRoughness(float cosTheta, vec3 F0, float roughness) {
+    return F0 + (max(vec3(1.0 - roughness), F0) - F0) * pow(1.0 - cosTheta, 5.0);
 }
 
-vec4 calcDirectionalLight(vec3 normal)
+float DistributionGGX(vec3 N, vec3 H, float roughness)
 {
-    return calcLightInternal(gDirectionalLight.Base, gDirectionalLight.Direction, normal);
+    float a = roughness*roughness;
+    float a2 = a*a;
+    float NdotH = max(dot(N, H), 0.0);
+    float NdotH2 = NdotH*NdotH;
+
+    float num = a2;
+    float denom = (NdotH2 * (a2 - 1.0) + 1.0);
+    denom = PI * denom * denom;
+
+    return num / denom;
 }
 
-vec4 calcPointLight(PointLight l, vec3 normal)
+float GeometrySchlickGGX(float NdotV, float roughness)
 {
-    vec3 lightDirection = CurrentPos - l.Position;
-    float distance = length(lightDirection);
-    lightDirection = normalize(lightDirection);
+    float r = (roughness + 1.0);
+    float k = (r*r) / 8.0;
 
-    vec4 color = calcLightInternal(l.Base, lightDirection, normal);
+    float num = NdotV;
+    float denom = NdotV * (1.0 - k) + k;
 
-    float attenuation = l.Atten.Constant +
-                        l.Atten.Linear * distance +
-                        l.Atten.Exp * distance * distance;
+    return num / denom;
+}
+
+float GeometrySmith(vec3 N, vec3 V, vec3 L, float roughness)
+{
+    float NdotV = max(dot(N, V), 0.0);
+    float NdotL = max(dot(N, L), 0.0);
+    float ggx2 = GeometrySchlickGGX(NdotV, roughness);
+    float ggx1 = GeometrySchlickGGX(NdotL, roughness);
 
-    return color / attenuation;
+    return ggx1 * ggx2;
 }
 
-vec4 calcSpotLight(SpotLight l, vec3 normal)
+vec3 calcReflectanceEquation(vec3 L, vec3 V, vec3 N, vec3 albedo, float metallic, float roughness)
 {
-    vec3 lightDirection = normalize(CurrentPos - l.Base.Position);
-    float spotFactor = dot(lightDirection, normalize(-l.Direction));
-    float epsilon = l.Cutoff - l.OuterCutoff;
+    vec3 H = normalize(V + L);
 
-    if (spotFactor > l.Cutoff)
-    {
-        vec4 color = calcPointLight(l.Base, normal);
-        float spotLightIntensity = clamp((spotFactor - l.OuterCutoff) / epsilon, 0.0, 1.0);
-        return color * spotLightIntensity;
-    }
-    else
-    {
-        return vec4(0, 0, 0, 0);
-    }
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+
+    float NDF = DistributionGGX(N, H, roughness);
+    float G = GeometrySmith(N, V, L, roughness);
+    vec3 F = fresnelSchlick(max(dot(H, V), 0.0), F0);
+
+    vec3 kS = F;
+    vec3 kD = vec3(1.0) - kS;
+    kD *= 1.0 - metallic;
+
+    float NdotL = max(dot(N, L), 0.0);
+    vec3 numerator = NDF * G * F;
+    float denominator = 4.0 * max(dot(N, V), 0.0) * NdotL + 0.001;
+    vec3 specular = numerator / denominator;
+
+    return (kD * albedo / PI + specular) * NdotL;
 }
 
 void main()
 {
-    vec3 normal = normalize(Normal);
-    vec4 totalLight = calcDirectionalLight(normal);
+    float depth = texture(gDepth, TexCoords).r;
+    if (depth >= 1.0)
+        discard;
+
+    vec4 position = inverseProjectionView * vec4(TexCoords * 2.0 - 1.0, depth * 2.0 - 1.0, 1.0);
+    vec3 WorldPosition = position.xyz / position.w;
+
+    vec4 material = texture(gMaterial, TexCoords);
+    float metallic = material.r;
+    float roughness = material.g;
+    float ao = material.b;
+    vec3 albedo = pow(texture(gAlbedo, TexCoords).rgb, vec3(2.2)) * material.a * EMISSIVE_RANGE;
+
+    vec3 N = DecodeNormal(texture(gNormal, TexCoords).rg);
+    vec3 V = normalize(cameraPosition - WorldPosition);
+    vec3 R = reflect(-V, N);
 
-    for (int i = 0; i < gNumPointLights; i++)
+    vec3 F0 = vec3(0.04);
+    F0 = mix(F0, albedo, metallic);
+
+    vec3 Lo = vec3(0.0);
+
+    // directional light reflection
     {
-        totalLight += calcPointLight(gPointLights[i], normal);
+        vec3 L = normalize(-gDirectionalLight.Direction);
+        vec3 radiance = gDirectionalLight.Color;
+        Lo += calcReflectanceEquation(L, V, N, albedo, metallic, roughness) * radiance;
     }
 
-    for (int i = 0; i < gNumSpotLights; i++)
-    {
-        totalLight += calcSpotLight(gSpotLights[i], normal);
+    // point and spot lights of this tile
+    ivec2 tile = ivec2(gl_FragCoord.xy) / TILE_SIZE;
+    uint base = uint(tile.y * tileCountX + tile.x) * (MAX_LIGHTS_PER_TILE + 1);
+    uint count = tileLights[base];
+    for (uint i = 0; i < count; i++) {
+        GPULight light = lights[tileLights[base + 1 + i]];
+
+        vec3 L = normalize(light.PositionRadius.xyz - WorldPosition);
+        float distance = length(light.PositionRadius.xyz - WorldPosition);
+        float attenuation = 1.0 / (distance * distance);
+        vec3 radiance = light.Color.rgb * attenuation;
+
+        if (light.Color.w > 0.5) {
+            float spotEffect = dot(normalize(light.Direction.xyz), -L);
+            if (spotEffect <= light.Direction.w)
+                continue;
+            radiance *= pow(spotEffect, light.Params.x);
+        }
+
+        Lo += calcReflectanceEquation(L, V, N, albedo, metallic, roughness) * radiance;
     }
 
-    FragColor = texture(diffuse0, TexCoord) * totalLight;
-    FragColor = vec4(1, 1, 1, 1);
-    color2 = 50;
-}
\ No newline at end of file
+    // ambient lighting (we now use IBL as the ambient term)
+    vec3 F = fresnelSchlickRoughness(max(dot(N, V), 0.0), F0, roughness);
+
+    vec3 kS = F;
+    vec3 kD = 1.0 - kS;
+    kD *= 1.0 - metallic;
+
+    vec3 irradiance = mix(sampleIrradiance(N), vec3(0.1f), 0.9f);
+    vec3 diffuse = irradiance * albedo;
+
+    const float MAX_REFLECTION_LOD = 4.0;
+    vec3 prefilteredColor = textureLod(prefilterMap, R,  roughness * MAX_REFLECTION_LOD).rgb;
+    vec2 brdf = texture(brdfLUT, vec2(max(dot(N, V), 0.0), roughness)).rg;
+    vec3 specular = prefilteredColor * (F * brdf.x + brdf.y);
+
+    vec3 amb = (kD * (diffuse + specular)) * ao;
+    vec3 color = amb + Lo;
+
+    color = color / (color + vec3(1.0));
+
+    FragColor = vec4(color, 1.0);
+}
@@ -10,16 +10,38 @@ uniform sampler2D outlineTexture;
 uniform float exposure;
 uniform float bloomStrength = 0.04f;
 uniform int bloomEnabled;
+uniform float sharpness;
+
+// Upscaling from the internal render resolution is the bilinear fetch itself; this puts some of the lost detail
+// back with a small unsharp mask, clamped to the neighbourhood so edges don't ring.
+vec3 SampleScene()
+{
+  vec3 c = texture(scene, TexCoords).rgb;
+  if (sharpness <= 0.0)
+    return c;
+
+  vec2 texelSize = 1.0 / vec2(textureSize(scene, 0));
+  vec3 n = texture(scene, TexCoords + vec2(0.0, -texelSize.y)).rgb;
+  vec3 s = texture(scene, TexCoords + vec2(0.0,  texelSize.y)).rgb;
+  vec3 e = texture(scene, TexCoords + vec2( texelSize.x, 0.0)).rgb;
+  vec3 w = texture(scene, TexCoords + vec2(-texelSize.x, 0.0)).rgb;
+
+  vec3 minColor = min(c, min(min(n, s), min(e, w)));
+  vec3 maxColor = max(c, max(max(n, s), max(e, w)));
+
+  vec3 sharpened = c + (4.0 * c - (n + s + e + w)) * 0.25 * sharpness;
+  return clamp(sharpened, minColor, maxColor);
+}
 
 vec3 bloom_none()
 {
-  vec3 hdrColor = texture(scene, TexCoords).rgb;
+  vec3 hdrColor = SampleScene();
   return hdrColor;
 }
 
 vec3 bloom()
 {
-  vec3 hdrColor = texture(scene, TexCoords).rgb;
+  vec3 hdrColor = SampleScene();
   vec3 bloomColor = texture(bloomBlur, TexCoords).rgb;
   //return mix(hdrColor, bloomColor, bloomStrength); // linear interpolation
   
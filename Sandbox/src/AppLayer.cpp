@@ -9,6 +9,10 @@
 #include "AssetManager.h"
 #include "TextureImporter.h"
 #include "Utils/FileDialogs.h"
+#include "RenderCommand.h"
+#include "FramePacer.h"
+#include "MemoryTracker.h"
+#include "SceneRenderer.h"
 
 #include <IconsFontAwesome5.h>
 
@@ -56,6 +60,7 @@ void AppLayer::OnUpdate(float dt)
     m_EditorCamera.SetViewportSize(m_ViewportSize.x, m_ViewportSize.y);
 	m_ActiveScene->SetViewportSize(m_ViewportSize.x, m_ViewportSize.y);
     m_ActiveScene->SetFramebuffer(m_Framebuffer);
+    m_ActiveScene->SetInterpolationAlpha(Application::GetInterpolationAlpha());
 
     auto selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity();
 
@@ -71,6 +76,9 @@ void AppLayer::OnUpdate(float dt)
         default: break;
     }
 
+    // things that move without input events keep drawing when rendering on demand, held buttons fly the camera
+    if (m_SceneState == SceneState::Play || ImGui::IsAnyMouseDown()) FramePacer::RequestRedraw();
+
     auto [mx, my] = ImGui::GetMousePos();
     mx -= m_ViewportBounds[0].x;
     my -= m_ViewportBounds[0].y;
@@ -96,6 +104,8 @@ void AppLayer::OnFixedUpdate(float dt)
 
 void AppLayer::OnImGuiRender()
 {
+    MEMORY_TAG(Editor);
+
     static bool dockspace_open = true;
     static bool opt_fullscreen = true;
     static bool opt_padding = false;
@@ -146,6 +156,7 @@ void AppLayer::OnImGuiRender()
             ImGui::Separator();
             if (ImGui::MenuItem("New Project", "Ctrl+Shift+N")) NewProject();
             if (ImGui::MenuItem("Open Project", "Ctrl+Shift+O")) OpenProject();
+            if (ImGui::MenuItem("Build Asset Pak", nullptr, false, (bool)Project::GetActive())) BuildAssetPak();
             ImGui::Separator();
             if (ImGui::MenuItem("Save...", "Ctrl+S")) SaveScene();
             if (ImGui::MenuItem("Save As...", "Ctrl+Shift+S")) SaveSceneAs();
@@ -161,6 +172,58 @@ void AppLayer::OnImGuiRender()
     m_EnvironmentPanel.OnImGuiRender();
     m_MaterialEditorPanel.OnImGuiRender();
     m_ContentBrowserPanel->OnImGuiRender();
+    m_ProfilerPanel.OnImGuiRender();
+    m_MemoryPanel.OnImGuiRender();
+
+    ImGui::Begin("Renderer Stats");
+    const RenderStats stats = RenderCommand::GetFrameStats();
+    ImGui::Text("Submits: %u", stats.Submits);
+    ImGui::Text("Batches: %u", stats.Batches);
+    ImGui::Text("Culled: %u", stats.Culled);
+    ImGui::Text("Draw Calls: %u", stats.DrawCalls);
+    ImGui::Text("Triangles: %u", stats.Triangles);
+    ImGui::Text("State Changes: %u (%u redundant)", stats.StateChanges, stats.RedundantStateChanges);
+    ImGui::Text("Render Passes: %u (%u culled)", stats.RenderPasses, stats.CulledPasses);
+    ImGui::Text("Dispatches: %u", stats.Dispatches);
+    ImGui::Text("Uploads: %u (%.1f KB)", stats.Uploads, stats.UploadBytes / 1024.0);
+    auto sceneRenderer = m_ActiveScene->GetSceneRenderer();
+    if (ImGui::TreeNode("GPU Pass Times"))
+    {
+        for (const auto &[name, timer] : sceneRenderer->GetRenderGraph().GetPassTimers())
+            ImGui::Text("%s: %.3f ms", name.c_str(), timer.GetTime());
+        ImGui::TreePop();
+    }
+    if (ImGui::TreeNode("Dynamic Resolution"))
+    {
+        auto &dynamicResolution = sceneRenderer->GetDynamicResolution();
+        auto &settings = dynamicResolution.GetSettings();
+        glm::vec2 renderSize = sceneRenderer->GetRenderGraph().GetSize();
+
+        ImGui::Checkbox("Enabled", &settings.Enabled);
+        ImGui::DragFloat("Target (ms)", &settings.TargetFrameTime, 0.1f, 1.0f, 100.0f, "%.1f");
+        ImGui::DragFloatRange2("Scale", &settings.MinScale, &settings.MaxScale, 0.01f, 0.25f, 1.0f, "%.2f");
+        ImGui::SliderFloat("Sharpness", &settings.Sharpness, 0.0f, 1.0f, "%.2f");
+
+        ImGui::Text("Render Scale: %.2f (%.0fx%.0f)", dynamicResolution.GetScale(), renderSize.x, renderSize.y);
+        ImGui::Text("GPU Frame: %.3f ms", sceneRenderer->GetRenderGraph().GetGPUTime());
+        ImGui::PlotLines("GPU Time", dynamicResolution.GetFrameTimeHistory().data(), DynamicResolution::HistorySize,
+                         dynamicResolution.GetHistoryOffset(), nullptr, 0.0f, settings.TargetFrameTime * 2.0f,
+                         ImVec2(0, 60));
+        ImGui::PlotLines("Scale", dynamicResolution.GetScaleHistory().data(), DynamicResolution::HistorySize,
+                         dynamicResolution.GetHistoryOffset(), nullptr, 0.0f, 1.0f, ImVec2(0, 60));
+        ImGui::TreePop();
+    }
+    if (ImGui::TreeNode("Frame Pacing"))
+    {
+        auto &pacing = FramePacer::GetSettings();
+        ImGui::Checkbox("VSync", &pacing.VSync);
+        ImGui::Checkbox("Render On Demand", &pacing.RenderOnDemand);
+        ImGui::DragFloat("Foreground FPS", &pacing.ForegroundFPS, 1.0f, 0.0f, 500.0f, "%.0f");
+        ImGui::DragFloat("Background FPS", &pacing.BackgroundFPS, 1.0f, 0.0f, 500.0f, "%.0f");
+        ImGui::DragFloat("Idle FPS", &pacing.IdleFPS, 1.0f, 1.0f, 60.0f, "%.0f");
+        ImGui::TreePop();
+    }
+    ImGui::End();
 
     ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2{0, 0});
     ImGui::Begin("Viewport");
@@ -243,6 +306,8 @@ void AppLayer::OnImGuiRender()
 				tc.Translation = translation;
                 tc.Rotation += deltaRotation;
                 tc.Scale = scale;
+                tc.MarkDirty();
+                selectedEntity.PatchComponent<TransformComponent>();
 
 				if (parentComponent.HasParent)
 				{
@@ -330,6 +395,11 @@ void AppLayer::OpenProject()
 	}
 }
 
+void AppLayer::BuildAssetPak()
+{
+    Project::RebuildAssetPak();
+}
+
 void AppLayer::NewScene()
 {
     // TODO: create new scene file
@@ -5,6 +5,8 @@
 #include "Panels/ContentBrowserPanel.h"
 #include "Panels/MaterialEditorPanel.h"
 #include "Panels/EnvironmentPanel.h"
+#include "Panels/ProfilerPanel.h"
+#include "Panels/MemoryPanel.h"
 #include "Project.h"
 #include "Texture.h"
 #include "Framebuffer.h"
@@ -33,6 +35,8 @@ class AppLayer : public Layer
     // Project
     void NewProject();
     void OpenProject();
+    // packs the asset directory into Assets.pak, which the next load of the project mounts
+    void BuildAssetPak();
 
     // New
     void NewScene();
@@ -65,6 +69,8 @@ class AppLayer : public Layer
     SceneHierarchyPanel m_SceneHierarchyPanel;
     MaterialEditorPanel m_MaterialEditorPanel;
     EnvironmentPanel m_EnvironmentPanel;
+    ProfilerPanel m_ProfilerPanel;
+    MemoryPanel m_MemoryPanel;
     std::shared_ptr<ContentBrowserPanel> m_ContentBrowserPanel = nullptr;
 
   private:
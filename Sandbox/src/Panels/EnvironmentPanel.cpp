@@ -74,6 +74,16 @@ void EnvironmentPanel::OnImGuiRender()
 		ImGui::Checkbox(_labelPrefix("Enabled"), &environment->BloomEnabled);
 		ImGui::DragFloat(_labelPrefix("Intensity"), &environment->BloomIntensity, 0.01f, 0.0f, 0.0f, "%.2f");
 		ImGui::DragFloat(_labelPrefix("Exposure"), &environment->Exposure, 0.01f, 0.0f, 0.0f, "%.2f");
+		ImGui::Checkbox(_labelPrefix("Compute Path"), &environment->ComputePostFX);
+	}
+
+	_collapsingHeaderStyle();
+	if (ImGui::CollapsingHeader("Rendering"))
+	{
+		ImGui::Checkbox(_labelPrefix("Deferred Shading"), &environment->DeferredShading);
+		if (!environment->DeferredShading)
+			ImGui::Checkbox(_labelPrefix("Depth Prepass"), &environment->DepthPrepass);
+		ImGui::Checkbox(_labelPrefix("SH Irradiance"), &environment->SHIrradiance);
 	}
     ImGui::End();
 }
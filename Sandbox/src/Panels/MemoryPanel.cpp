@@ -0,0 +1,111 @@
+#include "MemoryPanel.h"
+
+#include <imgui.h>
+#include "ImGuiHelpers.h"
+#include "MemoryTracker.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace Engine
+{
+namespace Utils
+{
+constexpr double MB = 1024.0 * 1024.0;
+} // namespace Utils
+
+void MemoryPanel::OnImGuiRender()
+{
+    const MemoryStats total = MemoryTracker::GetTotalStats();
+    m_HeapHistory[m_HistoryOffset] = (float)(total.Current / Utils::MB);
+    m_HistoryOffset = (m_HistoryOffset + 1) % HistorySize;
+
+    ImGui::Begin("Memory");
+    ImGui::Text("Heap: %.1f MB, peak %.1f MB, %zu allocations", total.Current / Utils::MB, total.Peak / Utils::MB,
+                total.Allocations);
+    if (!MemoryTracker::IsHookingNew()) ImGui::TextDisabled("operator new is not tracked in this build");
+
+    const float maxHeap = *std::max_element(m_HeapHistory.begin(), m_HeapHistory.end());
+    ImGui::PlotLines("Heap MB", m_HeapHistory.data(), HistorySize, (int)m_HistoryOffset, nullptr, 0.0f,
+                     std::max(maxHeap * 1.25f, 1.0f), ImVec2(0, 60));
+
+    _collapsingHeaderStyle();
+    if (ImGui::CollapsingHeader("Heap by Subsystem", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Columns(5, "MemoryTags");
+        for (const char *header : {"Subsystem", "Current MB", "Peak MB", "Allocations", "Budget MB"})
+        {
+            ImGui::Text("%s", header);
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+
+        for (size_t i = 0; i < (size_t)MemoryTag::Count; i++)
+        {
+            const auto tag = (MemoryTag)i;
+            const MemoryStats stats = MemoryTracker::GetStats(tag);
+            size_t budget = stats.Budget;
+            if (DrawRow(MemoryTracker::GetTagName(tag), stats, budget)) MemoryTracker::SetBudget(tag, budget);
+        }
+        ImGui::Columns(1);
+    }
+
+    if (ImGui::CollapsingHeader("GPU (estimated)", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        ImGui::Columns(5, "MemoryGPU");
+        for (const char *header : {"Type", "Current MB", "Peak MB", "Objects", "Budget MB"})
+        {
+            ImGui::Text("%s", header);
+            ImGui::NextColumn();
+        }
+        ImGui::Separator();
+
+        for (size_t i = 0; i < (size_t)GPUMemoryType::Count; i++)
+        {
+            const auto type = (GPUMemoryType)i;
+            const MemoryStats stats = MemoryTracker::GetGPUStats(type);
+            size_t budget = stats.Budget;
+            if (DrawRow(MemoryTracker::GetGPUTypeName(type), stats, budget)) MemoryTracker::SetGPUBudget(type, budget);
+        }
+        ImGui::Columns(1);
+    }
+    ImGui::End();
+}
+
+bool MemoryPanel::DrawRow(const char *name, const MemoryStats &stats, size_t &budget)
+{
+    ImGui::PushID(name);
+    ImGui::Text("%s", name);
+    ImGui::NextColumn();
+
+    // against the budget when there is one, red once it is exceeded
+    if (stats.Budget > 0)
+    {
+        const float fraction = (float)((double)stats.Current / stats.Budget);
+        const bool over = stats.Current > stats.Budget;
+        if (over) ImGui::PushStyleColor(ImGuiCol_PlotHistogram, ImVec4(0.85f, 0.2f, 0.2f, 1.0f));
+        char label[32];
+        snprintf(label, sizeof(label), "%.1f", stats.Current / Utils::MB);
+        ImGui::ProgressBar(std::min(fraction, 1.0f), ImVec2(-1.0f, 0.0f), label);
+        if (over) ImGui::PopStyleColor();
+    }
+    else
+        ImGui::Text("%.1f", stats.Current / Utils::MB);
+    ImGui::NextColumn();
+
+    ImGui::Text("%.1f", stats.Peak / Utils::MB);
+    ImGui::NextColumn();
+    ImGui::Text("%zu", stats.Allocations);
+    ImGui::NextColumn();
+
+    float budgetMB = (float)(budget / Utils::MB);
+    ImGui::SetNextItemWidth(-1.0f);
+    const bool changed =
+        ImGui::DragFloat("##Budget", &budgetMB, 1.0f, 0.0f, 65536.0f, budgetMB > 0.0f ? "%.0f" : "none");
+    if (changed) budget = (size_t)(std::max(budgetMB, 0.0f) * Utils::MB);
+    ImGui::NextColumn();
+
+    ImGui::PopID();
+    return changed;
+}
+} // namespace Engine
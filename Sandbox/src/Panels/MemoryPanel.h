@@ -0,0 +1,28 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace Engine
+{
+struct MemoryStats;
+
+class MemoryPanel
+{
+  public:
+    static constexpr size_t HistorySize = 240;
+
+    MemoryPanel() = default;
+    virtual ~MemoryPanel() = default;
+
+    void OnImGuiRender();
+
+  private:
+    // true when the budget was edited, budget then holds the new one in bytes
+    static bool DrawRow(const char *name, const MemoryStats &stats, size_t &budget);
+
+  private:
+    std::array<float, HistorySize> m_HeapHistory = {};
+    size_t m_HistoryOffset = 0;
+};
+} // namespace Engine
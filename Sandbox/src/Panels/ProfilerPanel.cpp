@@ -0,0 +1,175 @@
+#include "ProfilerPanel.h"
+
+#include <imgui.h>
+#include "ImGuiHelpers.h"
+#include "Profiler.h"
+#include "Project.h"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <string_view>
+
+namespace Engine
+{
+void ProfilerPanel::OnImGuiRender()
+{
+    const auto &frame = Profiler::GetLastFrame();
+
+    ImGui::Begin("Profiler");
+    ImGui::Text("Frame %llu: %.3f ms", (unsigned long long)frame.Index, frame.Duration / 1000.0);
+    ImGui::PlotLines("CPU Frame", Profiler::GetFrameTimeHistory().data(), Profiler::HistorySize,
+                     Profiler::GetHistoryOffset(), nullptr, 0.0f, 33.3f, ImVec2(0, 60));
+
+    bool paused = Profiler::IsPaused();
+    if (ImGui::Checkbox("Pause", &paused)) Profiler::SetPaused(paused);
+    ImGui::SameLine();
+    if (!Profiler::IsCapturing())
+    {
+        if (ImGui::Button("Record")) Profiler::BeginCapture();
+    }
+    else
+    {
+        if (ImGui::Button("Stop & Save"))
+        {
+            Profiler::EndCapture();
+            Profiler::WriteChromeTrace(GetTracePath());
+        }
+        ImGui::SameLine();
+        ImGui::Text("%zu frames", Profiler::GetCapturedFrameCount());
+    }
+
+    _collapsingHeaderStyle();
+    if (ImGui::CollapsingHeader("Counters"))
+    {
+        for (const auto &counter : frame.Counters)
+            ImGui::Text("%s: %.0f", counter.Name, counter.Value);
+    }
+
+    if (ImGui::CollapsingHeader("CPU"))
+    {
+        // one thread after the other, each in call order
+        std::vector<size_t> order(frame.Events.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+                         { return frame.Events[a].ThreadId < frame.Events[b].ThreadId; });
+
+        ImGui::Columns(3, "ProfilerCPU");
+        ImGui::Text("Scope");
+        ImGui::NextColumn();
+        ImGui::Text("Thread");
+        ImGui::NextColumn();
+        ImGui::Text("ms");
+        ImGui::NextColumn();
+        ImGui::Separator();
+        for (size_t index : order)
+        {
+            const auto &event = frame.Events[index];
+            ImGui::Text("%*s%s", (int)event.Depth * 2, "", event.Name);
+            ImGui::NextColumn();
+            ImGui::Text("%u", event.ThreadId);
+            ImGui::NextColumn();
+            ImGui::Text("%.3f", event.Duration / 1000.0);
+            ImGui::NextColumn();
+        }
+        ImGui::Columns(1);
+    }
+
+    if (ImGui::CollapsingHeader("GPU"))
+    {
+        for (const auto &event : frame.GPUEvents)
+            ImGui::Text("%s: %.3f ms", event.Name, event.Duration / 1000.0);
+    }
+
+    if (ImGui::CollapsingHeader("Schedule")) DrawSchedule(frame);
+    ImGui::End();
+}
+
+void ProfilerPanel::DrawSchedule(const ProfileFrame &frame)
+{
+    if (frame.Schedule.empty())
+    {
+        ImGui::Text("No systems ran");
+        return;
+    }
+
+    // one row per thread over the time systems ran this frame, hover a bar for what it waited on
+    std::vector<uint32_t> threads;
+    double begin = frame.Schedule.front().Start, end = begin;
+    for (const auto &entry : frame.Schedule)
+    {
+        if (std::find(threads.begin(), threads.end(), entry.ThreadId) == threads.end())
+            threads.push_back(entry.ThreadId);
+        end = std::max(end, entry.Start + entry.Duration);
+    }
+    std::sort(threads.begin(), threads.end());
+
+    const float labelWidth = 80.0f;
+    const float rowHeight = ImGui::GetTextLineHeightWithSpacing() + 4.0f;
+    const float width = std::max(ImGui::GetContentRegionAvail().x - labelWidth, 1.0f);
+    const double scale = width / std::max(end - begin, 1.0);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    auto *drawList = ImGui::GetWindowDrawList();
+
+    for (size_t row = 0; row < threads.size(); row++)
+    {
+        const std::string name = Profiler::GetThreadName(threads[row]);
+        drawList->AddText(ImVec2(origin.x, origin.y + row * rowHeight + 2.0f), ImGui::GetColorU32(ImGuiCol_Text),
+                          name.c_str());
+    }
+
+    for (const auto &entry : frame.Schedule)
+    {
+        const size_t row = std::find(threads.begin(), threads.end(), entry.ThreadId) - threads.begin();
+        const ImVec2 min(origin.x + labelWidth + (float)((entry.Start - begin) * scale), origin.y + row * rowHeight);
+        const ImVec2 max(std::max(min.x + (float)(entry.Duration * scale), min.x + 2.0f), min.y + rowHeight - 2.0f);
+        const bool fixed = std::string_view(entry.Phase) == "FixedUpdate";
+
+        drawList->AddRectFilled(min, max, fixed ? IM_COL32(200, 120, 60, 255) : IM_COL32(70, 130, 200, 255));
+        drawList->PushClipRect(min, max, true);
+        drawList->AddText(ImVec2(min.x + 2.0f, min.y + 2.0f), IM_COL32_WHITE, entry.Name);
+        drawList->PopClipRect();
+
+        if (ImGui::IsMouseHoveringRect(min, max))
+        {
+            std::string dependsOn;
+            for (const char *dependency : entry.DependsOn)
+                dependsOn += std::string(dependsOn.empty() ? "" : ", ") + dependency;
+
+            ImGui::SetTooltip("%s (%s)\n%.3f ms\nafter: %s", entry.Name, entry.Phase, entry.Duration / 1000.0,
+                              dependsOn.empty() ? "-" : dependsOn.c_str());
+        }
+    }
+    ImGui::Dummy(ImVec2(labelWidth + width, threads.size() * rowHeight));
+
+    ImGui::Columns(4, "ProfilerSchedule");
+    ImGui::Text("System");
+    ImGui::NextColumn();
+    ImGui::Text("Phase");
+    ImGui::NextColumn();
+    ImGui::Text("Thread");
+    ImGui::NextColumn();
+    ImGui::Text("ms");
+    ImGui::NextColumn();
+    ImGui::Separator();
+    for (const auto &entry : frame.Schedule)
+    {
+        ImGui::Text("%s", entry.Name);
+        ImGui::NextColumn();
+        ImGui::Text("%s", entry.Phase);
+        ImGui::NextColumn();
+        ImGui::Text("%s", Profiler::GetThreadName(entry.ThreadId).c_str());
+        ImGui::NextColumn();
+        ImGui::Text("%.3f", entry.Duration / 1000.0);
+        ImGui::NextColumn();
+    }
+    ImGui::Columns(1);
+}
+
+std::filesystem::path ProfilerPanel::GetTracePath() const
+{
+    const std::string fileName = "trace_" + std::to_string(Profiler::GetLastFrame().Index) + ".json";
+    if (Project::GetActive()) return Project::GetCacheDirectory() / "Profiler" / fileName;
+    return fileName;
+}
+} // namespace Engine
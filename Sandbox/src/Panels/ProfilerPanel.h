@@ -0,0 +1,21 @@
+#pragma once
+
+#include <filesystem>
+
+namespace Engine
+{
+struct ProfileFrame;
+
+class ProfilerPanel
+{
+  public:
+    ProfilerPanel() = default;
+    virtual ~ProfilerPanel() = default;
+
+    void OnImGuiRender();
+
+  private:
+    void DrawSchedule(const ProfileFrame &frame);
+    std::filesystem::path GetTracePath() const;
+};
+} // namespace Engine
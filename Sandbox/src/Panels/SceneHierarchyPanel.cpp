@@ -150,6 +150,7 @@ void SceneHierarchyPanel::DrawEntityNode(Entity entity)
                 auto p = m_Context->GetEntityByUUID(parentComponent.Parent);
                 p.GetComponent<ParentComponent>().RemoveChild(entity.GetComponent<IDComponent>().ID);
 				parentComponent.HasParent = false;
+				m_Context->InvalidateHierarchy();
             }
 		}
         if (ImGui::MenuItem("Delete Entity"))
@@ -232,13 +233,20 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
 					transform.Translation = glm::vec3(0.0f);
 					transform.Rotation = glm::vec3(0.0f);
 					transform.Scale = glm::vec3(1.0f);
+					transform.MarkDirty();
+					entity.PatchComponent<TransformComponent>();
 				}
 				ImGui::EndPopup();
 			}
 
-            _drawVec3Control("Position", transform.Translation, 0.0f);
-            _drawVec3Control("Rotation", transform.Rotation, 0.0f);
-            _drawVec3Control("Scale", transform.Scale, 1.0f);
+            bool changed = _drawVec3Control("Position", transform.Translation, 0.0f);
+            changed |= _drawVec3Control("Rotation", transform.Rotation, 0.0f);
+            changed |= _drawVec3Control("Scale", transform.Scale, 1.0f);
+            if (changed)
+            {
+                transform.MarkDirty();
+                entity.PatchComponent<TransformComponent>();
+            }
         }
     };
 
@@ -371,7 +379,8 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
             if (ImGui::CollapsingHeader("Visibility"))
             {
                 auto &entityComponent = entity.GetComponent<VisibilityComponent>();
-                ImGui::Checkbox(_labelPrefix("Visibility"), &entityComponent.IsVisible);
+                if (ImGui::Checkbox(_labelPrefix("Visibility"), &entityComponent.IsVisible))
+                    entity.PatchComponent<VisibilityComponent>();
             }
         }
     }
@@ -587,9 +596,13 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
             auto &entityComponent = entity.GetComponent<DirectionalLightComponent>();
             auto &transform = entity.GetComponent<TransformComponent>();
             entityComponent.Light.Direction = transform.Rotation;
-            ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
-            ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
-            ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f, 10000.0f);
+            bool changed = ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
+            changed |= ImGui::Checkbox(_labelPrefix("Follow Sky"), &entityComponent.Light.FollowSky);
+            if (!entityComponent.Light.FollowSky)
+                changed |= ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
+            changed |= ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f,
+                                        10000.0f);
+            if (changed) entity.PatchComponent<DirectionalLightComponent>();
         }
         if (removeComponent) entity.RemoveComponent<DirectionalLightComponent>();
     }
@@ -604,9 +617,11 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
             auto &entityComponent = entity.GetComponent<PointLightComponent>();
             auto &transform = entity.GetComponent<TransformComponent>();
             entityComponent.Light.Position = transform.Translation;
-            ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
-            ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
-            ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f, 10000.0f);
+            bool changed = ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
+            changed |= ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
+            changed |= ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f,
+                                        10000.0f);
+            if (changed) entity.PatchComponent<PointLightComponent>();
         }
         if (removeComponent) entity.RemoveComponent<PointLightComponent>();
     }
@@ -622,12 +637,14 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
             auto &transform = entity.GetComponent<TransformComponent>();
             entityComponent.Light.Position = transform.Translation;
             entityComponent.Light.Direction = transform.Rotation;
-            ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
-            ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
-            ImGui::DragFloat(_labelPrefix("Cutoff"), &entityComponent.Light.Cutoff, 0.1f, 0.0f, 90.0f);
-            ImGui::DragFloat(_labelPrefix("Outer Cutoff"), &entityComponent.Light.OuterCutoff, 0.1f, 0.0f,
-                             90.0f);
-            ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f, 10000.0f);
+            bool changed = ImGui::Checkbox(_labelPrefix("Enabled"), &entityComponent.Enabled);
+            changed |= ImGui::ColorEdit3(_labelPrefix("Color"), glm::value_ptr(entityComponent.Light.Color));
+            changed |= ImGui::DragFloat(_labelPrefix("Cutoff"), &entityComponent.Light.Cutoff, 0.1f, 0.0f, 90.0f);
+            changed |= ImGui::DragFloat(_labelPrefix("Outer Cutoff"), &entityComponent.Light.OuterCutoff, 0.1f,
+                                        0.0f, 90.0f);
+            changed |= ImGui::DragFloat(_labelPrefix("Intensity"), &entityComponent.Light.Intensity, 0.1f, 0.0f,
+                                        10000.0f);
+            if (changed) entity.PatchComponent<SpotLightComponent>();
         }
         if (removeComponent) entity.RemoveComponent<SpotLightComponent>();
     }
@@ -653,6 +670,7 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
                     if (ImGui::Selectable(Physics::MotionTypeToString((Physics::MotionType)i).c_str(), isSelected))
                     {
                         entityComponent.MotionType = (Physics::MotionType)i;
+                        entity.PatchComponent<RigidBodyComponent>();
                     }
                     if (isSelected) ImGui::SetItemDefaultFocus();
                 }
@@ -660,13 +678,14 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
             }
             if (entityComponent.MotionType == Physics::MotionType::Dynamic)
             {
-                ImGui::DragFloat(_labelPrefix("Mass"), &entityComponent.Mass, 0.1f, 0.0f, 10000.0f);
-                ImGui::DragFloat(_labelPrefix("Linear Damping"), &entityComponent.LinearDamping, 0.01f, 0.0f,
-                                 1.0f);
-                ImGui::DragFloat(_labelPrefix("Angular Damping"), &entityComponent.AngularDamping, 0.01f, 0.0f,
-                                 1.0f);
-                ImGui::Checkbox(_labelPrefix("Use Gravity"), &entityComponent.UseGravity);
-                ImGui::Checkbox(_labelPrefix("Is Kinematic"), &entityComponent.IsKinematic);
+                bool changed = ImGui::DragFloat(_labelPrefix("Mass"), &entityComponent.Mass, 0.1f, 0.0f, 10000.0f);
+                changed |= ImGui::DragFloat(_labelPrefix("Linear Damping"), &entityComponent.LinearDamping, 0.01f,
+                                            0.0f, 1.0f);
+                changed |= ImGui::DragFloat(_labelPrefix("Angular Damping"), &entityComponent.AngularDamping, 0.01f,
+                                            0.0f, 1.0f);
+                changed |= ImGui::Checkbox(_labelPrefix("Use Gravity"), &entityComponent.UseGravity);
+                changed |= ImGui::Checkbox(_labelPrefix("Is Kinematic"), &entityComponent.IsKinematic);
+                if (changed) entity.PatchComponent<RigidBodyComponent>();
                 // constraints tree node
                 if (ImGui::TreeNodeEx((void *)typeid(RigidBodyComponent).hash_code(), ImGuiTreeNodeFlags_DefaultOpen,
                                       "Constraints"))
@@ -686,8 +705,9 @@ void SceneHierarchyPanel::DrawComponents(Entity entity)
         {
             REMOVABLE_COMPONENT
             auto &entityComponent = entity.GetComponent<BoxColliderComponent>();
-            _drawVec3Control("Size", entityComponent.Size, 0.0f);
-            ImGui::Checkbox(_labelPrefix("Is Trigger"), &entityComponent.IsTrigger);
+            bool changed = _drawVec3Control("Size", entityComponent.Size, 0.0f);
+            changed |= ImGui::Checkbox(_labelPrefix("Is Trigger"), &entityComponent.IsTrigger);
+            if (changed) entity.PatchComponent<BoxColliderComponent>();
         }
         if (removeComponent) entity.RemoveComponent<BoxColliderComponent>();
     }
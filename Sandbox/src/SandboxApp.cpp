@@ -2,11 +2,24 @@
 
 #include "Application.h"/
 #include "AppLayer.h"
+#include "Log.h"
 
 class Sandbox : public Engine::Application
 {
   public:
-    Sandbox() { PushLayer(new Engine::AppLayer()); }
+    Sandbox()
+    {
+        // the editor still touches GL outside RenderThread::Submit (asset loads, viewport resizes, thumbnails) and
+        // its panels edit the sky and bloom the render snapshot points to, so it always renders on the main thread
+        if (GetSettings().PipelinedRendering)
+        {
+            LOG_WARN("--pipelined is not supported by the editor, rendering on the main thread");
+            Engine::ApplicationSettings settings = GetSettings();
+            settings.PipelinedRendering = false;
+            SetSettings(settings);
+        }
+        PushLayer(new Engine::AppLayer());
+    }
 
     ~Sandbox() = default;
 };
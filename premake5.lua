@@ -41,4 +41,5 @@ group ""
 
 group "Misc"
 	include "Sandbox"
+	include "Benchmark"
 group ""
\ No newline at end of file